@@ -26,6 +26,10 @@ BUILD_TOOL_FIND_ITFS32=1
 BUILD_TOOL_FIND_ITFS64=1
 BUILD_TOOL_LOBBY32=1
 BUILD_TOOL_LOBBY64=1
+BUILD_TOOL_BENCH32=1
+BUILD_TOOL_BENCH64=1
+BUILD_TOOL_LOAD32=1
+BUILD_TOOL_LOAD64=1
 
 # < 0: deduce, > 1: force
 PARALLEL_THREADS_OVERRIDE=-1
@@ -65,6 +69,14 @@ for (( i=1; i<=$#; i++ )); do
     BUILD_TOOL_LOBBY32=0
   elif [[ "$var" = "-tool-lobby-64" ]]; then
     BUILD_TOOL_LOBBY64=0
+  elif [[ "$var" = "-tool-bench-32" ]]; then
+    BUILD_TOOL_BENCH32=0
+  elif [[ "$var" = "-tool-bench-64" ]]; then
+    BUILD_TOOL_BENCH64=0
+  elif [[ "$var" = "-tool-load-32" ]]; then
+    BUILD_TOOL_LOAD32=0
+  elif [[ "$var" = "-tool-load-64" ]]; then
+    BUILD_TOOL_LOAD64=0
   elif [[ "$var" = "-verbose" ]]; then
     VERBOSE=1
   elif [[ "$var" = "clean" ]]; then
@@ -440,6 +452,31 @@ if [[ "$BUILD_TOOL_LOBBY32" = "1" ]]; then
   last_code=$((last_code + $?))
 fi
 
+if [[ "$BUILD_TOOL_BENCH32" = "1" ]]; then
+  echo // building executable benchmark_x32 - 32
+  [[ -d "$build_root_tools/benchmark" ]] || mkdir -p "$build_root_tools/benchmark"
+
+  all_src_files=(
+    "${release_src[@]}"
+    "controller/*.c"
+    "$tools_dir/benchmark/benchmark.cpp"
+  )
+  build_for 1 1 "$build_root_tools/benchmark/benchmark_x32" '-DCONTROLLER_SUPPORT' all_src_files 
+  last_code=$((last_code + $?))
+fi
+
+if [[ "$BUILD_TOOL_LOAD32" = "1" ]]; then
+  echo // building executable load_generator_x32 - 32
+  [[ -d "$build_root_tools/load_generator" ]] || mkdir -p "$build_root_tools/load_generator"
+
+  all_src_files=(
+    "${release_src[@]}"
+    "$tools_dir/load_generator/load_generator.cpp"
+  )
+  build_for 1 1 "$build_root_tools/load_generator/load_generator_x32" '-DNO_DISK_WRITES' all_src_files 
+  last_code=$((last_code + $?))
+fi
+
 if [[ "$BUILD_TOOL_FIND_ITFS32" = "1" ]]; then
   echo // building executable generate_interfaces_file_x32 - 32
   [[ -d "$build_root_tools/find_interfaces" ]] || mkdir -p "$build_root_tools/find_interfaces"
@@ -498,6 +535,31 @@ if [[ "$BUILD_TOOL_LOBBY64" = "1" ]]; then
   last_code=$((last_code + $?))
 fi
 
+if [[ "$BUILD_TOOL_BENCH64" = "1" ]]; then
+  echo // building executable benchmark_x64 - 64
+  [[ -d "$build_root_tools/benchmark" ]] || mkdir -p "$build_root_tools/benchmark"
+
+  all_src_files=(
+    "${release_src[@]}"
+    "controller/*.c"
+    "$tools_dir/benchmark/benchmark.cpp"
+  )
+  build_for 0 1 "$build_root_tools/benchmark/benchmark_x64" '-DCONTROLLER_SUPPORT' all_src_files 
+  last_code=$((last_code + $?))
+fi
+
+if [[ "$BUILD_TOOL_LOAD64" = "1" ]]; then
+  echo // building executable load_generator_x64 - 64
+  [[ -d "$build_root_tools/load_generator" ]] || mkdir -p "$build_root_tools/load_generator"
+
+  all_src_files=(
+    "${release_src[@]}"
+    "$tools_dir/load_generator/load_generator.cpp"
+  )
+  build_for 0 1 "$build_root_tools/load_generator/load_generator_x64" '-DNO_DISK_WRITES' all_src_files 
+  last_code=$((last_code + $?))
+fi
+
 if [[ "$BUILD_TOOL_FIND_ITFS64" = "1" ]]; then
   echo // building executable generate_interfaces_file_x64 - 64
   [[ -d "$build_root_tools/find_interfaces" ]] || mkdir -p "$build_root_tools/find_interfaces"
@@ -529,6 +591,12 @@ if [[ $last_code = 0 ]]; then
   if [[ -d "$build_root_tools/lobby_connect" ]]; then
     cp -f "post_build/README.lobby_connect.md" "$build_root_tools/lobby_connect/"
   fi
+  if [[ -d "$build_root_tools/benchmark" ]]; then
+    cp -f "post_build/README.benchmark.md" "$build_root_tools/benchmark/"
+  fi
+  if [[ -d "$build_root_tools/load_generator" ]]; then
+    cp -f "post_build/README.load_generator.md" "$build_root_tools/load_generator/"
+  fi
 else
   echo "[X] Not copying readmes or files examples due to previous errors" >&2
 fi
@@ -35,6 +35,8 @@ set /a BUILD_EXPCLIENT_EXTRA_64=0
 
 set /a BUILD_TOOL_FIND_ITFS=1
 set /a BUILD_TOOL_LOBBY=1
+set /a BUILD_TOOL_BENCH=1
+set /a BUILD_TOOL_LOAD=1
 
 :: < 0: deduce, > 1: force
 set /a PARALLEL_THREADS_OVERRIDE=-1
@@ -78,6 +80,10 @@ set /a VERBOSE=0
     set /a BUILD_TOOL_FIND_ITFS=0
   ) else if "%~1"=="-tool-lobby" (
     set /a BUILD_TOOL_LOBBY=0
+  ) else if "%~1"=="-tool-bench" (
+    set /a BUILD_TOOL_BENCH=0
+  ) else if "%~1"=="-tool-load" (
+    set /a BUILD_TOOL_LOAD=0
   ) else if "%~1"=="-j" (
     call :get_parallel_threads_count %~2 || (
       call :err_msg "Invalid arg after -j, expected a number"
@@ -150,6 +156,8 @@ set "experimental_dir=%build_root_dir%\experimental"
 set "tools_dir=%build_root_dir%\tools"
 set "find_interfaces_dir=%tools_dir%\find_interfaces"
 set "lobby_connect_dir=%tools_dir%\lobby_connect"
+set "benchmark_dir=%tools_dir%\benchmark"
+set "load_generator_dir=%tools_dir%\load_generator"
 
 :: common stuff
 set "deps_dir=build\deps\win"
@@ -370,6 +378,18 @@ if %BUILD_TOOL_LOBBY% equ 1 (
   )
   echo: & echo:
 )
+if %BUILD_TOOL_BENCH% equ 1 (
+  call :compile_tool_benchmark || (
+    set /a last_code+=1
+  )
+  echo: & echo:
+)
+if %BUILD_TOOL_LOAD% equ 1 (
+  call :compile_tool_load_generator || (
+    set /a last_code+=1
+  )
+  echo: & echo:
+)
 
 endlocal & set /a last_code=%last_code%
 
@@ -498,6 +518,12 @@ if %last_code% equ 0 (
   if exist "%lobby_connect_dir%" (
     copy /y "post_build\README.lobby_connect.md" "%lobby_connect_dir%\"
   )
+  if exist "%benchmark_dir%" (
+    copy /y "post_build\README.benchmark.md" "%benchmark_dir%\"
+  )
+  if exist "%load_generator_dir%" (
+    copy /y "post_build\README.load_generator.md" "%load_generator_dir%\"
+  )
 ) else (
   call :err_msg "Not copying readmes or files examples due to previous errors"
 )
@@ -609,6 +635,30 @@ endlocal & exit /b %_exit%
   )
 endlocal & exit /b %_exit%
 
+:compile_tool_benchmark
+  setlocal
+  echo // building tool benchmark.exe - 32
+  set src_files="%win_resources_out_dir%\rsrc-launcher-32.res" "%tools_src_dir%\benchmark\benchmark.cpp" %release_src%
+  call :build_for 1 1 "%benchmark_dir%\benchmark.exe" src_files
+  set /a _exit=%errorlevel%
+  if %_exit% equ 0 (
+    call :change_dos_stub 1 "%benchmark_dir%\benchmark.exe"
+    call "%signer_tool%" "%benchmark_dir%\benchmark.exe"
+  )
+endlocal & exit /b %_exit%
+
+:compile_tool_load_generator
+  setlocal
+  echo // building tool load_generator.exe - 32
+  set src_files="%win_resources_out_dir%\rsrc-launcher-32.res" "%tools_src_dir%\load_generator\load_generator.cpp" %release_src%
+  call :build_for 1 1 "%load_generator_dir%\load_generator.exe" src_files "" "/DNO_DISK_WRITES"
+  set /a _exit=%errorlevel%
+  if %_exit% equ 0 (
+    call :change_dos_stub 1 "%load_generator_dir%\load_generator.exe"
+    call "%signer_tool%" "%load_generator_dir%\load_generator.exe"
+  )
+endlocal & exit /b %_exit%
+
 
 
 :::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::: x64
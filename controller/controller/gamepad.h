@@ -135,10 +135,26 @@ GAMEPAD_API void GamepadInit(void);
  */
 GAMEPAD_API void GamepadShutdown(void);
 
+#if defined(__linux__)
+/**
+ * Replay recorded input as an extra gamepad, for testing without hardware.
+ *
+ * The file is the output of evtest for a gamepad, the axis ranges are read from its
+ * header. The recording loops until shutdown. Must be called before GamepadInit,
+ * NULL disables it. Only available on linux, the recording has linux input event codes.
+ *
+ * \param path The recording to replay.
+ */
+GAMEPAD_API void GamepadSetReplayFile(const char *path);
+#endif
+
 /**
  * Updates the state of the gamepads.
  *
  * This must be called (at least) once per game loop.
+ *
+ * On linux the devices are read by a background thread, this only copies its
+ * latest snapshot and never blocks.
  */
 GAMEPAD_API void GamepadUpdate(void);
 
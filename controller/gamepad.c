@@ -27,6 +27,12 @@
 #	include <unistd.h>
 #	include <dirent.h>
 #	include <sys/stat.h>
+#	include <sys/epoll.h>
+#	include <sys/inotify.h>
+#	include <sys/ioctl.h>
+#	include <pthread.h>
+#	include <limits.h>
+#	include <stdlib.h>
 #	include <time.h>
 #else
 #	error "Unknown platform in gamepad.c"
@@ -52,6 +58,18 @@ struct GAMEPAD_TRIGINFO {
 	GAMEPAD_BOOL pressedLast, pressedCurrent;
 };
 
+#if defined(__linux__)
+/* Unprocessed input of a gamepad */
+typedef struct GAMEPAD_RAW GAMEPAD_RAW;
+struct GAMEPAD_RAW {
+	int flags;
+	int buttons;
+	int trigger[TRIGGER_COUNT];
+	int stick_x[STICK_COUNT];
+	int stick_y[STICK_COUNT];
+};
+#endif
+
 /* Structure for state of a particular gamepad */
 typedef struct GAMEPAD_STATE GAMEPAD_STATE;
 struct GAMEPAD_STATE {
@@ -59,11 +77,13 @@ struct GAMEPAD_STATE {
 	GAMEPAD_TRIGINFO trigger[TRIGGER_COUNT];
 	int bLast, bCurrent, flags;
 #if defined(__linux__)
+	/* everything below belongs to the input thread */
 	char* device;
 	int fd;
 	int effect;
 	double axis_min[ABS_MAX];
 	double axis_max[ABS_MAX];
+	GAMEPAD_RAW raw;
 #endif
 };
 
@@ -146,13 +166,69 @@ void GamepadSetRumble(GAMEPAD_DEVICE gamepad, float left, float right, unsigned
 	(((1UL << ((nr) % (sizeof(long) * 8))) & ((addr)[(nr) / (sizeof(long) * 8)])) != 0)
 #define NBITS(x) ((((x)-1)/(sizeof(long) * 8))+1)
 
+/* epoll tags of the file descriptors that aren't gamepads, gamepads use their index */
+#define EPOLL_TAG_HOTPLUG	(GAMEPAD_COUNT)
+#define EPOLL_TAG_WAKE		(GAMEPAD_COUNT + 1)
+
+/* Hotplug is polled this often when inotify isn't available */
+#define DETECT_INTERVAL_MS	2000
+
+/* One event of a replay file */
+typedef struct GAMEPAD_REPLAY_EVENT GAMEPAD_REPLAY_EVENT;
+struct GAMEPAD_REPLAY_EVENT {
+	double time;
+	int type, code, value;
+};
+
+/* Latest input of every gamepad, written by the input thread and read without locking by GamepadUpdate */
+static GAMEPAD_RAW SNAPSHOT[GAMEPAD_COUNT];
+static unsigned int SNAPSHOT_SEQ[GAMEPAD_COUNT];
+
+/* Device fds are opened and closed by the input thread, rumble is sent from other threads */
+static pthread_mutex_t DEVICE_LOCK = PTHREAD_MUTEX_INITIALIZER;
+
+static pthread_t INPUT_THREAD;
+static int INPUT_THREAD_RUNNING = 0;
+static int EPOLL_FD = -1;
+static int HOTPLUG_FD = -1;
+static int WAKE_PIPE[2] = { -1, -1 };
+
+static char *REPLAY_PATH = NULL;
+static GAMEPAD_REPLAY_EVENT *REPLAY_EVENTS = NULL;
+static size_t REPLAY_COUNT = 0;
+static size_t REPLAY_NEXT = 0;
+static double REPLAY_START = 0.0;
+static int REPLAY_PAD = -1;
+
+static double GamepadNow(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1000000000.0;
+}
+
+/* seqlock writer, only called from the thread that owns the raw state */
+static void GamepadPublish(int gamepad) {
+	unsigned int seq = __atomic_load_n(&SNAPSHOT_SEQ[gamepad], __ATOMIC_RELAXED);
+	__atomic_store_n(&SNAPSHOT_SEQ[gamepad], seq + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	SNAPSHOT[gamepad] = STATE[gamepad].raw;
+	__atomic_store_n(&SNAPSHOT_SEQ[gamepad], seq + 2, __ATOMIC_RELEASE);
+}
+
+static void GamepadReadSnapshot(int gamepad, GAMEPAD_RAW *out) {
+	unsigned int before, after;
+	do {
+		before = __atomic_load_n(&SNAPSHOT_SEQ[gamepad], __ATOMIC_ACQUIRE);
+		*out = SNAPSHOT[gamepad];
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		after = __atomic_load_n(&SNAPSHOT_SEQ[gamepad], __ATOMIC_RELAXED);
+	} while ((before & 1) || before != after);
+}
 
 static int IsGamepad(int fd, char *namebuf, const size_t namebuflen)
 {
 	struct input_id inpid;
-	//uint16_t *guid16 = (uint16_t *)guid->data;
 
-	/* When udev is enabled we only get joystick devices here, so there's no need to test them */
 	unsigned long evbit[NBITS(EV_MAX)] = { 0 };
 	unsigned long keybit[NBITS(KEY_MAX)] = { 0 };
 	unsigned long absbit[NBITS(ABS_MAX)] = { 0 };
@@ -177,35 +253,149 @@ static int IsGamepad(int fd, char *namebuf, const size_t namebuflen)
 	}
 
 	//printf("Joystick: %s, bustype = %d, vendor = 0x%.4x, product = 0x%.4x, version = %d\n", namebuf, inpid.bustype, inpid.vendor, inpid.product, inpid.version);
+	return 1;
+}
 
-	//memset(guid->data, 0, sizeof(guid->data));
-
-	/* We only need 16 bits for each of these; space them out to fill 128. */
-	/* Byteswap so devices get same GUID on little/big endian platforms. */
-/*
-	*guid16++ = SDL_SwapLE16(inpid.bustype);
-	*guid16++ = 0;
-
-	if (inpid.vendor && inpid.product) {
-		*guid16++ = SDL_SwapLE16(inpid.vendor);
-		*guid16++ = 0;
-		*guid16++ = SDL_SwapLE16(inpid.product);
-		*guid16++ = 0;
-		*guid16++ = SDL_SwapLE16(inpid.version);
-		*guid16++ = 0;
-	} else {
-		strlcpy((char*)guid16, namebuf, sizeof(guid->data) - 4);
+/* Helper to reset the raw input, the axis ranges default to the xinput ones */
+static void GamepadResetRaw(int gamepad) {
+	int flags = STATE[gamepad].raw.flags;
+	int i;
+
+	memset(&STATE[gamepad].raw, 0, sizeof(STATE[gamepad].raw));
+	STATE[gamepad].raw.flags = flags;
+
+	for (i = 0; i < ABS_MAX; ++i) {
+		STATE[gamepad].axis_min[i] = -32768;
+		STATE[gamepad].axis_max[i] = 32767;
 	}
 
-	if (SDL_ShouldIgnoreJoystick(namebuf, *guid)) {
-		return 0;
+	STATE[gamepad].axis_min[ABS_Z] = STATE[gamepad].axis_min[ABS_RZ] = 0;
+	STATE[gamepad].axis_max[ABS_Z] = STATE[gamepad].axis_max[ABS_RZ] = 255;
+}
+
+/* Helper to find a free gamepad, -1 if the device is already added or there's no room */
+static int GamepadFindSlot(const char* devPath) {
+	int i, slot = -1;
+
+	for (i = 0; i != GAMEPAD_COUNT; ++i) {
+		if (STATE[i].device && strcmp(devPath, STATE[i].device) == 0) {
+			return -1;
+		}
+
+		if (slot == -1 && (STATE[i].raw.flags & FLAG_CONNECTED) == 0) {
+			slot = i;
+		}
 	}
-*/
-	return 1;
+
+	return slot;
+}
+
+/* Helper to add a new device */
+static void GamepadAddDevice(const char* devPath) {
+	int i = GamepadFindSlot(devPath);
+	if (i == -1) {
+		return;
+	}
+
+	int fd = open(devPath, O_RDWR | O_NONBLOCK | O_CLOEXEC, 0);
+	if (fd < 0) return;
+	char namebuf[128];
+	int is_gamepad = IsGamepad(fd, namebuf, sizeof (namebuf));
+	if (!is_gamepad) {
+		close(fd);
+		return;
+	}
+
+	pthread_mutex_lock(&DEVICE_LOCK);
+
+	/* copy the device path */
+	STATE[i].device = strdup(devPath);
+	if (STATE[i].device == NULL) {
+		pthread_mutex_unlock(&DEVICE_LOCK);
+		close(fd);
+		return;
+	}
+
+	/* reset device state */
+	GamepadResetRaw(i);
+
+	STATE[i].fd = fd;
+	STATE[i].effect = -1;
+	STATE[i].raw.flags = FLAG_CONNECTED;
+
+	{
+	int a;
+	unsigned long absbit[NBITS(ABS_MAX)] = { 0 };
+	unsigned long ffbit[NBITS(FF_MAX)] = { 0 };
+
+	if (ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(absbit)), absbit) >= 0) {
+		for (a = 0; a < ABS_MAX; ++a) {
+			/* Skip hats */
+			if (a == ABS_HAT0X) {
+				a = ABS_HAT3Y;
+				continue;
+			}
+			if (test_bit(a, absbit)) {
+				struct input_absinfo absinfo;
+
+				if (ioctl(fd, EVIOCGABS(a), &absinfo) < 0) {
+					continue;
+				}
+
+				STATE[i].axis_min[a] = absinfo.minimum;
+				STATE[i].axis_max[a] = absinfo.maximum;
+			}
+		}
+	}
+
+	if (ioctl(fd, EVIOCGBIT(EV_FF, sizeof(ffbit)), ffbit) >= 0) {
+		if (test_bit(FF_RUMBLE, ffbit)) {
+			STATE[i].raw.flags |= FLAG_RUMBLE;
+		}
+	}
+	}
+
+	if (EPOLL_FD != -1) {
+		struct epoll_event ev;
+		memset(&ev, 0, sizeof(ev));
+		ev.events = EPOLLIN;
+		ev.data.u32 = i;
+		epoll_ctl(EPOLL_FD, EPOLL_CTL_ADD, fd, &ev);
+	}
+
+	pthread_mutex_unlock(&DEVICE_LOCK);
+	GamepadPublish(i);
 }
 
-static void GamepadAddDevice(const char* devPath);
-static void GamepadRemoveDevice(const char* devPath);
+/* Helper to remove a device */
+static void GamepadRemoveIndex(int i) {
+	pthread_mutex_lock(&DEVICE_LOCK);
+	if (STATE[i].fd != -1) {
+		if (EPOLL_FD != -1) {
+			epoll_ctl(EPOLL_FD, EPOLL_CTL_DEL, STATE[i].fd, NULL);
+		}
+
+		close(STATE[i].fd);
+		STATE[i].fd = -1;
+	}
+	free(STATE[i].device);
+	STATE[i].device = 0;
+	STATE[i].effect = -1;
+	memset(&STATE[i].raw, 0, sizeof(STATE[i].raw));
+	pthread_mutex_unlock(&DEVICE_LOCK);
+
+	GamepadPublish(i);
+}
+
+static void GamepadRemoveDevice(const char* devPath) {
+	int i;
+	for (i = 0; i != GAMEPAD_COUNT; ++i) {
+		if (STATE[i].device != NULL && i != REPLAY_PAD && strcmp(STATE[i].device, devPath) == 0) {
+			GamepadRemoveIndex(i);
+			break;
+		}
+	}
+}
 
 static void GamepadDetect()
 {
@@ -227,331 +417,452 @@ static void GamepadDetect()
 	}
 
 	for (int i = 0; i != GAMEPAD_COUNT; ++i) {
-		if ((STATE[i].flags & FLAG_CONNECTED) && STATE[i].device) {
+		if ((STATE[i].raw.flags & FLAG_CONNECTED) && STATE[i].device && i != REPLAY_PAD) {
 			struct stat sb;
-			//printf("%s\n", STATE[i].device);
 			if (stat(STATE[i].device, &sb) == -1) {
-				GamepadRemoveDevice(STATE[i].device);
+				GamepadRemoveIndex(i);
 			}
 		}
 	}
 }
 
+/* Handles the inotify events of /dev/input */
+static void GamepadHotplug(void) {
+	char buffer[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+	ssize_t len;
 
+	while ((len = read(HOTPLUG_FD, buffer, sizeof(buffer))) > 0) {
+		char *ptr;
+		for (ptr = buffer; ptr < buffer + len; ptr += sizeof(struct inotify_event) + ((struct inotify_event *)ptr)->len) {
+			const struct inotify_event *event = (const struct inotify_event *)ptr;
+			char path[PATH_MAX];
 
-/* Helper to add a new device */
-static void GamepadAddDevice(const char* devPath) {
-	int i;
+			if (!event->len || strncmp(event->name, "event", 5) != 0) {
+				continue;
+			}
 
-	/* try to find a free controller */
-	for (i = 0; i != GAMEPAD_COUNT; ++i) {
-		if ((STATE[i].flags & FLAG_CONNECTED) == 0) {
+			snprintf(path, sizeof(path), "/dev/input/%s", event->name);
+			if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+				GamepadRemoveDevice(path);
+			} else {
+				/* the node is usually created before udev gives us access to it, IN_ATTRIB retries then */
+				GamepadAddDevice(path);
+			}
+		}
+	}
+}
+
+static int adjust_values_trigger(double min, double max, double value)
+{
+	return (((value + (0 - min)) / (max - min)) * 255.0);
+}
+
+static int adjust_values_stick(double min, double max, double value)
+{
+	return (((value + (0 - min)) / (max - min)) * (65535.0)) - 32768.0;
+}
+
+/* Applies one evdev event to the raw input of a gamepad */
+static void GamepadApplyEvent(int gamepad, int type, int code, int value) {
+	GAMEPAD_RAW *raw = &STATE[gamepad].raw;
+	int button = 0;
+
+	switch (type) {
+	case EV_KEY:
+		//printf("EV_KEY %i\n", code);
+		switch (code) {
+		case BTN_SOUTH: button = BUTTON_A; break;
+		case BTN_EAST: button = BUTTON_B; break;
+		case BTN_NORTH: button = BUTTON_X; break;
+		case BTN_WEST: button = BUTTON_Y; break;
+		case BTN_TL: button = BUTTON_LEFT_SHOULDER; break;
+		case BTN_TR: button = BUTTON_RIGHT_SHOULDER; break;
+		case BTN_SELECT: button = BUTTON_BACK; break;
+		case BTN_START: button = BUTTON_START; break;
+		case BTN_MODE: button = 0; break; /* XBOX button  */
+		case BTN_THUMBL: button = BUTTON_LEFT_THUMB; break;
+		case BTN_THUMBR: button = BUTTON_RIGHT_THUMB; break;
+		default: button = 0; break;
+		}
+		if (value) {
+			raw->buttons |= BUTTON_TO_FLAG(button);
+		} else {
+			raw->buttons &= ~BUTTON_TO_FLAG(button);
+		}
+		break;
+	case EV_ABS:
+		if (code < 0 || code >= ABS_MAX) {
 			break;
 		}
 
-		if (STATE[i].device && strcmp(devPath, STATE[i].device) == 0) {
-			return;
+		switch (code) {
+		case ABS_HAT0X:
+			if (value < 0) {
+				raw->buttons |= BUTTON_TO_FLAG(BUTTON_DPAD_LEFT);
+				raw->buttons &= ~BUTTON_TO_FLAG(BUTTON_DPAD_RIGHT);
+			} else if (value > 0) {
+				raw->buttons |= BUTTON_TO_FLAG(BUTTON_DPAD_RIGHT);
+				raw->buttons &= ~BUTTON_TO_FLAG(BUTTON_DPAD_LEFT);
+			} else {
+				raw->buttons &= ~BUTTON_TO_FLAG(BUTTON_DPAD_LEFT) & ~BUTTON_TO_FLAG(BUTTON_DPAD_RIGHT);
+			}
+			break;
+		case ABS_HAT0Y:
+			if (value < 0) {
+				raw->buttons |= BUTTON_TO_FLAG(BUTTON_DPAD_UP);
+				raw->buttons &= ~BUTTON_TO_FLAG(BUTTON_DPAD_DOWN);
+			} else if (value > 0) {
+				raw->buttons |= BUTTON_TO_FLAG(BUTTON_DPAD_DOWN);
+				raw->buttons &= ~BUTTON_TO_FLAG(BUTTON_DPAD_UP);
+			} else {
+				raw->buttons &= ~BUTTON_TO_FLAG(BUTTON_DPAD_UP) & ~BUTTON_TO_FLAG(BUTTON_DPAD_DOWN);
+			}
+			break;
+		case ABS_HAT1X:
+		case ABS_HAT1Y:
+		case ABS_HAT2X:
+		case ABS_HAT2Y:
+		case ABS_HAT3X:
+		case ABS_HAT3Y:
+			break;
+		case ABS_Z:
+			raw->trigger[TRIGGER_LEFT] = adjust_values_trigger(STATE[gamepad].axis_min[code], STATE[gamepad].axis_max[code], value);
+			break;
+		case ABS_RZ:
+			raw->trigger[TRIGGER_RIGHT] = adjust_values_trigger(STATE[gamepad].axis_min[code], STATE[gamepad].axis_max[code], value);
+			break;
+		default:
+			//printf("EV_ABS %i %i\n", code, value);
+			{
+			int adjusted = adjust_values_stick(STATE[gamepad].axis_min[code], STATE[gamepad].axis_max[code], value);
+			switch(code) {
+				case ABS_X :	raw->stick_x[STICK_LEFT] = adjusted; break;
+				case ABS_Y :	raw->stick_y[STICK_LEFT] = -adjusted; break;
+				case ABS_RX:	raw->stick_x[STICK_RIGHT] = adjusted; break;
+				case ABS_RY:	raw->stick_y[STICK_RIGHT] = -adjusted; break;
+			}
+			}
+			break;
 		}
+		break;
+	default:
+		break;
 	}
+}
+
+/* Drains the pending events of a device */
+static void GamepadReadDevice(int gamepad) {
+	struct input_event events[32];
+	int i, len, changed = 0;
 
-	if (i == GAMEPAD_COUNT) {
+	if (STATE[gamepad].fd == -1) {
 		return;
 	}
 
-	int fd = open(devPath, O_RDWR, 0);
-	if (fd < 0) return;
-	char namebuf[128];
-	int is_gamepad = IsGamepad(fd, namebuf, sizeof (namebuf));
-	if (!is_gamepad) {
-		close(fd);
-		return;
+	while ((len = read(STATE[gamepad].fd, events, (sizeof events))) > 0) {
+		len /= sizeof(events[0]);
+		for (i = 0; i < len; ++i) {
+			GamepadApplyEvent(gamepad, events[i].type, events[i].code, events[i].value);
+		}
+		changed = 1;
 	}
 
-	/* copy the device path */
-	STATE[i].device = strdup(devPath);
-	if (STATE[i].device == NULL) {
+	if (len < 0 && errno != EAGAIN && errno != EINTR) {
+		/* unplugged */
+		GamepadRemoveIndex(gamepad);
+	} else if (changed) {
+		GamepadPublish(gamepad);
+	}
+}
+
+/* Loads a recording made with evtest */
+static void GamepadLoadReplay(void) {
+	FILE *file;
+	char line[512];
+	int type = -1, code = -1;
+	size_t capacity = 0;
+	double first_time = -1.0;
+	double axis_min[ABS_MAX], axis_max[ABS_MAX];
+	int i, slot;
+
+	if (!REPLAY_PATH || (slot = GamepadFindSlot(REPLAY_PATH)) == -1) {
 		return;
 	}
 
-	/* reset device state */
-	GamepadResetState((GAMEPAD_DEVICE)i);
+	file = fopen(REPLAY_PATH, "r");
+	if (!file) {
+		return;
+	}
 
-	fcntl(fd, F_SETFL, O_NONBLOCK);
-	STATE[i].fd = fd;
-	STATE[i].flags |= FLAG_CONNECTED;
+	REPLAY_PAD = slot;
+	GamepadResetRaw(slot);
+	memcpy(axis_min, STATE[slot].axis_min, sizeof(axis_min));
+	memcpy(axis_max, STATE[slot].axis_max, sizeof(axis_max));
 
-	int controller = i;
-	{
-	int i, t;
-	unsigned long keybit[NBITS(KEY_MAX)] = { 0 };
-	unsigned long absbit[NBITS(ABS_MAX)] = { 0 };
-	unsigned long relbit[NBITS(REL_MAX)] = { 0 };
-	unsigned long ffbit[NBITS(FF_MAX)] = { 0 };
+	while (fgets(line, sizeof(line), file)) {
+		GAMEPAD_REPLAY_EVENT event;
+		int value;
 
-	/* See if this device uses the new unified event API */
-	if ((ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keybit)), keybit) >= 0) &&
-		(ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(absbit)), absbit) >= 0) &&
-		(ioctl(fd, EVIOCGBIT(EV_REL, sizeof(relbit)), relbit) >= 0)) {
-
-		/* Get the number of buttons, axes, and other thingamajigs */
-		for (i = BTN_JOYSTICK; i < KEY_MAX; ++i) {
-			if (test_bit(i, keybit)) {
-				//printf("Joystick has button: 0x%x\n", i);
-			}
-		}
-		for (i = 0; i < BTN_JOYSTICK; ++i) {
-			if (test_bit(i, keybit)) {
-				//printf("Joystick has button: 0x%x\n", i);
-			}
-		}
-		for (i = 0; i < ABS_MAX; ++i) {
-			/* Skip hats */
-			if (i == ABS_HAT0X) {
-				i = ABS_HAT3Y;
-				continue;
+		if (sscanf(line, "Event: time %lf, type %d (%*[^)]), code %d (%*[^)]), value %d", &event.time, &event.type, &event.code, &event.value) == 4) {
+			if (first_time < 0.0) {
+				first_time = event.time;
 			}
-			if (test_bit(i, absbit)) {
-				struct input_absinfo absinfo;
 
-				if (ioctl(fd, EVIOCGABS(i), &absinfo) < 0) {
-					continue;
+			event.time -= first_time;
+			if (REPLAY_COUNT == capacity) {
+				GAMEPAD_REPLAY_EVENT *events;
+				capacity = capacity ? capacity * 2 : 256;
+				events = (GAMEPAD_REPLAY_EVENT *)realloc(REPLAY_EVENTS, capacity * sizeof(GAMEPAD_REPLAY_EVENT));
+				if (!events) {
+					break;
 				}
-/*
-				printf("Joystick has absolute axis: 0x%.2x\n", i);
-				printf("Values = { %d, %d, %d, %d, %d }\n",
-					   absinfo.value, absinfo.minimum, absinfo.maximum,
-					   absinfo.fuzz, absinfo.flat);
-*/
-				STATE[controller].axis_min[i] = absinfo.minimum;
-				STATE[controller].axis_max[i] = absinfo.maximum;
+				REPLAY_EVENTS = events;
 			}
-		}
-		for (i = ABS_HAT0X; i <= ABS_HAT3Y; i += 2) {
-			if (test_bit(i, absbit) || test_bit(i + 1, absbit)) {
-				struct input_absinfo absinfo;
-				int hat_index = (i - ABS_HAT0X) / 2;
 
-				if (ioctl(fd, EVIOCGABS(i), &absinfo) < 0) {
-					continue;
-				}
-/*
-				printf("Joystick has hat %d\n", hat_index);
-				printf("Values = { %d, %d, %d, %d, %d }\n",
-					   absinfo.value, absinfo.minimum, absinfo.maximum,
-					   absinfo.fuzz, absinfo.flat);
-*/
-				//joystick->hwdata->hats_indices[joystick->nhats++] = hat_index;
-			}
-		}
-		if (test_bit(REL_X, relbit) || test_bit(REL_Y, relbit)) {
-			//++joystick->nballs;
+			REPLAY_EVENTS[REPLAY_COUNT++] = event;
+		} else if (sscanf(line, " Event type %d", &value) == 1) {
+			type = value;
+		} else if (sscanf(line, " Event code %d", &value) == 1) {
+			code = value;
+		} else if (type == EV_ABS && code >= 0 && code < ABS_MAX) {
+			if (sscanf(line, " Min %d", &value) == 1) axis_min[code] = value;
+			if (sscanf(line, " Max %d", &value) == 1) axis_max[code] = value;
 		}
 	}
 
-	if (ioctl(fd, EVIOCGBIT(EV_FF, sizeof(ffbit)), ffbit) >= 0) {
-		if (test_bit(FF_RUMBLE, ffbit)) {
-			STATE[controller].flags |= FLAG_RUMBLE;
-		}
-		if (test_bit(FF_SINE, ffbit)) {
-			//printf("sine\n");
+	fclose(file);
+
+	if (!REPLAY_COUNT) {
+		REPLAY_PAD = -1;
+		return;
+	}
+
+	for (i = 0; i < ABS_MAX; ++i) {
+		if (axis_max[i] > axis_min[i]) {
+			STATE[slot].axis_min[i] = axis_min[i];
+			STATE[slot].axis_max[i] = axis_max[i];
 		}
 	}
+
+	STATE[slot].device = strdup(REPLAY_PATH);
+	STATE[slot].raw.flags = FLAG_CONNECTED;
+	REPLAY_NEXT = 0;
+	REPLAY_START = GamepadNow();
+	GamepadPublish(slot);
+}
+
+/* Applies the replay events that are due, returns the ms until the next one or -1 */
+static int GamepadReplayStep(void) {
+	double now, wait;
+	int changed = 0;
+
+	if (REPLAY_PAD == -1) {
+		return -1;
 	}
+
+	now = GamepadNow();
+	while (REPLAY_NEXT < REPLAY_COUNT && REPLAY_START + REPLAY_EVENTS[REPLAY_NEXT].time <= now) {
+		GAMEPAD_REPLAY_EVENT *event = &REPLAY_EVENTS[REPLAY_NEXT++];
+		GamepadApplyEvent(REPLAY_PAD, event->type, event->code, event->value);
+		changed = 1;
+	}
+
+	if (REPLAY_NEXT == REPLAY_COUNT) {
+		/* start over after a second with everything released */
+		memset(STATE[REPLAY_PAD].raw.trigger, 0, sizeof(STATE[REPLAY_PAD].raw.trigger));
+		memset(STATE[REPLAY_PAD].raw.stick_x, 0, sizeof(STATE[REPLAY_PAD].raw.stick_x));
+		memset(STATE[REPLAY_PAD].raw.stick_y, 0, sizeof(STATE[REPLAY_PAD].raw.stick_y));
+		STATE[REPLAY_PAD].raw.buttons = 0;
+		REPLAY_NEXT = 0;
+		REPLAY_START = now + 1.0;
+		changed = 1;
+	}
+
+	if (changed) {
+		GamepadPublish(REPLAY_PAD);
+	}
+
+	wait = (REPLAY_START + REPLAY_EVENTS[REPLAY_NEXT].time - now) * 1000.0;
+	return wait > 0.0 ? (int)wait + 1 : 0;
 }
 
-/* Helper to remove a device */
-static void GamepadRemoveDevice(const char* devPath) {
-	int i;
-	for (i = 0; i != GAMEPAD_COUNT; ++i) {
-		if (STATE[i].device != NULL && strcmp(STATE[i].device, devPath) == 0) {
-			if (STATE[i].fd != -1) {
-				close(STATE[i].fd);
-				STATE[i].fd = -1;
+static void *GamepadInputThread(void *arg) {
+	struct epoll_event events[GAMEPAD_COUNT + 2];
+	double last_detect = GamepadNow();
+	int running = 1;
+	(void)arg;
+
+	while (running) {
+		int i, count;
+		int timeout = GamepadReplayStep();
+
+		if (HOTPLUG_FD == -1) {
+			double now = GamepadNow();
+			if ((now - last_detect) * 1000.0 >= DETECT_INTERVAL_MS) {
+				GamepadDetect();
+				last_detect = now;
 			}
-			free(STATE[i].device);
-			STATE[i].device = 0;
-			STATE[i].flags = 0;
+
+			if (timeout == -1 || timeout > DETECT_INTERVAL_MS) {
+				timeout = DETECT_INTERVAL_MS;
+			}
+		}
+
+		count = epoll_wait(EPOLL_FD, events, GAMEPAD_COUNT + 2, timeout);
+		if (count < 0 && errno != EINTR) {
 			break;
 		}
+
+		for (i = 0; i < count; ++i) {
+			unsigned int tag = events[i].data.u32;
+			if (tag == EPOLL_TAG_WAKE) {
+				running = 0;
+			} else if (tag == EPOLL_TAG_HOTPLUG) {
+				GamepadHotplug();
+			} else if (tag < GAMEPAD_COUNT) {
+				GamepadReadDevice(tag);
+			}
+		}
 	}
+
+	return NULL;
+}
+
+void GamepadSetReplayFile(const char *path) {
+	free(REPLAY_PATH);
+	REPLAY_PATH = path ? strdup(path) : NULL;
 }
 
 void GamepadInit(void) {
-	struct udev_list_entry* devices;
-	struct udev_list_entry* item;
-	struct udev_enumerate* enu;
+	struct epoll_event ev;
 	int i;
 
+	if (INPUT_THREAD_RUNNING) {
+		return;
+	}
+
 	/* initialize connection state */
 	for (i = 0; i != GAMEPAD_COUNT; ++i) {
 		STATE[i].flags = 0;
 		STATE[i].fd = STATE[i].effect = -1;
+		STATE[i].device = NULL;
+		memset(&STATE[i].raw, 0, sizeof(STATE[i].raw));
+		GamepadPublish(i);
 	}
 
+	EPOLL_FD = epoll_create1(EPOLL_CLOEXEC);
+	if (EPOLL_FD != -1 && pipe(WAKE_PIPE) == 0) {
+		fcntl(WAKE_PIPE[0], F_SETFD, FD_CLOEXEC);
+		fcntl(WAKE_PIPE[1], F_SETFD, FD_CLOEXEC);
+		memset(&ev, 0, sizeof(ev));
+		ev.events = EPOLLIN;
+		ev.data.u32 = EPOLL_TAG_WAKE;
+		epoll_ctl(EPOLL_FD, EPOLL_CTL_ADD, WAKE_PIPE[0], &ev);
+
+		HOTPLUG_FD = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (HOTPLUG_FD != -1 && inotify_add_watch(HOTPLUG_FD, "/dev/input", IN_CREATE | IN_ATTRIB | IN_DELETE | IN_MOVED_TO | IN_MOVED_FROM) != -1) {
+			ev.data.u32 = EPOLL_TAG_HOTPLUG;
+			epoll_ctl(EPOLL_FD, EPOLL_CTL_ADD, HOTPLUG_FD, &ev);
+		} else if (HOTPLUG_FD != -1) {
+			close(HOTPLUG_FD);
+			HOTPLUG_FD = -1;
+		}
+	} else if (EPOLL_FD != -1) {
+		close(EPOLL_FD);
+		EPOLL_FD = -1;
+	}
+
+	/* devices that are already there, watched from now on */
+	GamepadLoadReplay();
 	GamepadDetect();
+
+	if (EPOLL_FD != -1 && pthread_create(&INPUT_THREAD, NULL, GamepadInputThread, NULL) == 0) {
+		INPUT_THREAD_RUNNING = 1;
+	}
 }
 
 void GamepadUpdate(void) {
-	static unsigned long last = 0;
-	unsigned long cur = time(NULL);
+	static double last = 0.0;
+
+	if (!INPUT_THREAD_RUNNING) {
+		/* no epoll, read everything from here like before */
+		double cur = GamepadNow();
+		int i;
 
-	if (last + 2 < cur) {
-		GamepadDetect();
-		last = cur;
+		if (last + 2.0 < cur) {
+			GamepadDetect();
+			last = cur;
+		}
+
+		GamepadReplayStep();
+		for (i = 0; i != GAMEPAD_COUNT; ++i) {
+			GamepadReadDevice(i);
+		}
 	}
 
 	GamepadUpdateCommon();
 }
 
-static int adjust_values_trigger(double min, double max, double value)
-{
-	return (((value + (0 - min)) / (max - min)) * 255.0);
-}
+static void GamepadUpdateDevice(GAMEPAD_DEVICE gamepad) {
+	GAMEPAD_RAW raw;
+	int i;
 
-static int adjust_values_stick(double min, double max, double value)
-{
-	return (((value + (0 - min)) / (max - min)) * (65535.0)) - 32768.0;
-}
+	GamepadReadSnapshot(gamepad, &raw);
 
-static void GamepadUpdateDevice(GAMEPAD_DEVICE gamepad) {
-	if (STATE[gamepad].flags & FLAG_CONNECTED) {
-		struct input_event events[32];
-		int i, len;
-		int code;
-
-		while ((len = read(STATE[gamepad].fd, events, (sizeof events))) > 0) {
-			len /= sizeof(events[0]);
-			for (i = 0; i < len; ++i) {
-				int button = 0;
-				code = events[i].code;
-				switch (events[i].type) {
-				case EV_KEY:
-					//printf("EV_KEY %i\n", code);
-					switch (code) {
-					case BTN_SOUTH: button = BUTTON_A; break;
-					case BTN_EAST: button = BUTTON_B; break;
-					case BTN_NORTH: button = BUTTON_X; break;
-					case BTN_WEST: button = BUTTON_Y; break;
-					case BTN_TL: button = BUTTON_LEFT_SHOULDER; break;
-					case BTN_TR: button = BUTTON_RIGHT_SHOULDER; break;
-					case BTN_SELECT: button = BUTTON_BACK; break;
-					case BTN_START: button = BUTTON_START; break;
-					case BTN_MODE: button = 0; break; /* XBOX button  */
-					case BTN_THUMBL: button = BUTTON_LEFT_THUMB; break;
-					case BTN_THUMBR: button = BUTTON_RIGHT_THUMB; break;
-					default: button = 0; break;
-					}
-					if (events[i].value) {
-						STATE[gamepad].bCurrent |= BUTTON_TO_FLAG(button);
-					} else {
-						STATE[gamepad].bCurrent &= ~BUTTON_TO_FLAG(button);
-					}
-					break;
-				case EV_ABS:
-					switch (code) {
-					case ABS_HAT0X:
-					case ABS_HAT0Y:
-					case ABS_HAT1X:
-					case ABS_HAT1Y:
-					case ABS_HAT2X:
-					case ABS_HAT2Y:
-					case ABS_HAT3X:
-					case ABS_HAT3Y:
-						//code -= ABS_HAT0X;
-						//printf("ABS_HAT %i\n", code);
-						switch(code) {
-							case ABS_HAT0X:
-								if (events[i].value < 0) {
-									STATE[gamepad].bCurrent |= BUTTON_TO_FLAG(BUTTON_DPAD_LEFT);
-									STATE[gamepad].bCurrent &= ~BUTTON_TO_FLAG(BUTTON_DPAD_RIGHT);
-								} else if (events[i].value > 0) {
-									STATE[gamepad].bCurrent |= BUTTON_TO_FLAG(BUTTON_DPAD_RIGHT);
-									STATE[gamepad].bCurrent &= ~BUTTON_TO_FLAG(BUTTON_DPAD_LEFT);
-								} else {
-									STATE[gamepad].bCurrent &= ~BUTTON_TO_FLAG(BUTTON_DPAD_LEFT) & ~BUTTON_TO_FLAG(BUTTON_DPAD_RIGHT);
-								}
-								break;
-							case ABS_HAT0Y:
-								if (events[i].value < 0) {
-									STATE[gamepad].bCurrent |= BUTTON_TO_FLAG(BUTTON_DPAD_UP);
-									STATE[gamepad].bCurrent &= ~BUTTON_TO_FLAG(BUTTON_DPAD_DOWN);
-								} else if (events[i].value > 0) {
-									STATE[gamepad].bCurrent |= BUTTON_TO_FLAG(BUTTON_DPAD_DOWN);
-									STATE[gamepad].bCurrent &= ~BUTTON_TO_FLAG(BUTTON_DPAD_UP);
-								} else {
-									STATE[gamepad].bCurrent &= ~BUTTON_TO_FLAG(BUTTON_DPAD_UP) & ~BUTTON_TO_FLAG(BUTTON_DPAD_DOWN);
-								}
-								break;
-						}
-						break;
-					default:
-						//printf("EV_ABS %i %i\n", code, events[i].value);
-						if (code == ABS_Z || code == ABS_RZ) {
-							int value = adjust_values_trigger(STATE[gamepad].axis_min[code], STATE[gamepad].axis_max[code], events[i].value);
-							switch(code) {
-								case ABS_Z :	STATE[gamepad].trigger[TRIGGER_LEFT].value = value; break;
-								case ABS_RZ:	STATE[gamepad].trigger[TRIGGER_RIGHT].value = value; break;
-							}
-						} else {
-							int value = adjust_values_stick(STATE[gamepad].axis_min[code], STATE[gamepad].axis_max[code], events[i].value);
-							switch(code) {
-								case ABS_X :	STATE[gamepad].stick[STICK_LEFT].x = value; break;
-								case ABS_Y :	STATE[gamepad].stick[STICK_LEFT].y = -value; break;
-								case ABS_RX:	STATE[gamepad].stick[STICK_RIGHT].x = value; break;
-								case ABS_RY:	STATE[gamepad].stick[STICK_RIGHT].y = -value; break;
-							}
-						}
-						break;
-					}
-					break;
-				case EV_REL:
-					switch (code) {
-					case REL_X:
-					case REL_Y:
-						code -= REL_X;
-						//printf("EV_REL %i %i\n", code, events[i].value);
-						break;
-					default:
-						break;
-					}
-					break;
-				case EV_SYN:
-					switch (code) {
-					case SYN_DROPPED :
-						//printf("Event SYN_DROPPED detected\n");
-						break;
-					default:
-						break;
-					}
-				default:
-					break;
-				}
-			}
-		}
+	/* reset if the device was not already connected */
+	if ((raw.flags & FLAG_CONNECTED) && (STATE[gamepad].flags & FLAG_CONNECTED) == 0) {
+		GamepadResetState(gamepad);
+	}
+
+	STATE[gamepad].flags = raw.flags;
+	STATE[gamepad].bCurrent = raw.buttons;
+	for (i = 0; i != TRIGGER_COUNT; ++i) {
+		STATE[gamepad].trigger[i].value = raw.trigger[i];
+	}
+	for (i = 0; i != STICK_COUNT; ++i) {
+		STATE[gamepad].stick[i].x = raw.stick_x[i];
+		STATE[gamepad].stick[i].y = raw.stick_y[i];
 	}
 }
 
 void GamepadShutdown(void) {
 	int i;
 
-	/* cleanup devices */
-	for (i = 0; i != GAMEPAD_COUNT; ++i) {
-		if (STATE[i].device != NULL) {
-			free(STATE[i].device);
+	if (INPUT_THREAD_RUNNING) {
+		char c = 0;
+		if (write(WAKE_PIPE[1], &c, 1) != 1) {
+			pthread_cancel(INPUT_THREAD);
 		}
+		pthread_join(INPUT_THREAD, NULL);
+		INPUT_THREAD_RUNNING = 0;
+	}
 
-		if (STATE[i].fd != -1) {
-			close(STATE[i].fd);
-		}
+	/* cleanup devices */
+	for (i = 0; i != GAMEPAD_COUNT; ++i) {
+		GamepadRemoveIndex(i);
+		STATE[i].flags = 0;
 	}
+
+	if (HOTPLUG_FD != -1) close(HOTPLUG_FD);
+	if (WAKE_PIPE[0] != -1) close(WAKE_PIPE[0]);
+	if (WAKE_PIPE[1] != -1) close(WAKE_PIPE[1]);
+	if (EPOLL_FD != -1) close(EPOLL_FD);
+	HOTPLUG_FD = WAKE_PIPE[0] = WAKE_PIPE[1] = EPOLL_FD = -1;
+
+	free(REPLAY_EVENTS);
+	REPLAY_EVENTS = NULL;
+	REPLAY_COUNT = REPLAY_NEXT = 0;
+	REPLAY_PAD = -1;
 }
 
 void GamepadSetRumble(GAMEPAD_DEVICE gamepad, float left, float right, unsigned int rumble_length_ms) {
+	pthread_mutex_lock(&DEVICE_LOCK);
 	if (STATE[gamepad].fd != -1) {
 		struct input_event play;
 		struct ff_effect ff;
 
 		/* define an effect for this rumble setting */
+		memset(&ff, 0, sizeof(ff));
 		ff.type = FF_RUMBLE;
 		ff.id = STATE[gamepad].effect;
 		ff.u.rumble.strong_magnitude = (unsigned short)(left * 65535);
@@ -565,12 +876,14 @@ void GamepadSetRumble(GAMEPAD_DEVICE gamepad, float left, float right, unsigned
 		}
 
 		/* play the effect */
+		memset(&play, 0, sizeof(play));
 		play.type = EV_FF;
 		play.code = STATE[gamepad].effect;
 		play.value = 1;
 
 		write(STATE[gamepad].fd, (const void*)&play, sizeof(play));
 	}
+	pthread_mutex_unlock(&DEVICE_LOCK);
 }
 
 #else /* !defined(_WIN32) && !defined(__linux__) */
@@ -24,6 +24,158 @@ static uint32_t get_ticket_count() {
 }
 
 
+#ifndef EMU_RELEASE_BUILD
+static void print_mbedtls_error(const char *what, int result)
+{
+    // we nedd a live object until the printf does its job, hence this special handling
+    std::string err_msg(256, 0);
+    mbedtls_strerror(result, &err_msg[0], err_msg.size());
+    PRINT_DEBUG("sign_auth_data %s: %s\n", what, err_msg.c_str());
+}
+#else
+#define print_mbedtls_error(what, result) ((void)(result))
+#endif
+
+// parsing the key and gathering entropy for the CTR-DRBG is much slower than signing,
+// so both are done once and kept alive, the contexts aren't thread safe so every use is under the mutex
+class Auth_Data_Signer {
+    std::mutex mtx;
+    // the key the contexts were set up with, only set once it was parsed successfully
+    std::string key_content;
+    bool ready = false;
+
+    mbedtls_entropy_context entropy_ctx; // entropy context for random number generation
+    mbedtls_ctr_drbg_context ctr_drbg_ctx; // CTR-DRBG context for deterministic random number generation
+    mbedtls_pk_context private_key_ctx; // holds the parsed private key
+
+    void init(const std::string &private_key_content)
+    {
+        key_content.clear();
+        ready = false;
+
+        // seed the CTR-DRBG context with random numbers, it reseeds itself from the entropy source when needed
+        int result = mbedtls_ctr_drbg_seed(&ctr_drbg_ctx, mbedtls_entropy_func, &entropy_ctx, nullptr, 0);
+        if (result != 0) {
+            print_mbedtls_error("failed to seed the CTR-DRBG context", result);
+            return;
+        }
+
+        result = mbedtls_pk_parse_key(
+            &private_key_ctx,                                      // will hold the parsed private key
+            (const unsigned char *)private_key_content.c_str(),
+            private_key_content.size() + 1,                        // we MUST include the null terminator, otherwise this API returns an error!
+            nullptr, 0,                                            // no password stuff, private key isn't protected
+            mbedtls_ctr_drbg_random, &ctr_drbg_ctx                 // random number generation function + the CTR-DRBG context it requires as an input
+        );
+        if (result != 0) {
+            print_mbedtls_error("failed to parse private key", result);
+            return;
+        }
+
+        // private key must be valid RSA key
+        if (mbedtls_pk_get_type(&private_key_ctx) != MBEDTLS_PK_RSA || // invalid type
+            mbedtls_pk_can_do(&private_key_ctx, MBEDTLS_PK_RSA) == 0)  // or initialized but not properly setup (maybe freed?)
+        {
+            PRINT_DEBUG("sign_auth_data parsed key is not a valid RSA private key\n");
+            return;
+        }
+
+        if (mbedtls_pk_get_len(&private_key_ctx) == 0) { // TODO must be 128 siglen
+            PRINT_DEBUG("sign_auth_data failed to get private key (final buffer) length\n");
+            return;
+        }
+
+        key_content = private_key_content;
+        ready = true;
+    }
+
+    void free_contexts()
+    {
+        mbedtls_pk_free(&private_key_ctx);
+        mbedtls_ctr_drbg_free(&ctr_drbg_ctx);
+        mbedtls_entropy_free(&entropy_ctx);
+    }
+
+    void init_contexts()
+    {
+        mbedtls_entropy_init(&entropy_ctx);
+        mbedtls_ctr_drbg_init(&ctr_drbg_ctx);
+        mbedtls_pk_init(&private_key_ctx);
+    }
+
+public:
+    Auth_Data_Signer()
+    {
+        init_contexts();
+    }
+
+    ~Auth_Data_Signer()
+    {
+        free_contexts();
+    }
+
+    std::vector<uint8_t> sign(const std::string &private_key_content, const uint8_t (&hash)[20])
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        std::vector<uint8_t> signature{};
+
+        if (!ready || key_content != private_key_content) {
+            // a failed or different key starts again from clean contexts
+            free_contexts();
+            init_contexts();
+            init(private_key_content);
+        }
+
+        if (!ready) return signature;
+
+        // resize the output buffer to accomodate the size of the private key
+        const size_t private_key_len = mbedtls_pk_get_len(&private_key_ctx);
+        PRINT_DEBUG("sign_auth_data computed private key (final buffer) length = %zu\n", private_key_len);
+        signature.resize(private_key_len);
+
+        // finally sign the computed hash using RSA and PKCS#1 padding
+        int result = mbedtls_rsa_pkcs1_sign(
+            mbedtls_pk_rsa(private_key_ctx),
+            mbedtls_ctr_drbg_random, &ctr_drbg_ctx,
+            MBEDTLS_MD_SHA1, // we used SHA1 to hash the data
+            sizeof(hash), hash,
+            signature.data() // output
+        );
+
+        if (result != 0) {
+            signature.clear();
+            print_mbedtls_error("RSA signing failed", result);
+        }
+
+        return signature;
+    }
+};
+
+std::vector<uint8_t> sign_auth_data(const std::string &private_key_content, const std::vector<uint8_t> &data, size_t effective_data_len)
+{
+    static Auth_Data_Signer signer{};
+    std::vector<uint8_t> signature{};
+
+    // Hash the data using SHA-1
+    constexpr static int SHA1_DIGEST_LENGTH = 20;
+    uint8_t hash[SHA1_DIGEST_LENGTH]{};
+    int result = mbedtls_sha1(data.data(), effective_data_len, hash);
+    if (result != 0) {
+        print_mbedtls_error("failed to hash the data via SHA1", result);
+        return signature;
+    }
+
+    signature = signer.sign(private_key_content, hash);
+
+#ifndef EMU_RELEASE_BUILD
+        // we nedd a live object until the printf does its job, hence this special handling
+        auto str = uint8_vector_to_hex_string(signature);
+        PRINT_DEBUG("sign_auth_data final signature [%zu bytes]:\n  %s\n", signature.size(), str.c_str());
+#endif
+
+    return signature;
+}
+
 static void steam_auth_manager_ticket_callback(void *object, Common_Message *msg)
 {
     PRINT_DEBUG("steam_auth_manager_ticket_callback\n");
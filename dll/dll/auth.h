@@ -39,138 +39,9 @@ const static std::string app_ticket_key =
     "-----END PRIVATE KEY-----\n";
 
 
-static std::vector<uint8_t> sign_auth_data(const std::string &private_key_content, const std::vector<uint8_t> &data, size_t effective_data_len) {
-    std::vector<uint8_t> signature{};
-
-    // Hash the data using SHA-1
-    constexpr static int SHA1_DIGEST_LENGTH = 20;
-    uint8_t hash[SHA1_DIGEST_LENGTH]{};
-    int result = mbedtls_sha1(data.data(), effective_data_len, hash);
-    if (result != 0)
-    {
-#ifndef EMU_RELEASE_BUILD
-        // we nedd a live object until the printf does its job, hence this special handling
-        std::string err_msg(256, 0);
-        mbedtls_strerror(result, &err_msg[0], err_msg.size());
-        PRINT_DEBUG("sign_auth_data failed to hash the data via SHA1: %s\n", err_msg.c_str());
-#endif
-
-        return signature;
-    }
-
-    mbedtls_entropy_context entropy_ctx; // entropy context for random number generation
-    mbedtls_entropy_init(&entropy_ctx);
-
-    mbedtls_ctr_drbg_context ctr_drbg_ctx; // CTR-DRBG context for deterministic random number generation
-    mbedtls_ctr_drbg_init(&ctr_drbg_ctx);
-
-    // seed the CTR-DRBG context with random numbers
-    result = mbedtls_ctr_drbg_seed(&ctr_drbg_ctx, mbedtls_entropy_func, &entropy_ctx, nullptr, 0);
-    if (mbedtls_ctr_drbg_seed(&ctr_drbg_ctx, mbedtls_entropy_func, &entropy_ctx, nullptr, 0) != 0)
-    {
-        mbedtls_ctr_drbg_free(&ctr_drbg_ctx);
-        mbedtls_entropy_free(&entropy_ctx);
-
-#ifndef EMU_RELEASE_BUILD
-        // we nedd a live object until the printf does its job, hence this special handling
-        std::string err_msg(256, 0);
-        mbedtls_strerror(result, &err_msg[0], err_msg.size());
-        PRINT_DEBUG("sign_auth_data failed to seed the CTR-DRBG context: %s\n", err_msg.c_str());
-#endif
-
-        return signature;
-    }
-
-    mbedtls_pk_context private_key_ctx; // holds the parsed private key
-    mbedtls_pk_init(&private_key_ctx);
-
-    result = mbedtls_pk_parse_key(
-        &private_key_ctx,                                      // will hold the parsed private key
-        (const unsigned char *)private_key_content.c_str(),
-        private_key_content.size() + 1,                        // we MUST include the null terminator, otherwise this API returns an error!
-        nullptr, 0,                                            // no password stuff, private key isn't protected
-        mbedtls_ctr_drbg_random, &ctr_drbg_ctx                 // random number generation function + the CTR-DRBG context it requires as an input
-    );
-
-    if (result != 0)
-    {
-        mbedtls_pk_free(&private_key_ctx);
-        mbedtls_ctr_drbg_free(&ctr_drbg_ctx);
-        mbedtls_entropy_free(&entropy_ctx);
-
-#ifndef EMU_RELEASE_BUILD
-        // we nedd a live object until the printf does its job, hence this special handling
-        std::string err_msg(256, 0);
-        mbedtls_strerror(result, &err_msg[0], err_msg.size());
-        PRINT_DEBUG("sign_auth_data failed to parse private key: %s\n", err_msg.c_str());
-#endif
-
-        return signature;
-    }
-
-    // private key must be valid RSA key
-    if (mbedtls_pk_get_type(&private_key_ctx) != MBEDTLS_PK_RSA || // invalid type
-        mbedtls_pk_can_do(&private_key_ctx, MBEDTLS_PK_RSA) == 0)  // or initialized but not properly setup (maybe freed?)
-    {
-        mbedtls_pk_free(&private_key_ctx);
-        mbedtls_ctr_drbg_free(&ctr_drbg_ctx);
-        mbedtls_entropy_free(&entropy_ctx);
-
-        PRINT_DEBUG("sign_auth_data parsed key is not a valid RSA private key\n");
-        return signature;
-    }
-
-    // get the underlying RSA context from the parsed private key
-    mbedtls_rsa_context* rsa_ctx = mbedtls_pk_rsa(private_key_ctx);
-
-    // resize the output buffer to accomodate the size of the private key
-    const size_t private_key_len = mbedtls_pk_get_len(&private_key_ctx);
-    if (private_key_len == 0) // TODO must be 128 siglen
-    {
-        mbedtls_pk_free(&private_key_ctx);
-        mbedtls_ctr_drbg_free(&ctr_drbg_ctx);
-        mbedtls_entropy_free(&entropy_ctx);
-
-        PRINT_DEBUG("sign_auth_data failed to get private key (final buffer) length\n");
-        return signature;
-    }
-
-    PRINT_DEBUG("sign_auth_data computed private key (final buffer) length = %zu\n", private_key_len);
-    signature.resize(private_key_len);
-
-    // finally sign the computed hash using RSA and PKCS#1 padding
-    result = mbedtls_rsa_pkcs1_sign(
-        rsa_ctx,
-        mbedtls_ctr_drbg_random, &ctr_drbg_ctx,
-        MBEDTLS_MD_SHA1, // we used SHA1 to hash the data
-        sizeof(hash), hash,
-        signature.data() // output
-    );
-
-    mbedtls_pk_free(&private_key_ctx);
-    mbedtls_ctr_drbg_free(&ctr_drbg_ctx);
-    mbedtls_entropy_free(&entropy_ctx);
-
-    if (result != 0)
-    {
-        signature.clear();
-
-#ifndef EMU_RELEASE_BUILD
-        // we nedd a live object until the printf does its job, hence this special handling
-        std::string err_msg(256, 0);
-        mbedtls_strerror(result, &err_msg[0], err_msg.size());
-        PRINT_DEBUG("sign_auth_data RSA signing failed: %s\n", err_msg.c_str());
-#endif
-    }
-
-#ifndef EMU_RELEASE_BUILD
-        // we nedd a live object until the printf does its job, hence this special handling
-        auto str = uint8_vector_to_hex_string(signature);
-        PRINT_DEBUG("sign_auth_data final signature [%zu bytes]:\n  %s\n", signature.size(), str.c_str());
-#endif
-
-    return signature;
-}
+// signs the SHA1 hash of data[0, effective_data_len) with RSA + PKCS#1 padding, returns an empty vector on failure
+// the parsed key and the seeded CTR-DRBG are kept between calls, this is safe to call from any thread
+std::vector<uint8_t> sign_auth_data(const std::string &private_key_content, const std::vector<uint8_t> &data, size_t effective_data_len);
 
 
 struct DLC {
@@ -56,6 +56,8 @@
 #include <string>
 #include <chrono>
 #include <cctype>
+#include <cerrno>
+#include <climits>
 #include <iomanip>
 #include <fstream>
 #include <sstream>
@@ -63,13 +65,17 @@
 
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <set>
 #include <queue>
+#include <deque>
 #include <list>
+#include <memory>
 
 #include <thread>
 #include <mutex>
 #include <condition_variable>
+#include <future>
 
 #include <string.h>
 #include <stdio.h>
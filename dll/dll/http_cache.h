@@ -0,0 +1,74 @@
+#ifndef __INCLUDED_HTTP_CACHE_H__
+#define __INCLUDED_HTTP_CACHE_H__
+
+#include "base.h"
+#include <curl/curl.h>
+
+// files of steam_settings/http kept in memory while they're unchanged on disk, shared by every request for them
+// in online mode the downloads are also recorded in an index with their headers so they can be revalidated once stale
+class Http_Cache
+{
+public:
+    typedef std::vector<std::pair<std::string, std::string>> Headers;
+
+    struct Response {
+        // nullptr if there's no file and it couldn't be downloaded, never modified once returned
+        std::shared_ptr<const std::string> body;
+        // only known for downloaded files
+        Headers headers;
+    };
+
+private:
+    struct Body {
+        long long mtime;
+        unsigned long long size;
+        std::shared_ptr<const std::string> data;
+        unsigned long long last_use;
+    };
+
+    std::mutex mutex;
+    std::string http_folder;
+
+    // files being downloaded, the mutex isn't held during a download and other requests for the same file wait for it
+    std::set<std::string> downloading{};
+    std::condition_variable download_finished;
+
+    std::unordered_map<std::string, Body> bodies{};
+    unsigned long long bodies_size = 0;
+    unsigned long long use_counter = 0;
+
+    // key: file path relative to the http folder
+    nlohmann::json index = nlohmann::json::object();
+    bool index_loaded = false;
+
+    void load_index();
+    void save_index();
+
+    std::shared_ptr<const std::string> load_body(const std::string &relative_path);
+    std::shared_ptr<const std::string> remember_body(const std::string &relative_path, std::string &&data);
+    void forget_body(const std::string &relative_path);
+
+    // returns false if nothing could be downloaded, otherwise the status and the headers of the response
+    bool download(const std::string &url, const nlohmann::json *validators, long *status, std::string *data, Headers *headers);
+
+public:
+    // bodies kept in memory between requests, the least recently used ones are dropped past this size
+    static constexpr unsigned long long MAX_BODIES_SIZE = 64 * 1024 * 1024;
+    // index of the downloaded files, a host name can't start with a dot
+    static constexpr auto index_file_name = ".cache_index.json";
+
+    Http_Cache();
+    Http_Cache(const std::string &http_folder);
+
+    static Http_Cache *get_instance();
+
+    // the value of the header, name is case insensitive
+    static const std::string *find_header(const Headers &headers, const std::string &name);
+    // seconds the response can be used without revalidation, 0 if it must always be revalidated
+    static long long freshness_lifetime(const Headers &headers, long long now);
+
+    // relative_path is the sanitized url, online allows downloading missing and stale files
+    Response fetch(const std::string &url, const std::string &relative_path, bool online);
+};
+
+#endif // __INCLUDED_HTTP_CACHE_H__
@@ -0,0 +1,52 @@
+#ifndef __INCLUDED_INVENTORY_STORE_H__
+#define __INCLUDED_INVENTORY_STORE_H__
+
+#include "base.h"
+
+// item definitions and owned items of the inventory files, json is only used to load and save them
+class Inventory_Store
+{
+public:
+    struct Property {
+        std::string name;
+        std::string value;
+        // values that aren't strings can't be read by the game, only their name is listed
+        bool is_string;
+    };
+
+    struct Definition {
+        SteamItemDef_t id;
+        // sorted by name
+        std::vector<Property> properties;
+        // "name1,name2,...", what GetItemDefinitionProperty returns without a property name
+        std::string property_names;
+    };
+
+private:
+    // both in the order of the json files
+    std::vector<Definition> definitions{};
+    std::unordered_map<SteamItemDef_t, uint32> definition_index{};
+    std::vector<SteamItemDetails_t> items{};
+    std::unordered_map<SteamItemInstanceID_t, uint32> item_index{};
+
+public:
+    // {"<definition id>": {"<property>": "<value>", ...}, ...}
+    void load_definitions(const nlohmann::json &json);
+    // {"<definition id>": <quantity>, ...}, every item instance has the id of its definition
+    void load_items(const nlohmann::json &json);
+    static nlohmann::json items_to_json(const std::vector<SteamItemDetails_t> &items);
+
+    const std::vector<Definition> &get_definitions() const;
+    // nullptr if it's not defined
+    const Definition *find_definition(SteamItemDef_t id) const;
+    static const Property *find_property(const Definition &definition, const char *name);
+
+    const std::vector<SteamItemDetails_t> &get_items() const;
+    // nullptr if the user doesn't own it
+    const SteamItemDetails_t *find_item(SteamItemInstanceID_t id) const;
+    // removes up to quantity, the item is gone once it reaches 0
+    // returns false if the user doesn't own it
+    bool consume_item(SteamItemInstanceID_t id, uint32 quantity);
+};
+
+#endif // __INCLUDED_INVENTORY_STORE_H__
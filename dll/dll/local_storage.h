@@ -50,6 +50,7 @@ public:
     static constexpr auto leaderboard_storage_folder = "leaderboard";
     static constexpr auto user_data_storage          = "local";
     static constexpr auto screenshots_folder         = "screenshots";
+    static constexpr auto avatar_cache_folder        = "avatar_cache";
     static constexpr auto game_settings_folder       = "steam_settings";
 
 private:
@@ -87,7 +88,22 @@ public:
 
     std::vector<image_pixel_t> load_image(std::string const& image_path);
     static std::string load_image_resized(std::string const& image_path, std::string const& image_data, int resolution);
-    bool save_screenshot(std::string const& image_path, uint8_t* img_ptr, int32_t width, int32_t height, int32_t channels);
+    // decodes a png/jpg from the file or, if the path is empty, from the encoded data to RGBA
+    static std::string load_image_data(std::string const& image_path, std::string const& encoded_data, int *width, int *height);
+    static std::string resize_image(std::string const& image_data, int width, int height, int resolution);
+    static std::string encode_image_png(std::string const& image_data, int width, int height);
+    // stretches any image to width x height, channels per pixel are kept
+    static std::string scale_image(const uint8_t *image_data, int width, int height, int channels, int new_width, int new_height);
+    // reads only the header of a png/jpg/tga
+    static bool get_image_size(std::string const& image_path, int *width, int *height);
+    // shared by every png written after the call, 0-9
+    static void set_png_compression_level(int level);
+    // image_path is relative to the screenshots folder, its extension picks the format: .png or .jpg
+    bool save_screenshot(std::string const& image_path, const uint8_t* img_ptr, int32_t width, int32_t height, int32_t channels, int jpg_quality = 90);
+    // copies an image that is already encoded to the screenshots folder
+    bool copy_screenshot(std::string const& image_path, std::string const& source_path);
+    // full path of an image in the screenshots folder
+    std::string get_screenshot_path(std::string const& image_path);
 
     static std::string sanitize_string(std::string name);
     static std::string desanitize_string(std::string name);
@@ -78,6 +78,36 @@ struct TCP_Socket {
     std::chrono::high_resolution_clock::time_point last_heartbeat_sent, last_heartbeat_received;
 };
 
+struct Link_Probe {
+    uint32 sequence;
+    std::chrono::steady_clock::time_point sent;
+    bool replied;
+};
+
+struct Link_Metrics {
+    //milliseconds, srtt is negative until the first reply
+    double srtt = -1.0, jitter = 0.0, last_rtt = -1.0;
+    uint32 next_sequence = 0;
+    std::chrono::steady_clock::time_point last_probe;
+    //the most recent probes, for the loss
+    std::deque<struct Link_Probe> probes;
+
+    //counted since last_rate_update
+    uint64 out_packets = 0, out_bytes = 0, in_packets = 0, in_bytes = 0;
+    std::chrono::steady_clock::time_point last_rate_update;
+    float out_packets_per_sec = 0, out_bytes_per_sec = 0, in_packets_per_sec = 0, in_bytes_per_sec = 0;
+};
+
+//what the networking status apis report for a peer
+struct Link_Stats {
+    //milliseconds, -1 if it was never measured
+    int ping;
+    float jitter;
+    //0.0 - 1.0, of the recent probes
+    float loss;
+    float out_packets_per_sec, out_bytes_per_sec, in_packets_per_sec, in_bytes_per_sec;
+};
+
 struct Connection {
     struct TCP_Socket tcp_socket_outgoing, tcp_socket_incoming;
     bool connected = false;
@@ -87,11 +117,50 @@ struct Connection {
     std::vector<CSteamID> ids;
     uint32 appid;
     std::chrono::high_resolution_clock::time_point last_received;
+    //pongs sent to other peers that still mention this one
+    uint32 gossip_left = 0;
+    std::chrono::high_resolution_clock::time_point last_pong_sent;
+    struct Link_Metrics link;
+};
+
+//messages built on the send paths live here instead of on the heap, everything is freed at once
+//when the last Scope ends and the memory is reused for the next message
+class Message_Arena {
+    //protobuf needs the initial block to be 8 byte aligned
+    alignas(8) char initial_block[4096];
+    google::protobuf::Arena arena;
+    unsigned scopes = 0;
+
+    static google::protobuf::ArenaOptions options(char *block, size_t size)
+    {
+        google::protobuf::ArenaOptions options;
+        options.initial_block = block;
+        options.initial_block_size = size;
+        return options;
+    }
+
+public:
+    Message_Arena(): arena(options(initial_block, sizeof(initial_block))) {}
+    Message_Arena(const Message_Arena &) = delete;
+    Message_Arena &operator=(const Message_Arena &) = delete;
+
+    //scopes can be nested, a message delivered locally while another one is built doesn't free it
+    class Scope {
+        Message_Arena &pool;
+    public:
+        Scope(Message_Arena &pool): pool(pool) { ++pool.scopes; }
+        ~Scope() { if (!--pool.scopes) pool.arena.Reset(); }
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+        //only valid until the scope ends, submessages must come from the same scope
+        template<typename T> T *create() { return google::protobuf::Arena::CreateMessage<T>(&pool.arena); }
+    };
 };
 
 class Networking {
     bool enabled = false;
-    bool query_alive;
+    bool query_alive = false;
     std::chrono::high_resolution_clock::time_point last_run;
     sock_t query_socket, udp_socket, tcp_socket;
     uint16 udp_port, tcp_port;
@@ -103,32 +172,53 @@ class Networking {
     bool handle_announce(Common_Message *msg, IP_PORT ip_port);
     bool handle_low_level_udp(Common_Message *msg, IP_PORT ip_port);
     bool handle_tcp(Common_Message *msg, struct TCP_Socket &socket);
+    void connect_tcp(struct Connection &conn);
     void send_announce_broadcasts();
+    void send_udp_to(Common_Message *msg, IP_PORT ip_port);
+    void send_probes();
+    void send_link_probes();
+    void update_link_rates();
+    std::chrono::high_resolution_clock::time_point last_link_dump;
 
     std::vector<CSteamID> ids;
     uint32 appid;
     std::chrono::high_resolution_clock::time_point last_broadcast;
+    //seconds until the next announce, doubles after each one
+    double announce_interval;
     std::vector<IP_PORT> custom_broadcasts;
+    //network byte order, 0 if announces are broadcasted
+    uint32 multicast_group;
+    //udp addresses of peers we heard of from others but haven't talked to yet
+    std::set<IP_PORT> pending_probes;
+    //round robin over the connections, one is pinged every PROBE_INTERVAL
+    size_t next_probe = 0;
+    std::chrono::high_resolution_clock::time_point last_probe;
 
     std::vector<struct TCP_Socket> accepted;
     std::recursive_mutex mutex;
 
     struct Network_Callback_Container callbacks[CALLBACK_IDS_MAX];
     std::vector<Common_Message> local_send;
+    //set while local messages are handed to the callbacks, from sendTo or Run, anything they send is queued
+    bool delivering_local = false;
+    Message_Arena message_arena;
 
     bool add_id_connection(struct Connection *connection, CSteamID steam_id);
     void run_callbacks(Callback_Ids id, Common_Message *msg);
     void run_callback_user(CSteamID steam_id, bool online, uint32 appid);
     void do_callbacks_message(Common_Message *msg);
 
-    Common_Message create_announce(bool request);
+    //a pong to a peer tells it its own address first, then the peers that were learned recently
+    Common_Message *create_announce(Message_Arena::Scope &scope, bool request, const struct Connection *to = NULL, IP_PORT to_ip_port = {});
 public:
     //NOTE: for all functions ips/ports are passed/returned in host byte order
     //ex: 127.0.0.1 should be passed as 0x7F000001
     static std::set<IP_PORT> resolve_ip(std::string dns);
-    Networking(CSteamID id, uint32 appid, uint16 port, std::set<IP_PORT> *custom_broadcasts, bool disable_sockets);
+    Networking(CSteamID id, uint32 appid, uint16 port, std::set<IP_PORT> *custom_broadcasts, uint32 multicast_group, bool disable_sockets);
     ~Networking();
     void addListenId(CSteamID id);
+    //send a burst of announces so peers find us quickly, then back off again
+    void restartAnnounces();
     void setAppID(uint32 appid);
     void Run();
     bool sendTo(Common_Message *msg, bool reliable, Connection *conn = NULL);
@@ -139,6 +229,10 @@ public:
     bool setCallback(Callback_Ids id, CSteamID steam_id, void (*message_callback)(void *object, Common_Message *msg), void *object);
     uint32 getIP(CSteamID id);
     uint32 getOwnIP();
+    //false if there's no connection to that user
+    bool getLinkStats(CSteamID id, struct Link_Stats *stats);
+    //one line with all the metrics, for logs
+    static std::string linkStatsString(const struct Link_Stats &stats);
 
     void startQuery(IP_PORT ip_port);
     void shutDownQuery();
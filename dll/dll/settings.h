@@ -28,6 +28,15 @@ struct DLC_entry {
     bool available;
 };
 
+// DLCs in the order they were added, indexed by appid
+struct DLC_Table {
+    std::vector<struct DLC_entry> entries;
+    std::unordered_map<AppId_t, size_t> index;
+
+    void add(AppId_t appID, std::string name, bool available);
+    const struct DLC_entry *find(AppId_t appID) const;
+};
+
 struct Mod_entry {
     PublishedFileId_t id;
     std::string title;
@@ -45,6 +54,7 @@ struct Mod_entry {
     bool acceptedForUse;
     bool tagsTruncated;
     std::string tags; 
+    std::vector<std::pair<std::string, std::string>> keyValueTags;
     // file/url information
     UGCHandle_t handleFile = generate_file_handle();
     UGCHandle_t handlePreviewFile = generate_file_handle();
@@ -73,6 +83,16 @@ private:
 
 };
 
+// mods in the order they were added, indexed by id
+struct Mod_Table {
+    std::vector<struct Mod_entry> entries;
+    std::unordered_map<PublishedFileId_t, size_t> index;
+
+    struct Mod_entry &get_or_add(PublishedFileId_t id);
+    struct Mod_entry *find(PublishedFileId_t id);
+    const struct Mod_entry *find(PublishedFileId_t id) const;
+};
+
 struct Leaderboard_config {
     enum ELeaderboardSortMethod sort_method;
     enum ELeaderboardDisplayType display_type;
@@ -96,6 +116,7 @@ struct Image_Data {
     uint32 width;
     uint32 height;
     std::string data;
+    uint32 refcount = 0;
 };
 
 struct Controller_Settings {
@@ -143,10 +164,12 @@ class Settings {
 
     bool unlockAllDLCs;
     bool offline;
-    std::vector<struct DLC_entry> DLCs;
-    std::vector<struct Mod_entry> mods;
+    std::shared_ptr<struct DLC_Table> DLCs;
+    std::shared_ptr<struct Mod_Table> mods;
     std::map<AppId_t, std::string> app_paths;
     std::map<std::string, Leaderboard_config> leaderboards;
+    std::unordered_multimap<size_t, int> image_hashes;
+    std::vector<int> free_image_slots;
     std::map<std::string, Stat_config> stats;
     bool create_unknown_leaderboards;
     uint16 port;
@@ -180,6 +203,9 @@ public:
     bool hasDLC(AppId_t appID);
     bool getDLC(unsigned int index, AppId_t &appID, bool &available, std::string &name);
     bool allDLCUnlocked() const;
+    // the client and server settings share the same table
+    std::shared_ptr<struct DLC_Table> getDLCTable() { return DLCs; }
+    void setDLCTable(std::shared_ptr<struct DLC_Table> table) { DLCs = table; }
 
     //Depots
     std::vector<DepotId_t> depots;
@@ -191,9 +217,13 @@ public:
     //mod stuff
     void addMod(PublishedFileId_t id, std::string title, std::string path);
     void addModDetails(PublishedFileId_t id, Mod_entry details);
-    Mod_entry getMod(PublishedFileId_t id);
+    // returns an empty entry if the mod isn't installed
+    const Mod_entry &getMod(PublishedFileId_t id);
     bool isModInstalled(PublishedFileId_t id);
     std::set<PublishedFileId_t> modSet();
+    // the client and server settings share the same table
+    std::shared_ptr<struct Mod_Table> getModTable() { return mods; }
+    void setModTable(std::shared_ptr<struct Mod_Table> table) { mods = table; }
 
     //leaderboards
     void setLeaderboard(std::string leaderboard, enum ELeaderboardSortMethod sort_method, enum ELeaderboardDisplayType display_type);
@@ -203,6 +233,8 @@ public:
 
     //custom broadcasts
     std::set<IP_PORT> custom_broadcasts;
+    //host byte order, 0 to broadcast the announces
+    uint32 multicast_group = 0;
 
     //stats
     std::map<std::string, Stat_config> getStats() { return stats; }
@@ -216,7 +248,10 @@ public:
 
     //images
     std::map<int, struct Image_Data> images;
+    // identical images share the same handle, every call takes a reference
     int add_image(std::string data, uint32 width, uint32 height);
+    // drops a reference taken by add_image, the slot is freed and later reused once nothing references it
+    void remove_image(int image);
     bool disable_account_avatar = false;
 
     //installed app ids, Steam_Apps::BIsAppInstalled()
@@ -231,6 +266,8 @@ public:
     //controller
     struct Controller_Settings controller_settings;
     std::string glyphs_directory;
+    //evtest recording played as an extra gamepad, empty if there's none
+    std::string controller_replay_file;
 
     //networking
     bool disable_networking = false;
@@ -272,6 +309,14 @@ public:
 
     // use new app_ticket auth instead of old one
     bool enable_new_app_ticket = false;
+
+    //voice chat input, a wav/raw file or a named pipe used instead of the microphone
+    std::string voice_input_path;
+    uint32 voice_input_sample_rate = 0;
+
+    //screenshots, png or jpg, quality is the png compression level (0-9) or the jpg quality (1-100), negative for the default
+    std::string screenshot_format = "png";
+    int screenshot_quality = -1;
 };
 
 #endif
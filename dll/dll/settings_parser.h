@@ -23,5 +23,7 @@
 //returns appid
 uint32 create_localstorage_settings(Settings **settings_client_out, Settings **settings_server_out, Local_Storage **local_storage_out);
 void save_global_settings(Local_Storage *local_storage, char *name, char *language);
+// fills the dlc table shared by both settings from a DLC.txt, false if the file can't be opened
+bool parse_dlc_file(const std::string &dlc_config_path, Settings *settings_client, Settings *settings_server);
 
 #endif
@@ -55,6 +55,44 @@
 
 #include "overlay/steam_overlay.h"
 
+// constructed by the factory the first time it's used, the pointer stays the same afterwards
+template <class T>
+class Lazy_Interface {
+    std::atomic<T *> instance{nullptr};
+    std::function<T *()> factory{};
+
+public:
+    Lazy_Interface() {}
+    Lazy_Interface(const Lazy_Interface &) = delete;
+    Lazy_Interface &operator=(const Lazy_Interface &) = delete;
+    ~Lazy_Interface() { reset(); }
+
+    void set_factory(std::function<T *()> f) { factory = std::move(f); }
+
+    T *get() {
+        T *p = instance.load(std::memory_order_acquire);
+        if (p) return p;
+
+        // the constructors register themselves in the shared callback lists
+        std::lock_guard<std::recursive_mutex> lock(global_mutex);
+        p = instance.load(std::memory_order_relaxed);
+        if (!p) {
+            p = factory();
+            instance.store(p, std::memory_order_release);
+        }
+
+        return p;
+    }
+
+    // nullptr if nothing requested it yet
+    T *created() const { return instance.load(std::memory_order_acquire); }
+
+    void reset() { delete instance.exchange(nullptr); }
+
+    operator T *() { return get(); }
+    T *operator->() { return get(); }
+};
+
 enum Steam_Pipe {
     NO_USER,
     CLIENT,
@@ -96,42 +134,42 @@ public:
     Steam_Apps *steam_apps;
     Steam_Networking *steam_networking;
     Steam_Remote_Storage *steam_remote_storage;
-    Steam_Screenshots *steam_screenshots;
-    Steam_HTTP *steam_http;
-    Steam_Controller *steam_controller;
-    Steam_UGC *steam_ugc;
-    Steam_Applist *steam_applist;
-    Steam_Music *steam_music;
-    Steam_MusicRemote *steam_musicremote;
-    Steam_HTMLsurface *steam_HTMLsurface;
-    Steam_Inventory *steam_inventory;
-    Steam_Video *steam_video;
-    Steam_Parental *steam_parental;
+    Lazy_Interface<Steam_Screenshots> steam_screenshots;
+    Lazy_Interface<Steam_HTTP> steam_http;
+    Lazy_Interface<Steam_Controller> steam_controller;
+    Lazy_Interface<Steam_UGC> steam_ugc;
+    Lazy_Interface<Steam_Applist> steam_applist;
+    Lazy_Interface<Steam_Music> steam_music;
+    Lazy_Interface<Steam_MusicRemote> steam_musicremote;
+    Lazy_Interface<Steam_HTMLsurface> steam_HTMLsurface;
+    Lazy_Interface<Steam_Inventory> steam_inventory;
+    Lazy_Interface<Steam_Video> steam_video;
+    Lazy_Interface<Steam_Parental> steam_parental;
     Steam_Networking_Sockets *steam_networking_sockets;
     Steam_Networking_Sockets_Serialized *steam_networking_sockets_serialized;
     Steam_Networking_Messages *steam_networking_messages;
-    Steam_Game_Coordinator *steam_game_coordinator;
+    Lazy_Interface<Steam_Game_Coordinator> steam_game_coordinator;
     Steam_Networking_Utils *steam_networking_utils;
-    Steam_Unified_Messages *steam_unified_messages;
-    Steam_Game_Search *steam_game_search;
-    Steam_Parties *steam_parties;
-    Steam_RemotePlay *steam_remoteplay;
-    Steam_TV *steam_tv;
+    Lazy_Interface<Steam_Unified_Messages> steam_unified_messages;
+    Lazy_Interface<Steam_Game_Search> steam_game_search;
+    Lazy_Interface<Steam_Parties> steam_parties;
+    Lazy_Interface<Steam_RemotePlay> steam_remoteplay;
+    Lazy_Interface<Steam_TV> steam_tv;
 
     Steam_GameServer *steam_gameserver;
     Steam_Utils *steam_gameserver_utils;
     Steam_GameServerStats *steam_gameserverstats;
     Steam_Networking *steam_gameserver_networking;
-    Steam_HTTP *steam_gameserver_http;
-    Steam_Inventory *steam_gameserver_inventory;
-    Steam_UGC *steam_gameserver_ugc;
+    Lazy_Interface<Steam_HTTP> steam_gameserver_http;
+    Lazy_Interface<Steam_Inventory> steam_gameserver_inventory;
+    Lazy_Interface<Steam_UGC> steam_gameserver_ugc;
     Steam_Apps *steam_gameserver_apps;
     Steam_Networking_Sockets *steam_gameserver_networking_sockets;
     Steam_Networking_Sockets_Serialized *steam_gameserver_networking_sockets_serialized;
     Steam_Networking_Messages *steam_gameserver_networking_messages;
-    Steam_Game_Coordinator *steam_gameserver_game_coordinator;
-    Steam_Masterserver_Updater *steam_masterserver_updater;
-    Steam_AppTicket *steam_app_ticket;
+    Lazy_Interface<Steam_Game_Coordinator> steam_gameserver_game_coordinator;
+    Lazy_Interface<Steam_Masterserver_Updater> steam_masterserver_updater;
+    Lazy_Interface<Steam_AppTicket> steam_app_ticket;
 
     Steam_Overlay* steam_overlay;
 
@@ -146,6 +184,14 @@ public:
 
     bool gameserver_has_ipv6_functions;
 
+    // GetISteamGenericInterface() results by exact version string, indexed by [server pipe][has user]
+    // the interfaces never move once created, so a resolved version always maps to the same pointer
+    std::mutex interface_cache_mutex;
+    std::unordered_map<std::string, void *> interface_cache[2][2];
+    // never reused, a client created at the address of a destroyed one doesn't match its cached lookups
+    unsigned long long interface_cache_generation;
+    void *resolve_generic_interface( HSteamUser hSteamUser, HSteamPipe hSteamPipe, const char *pchVersion );
+
     Steam_Client();
     ~Steam_Client();
     	// Creates a communication pipe to the Steam client.
@@ -19,6 +19,7 @@
 #ifndef CONTROLLER_SUPPORT
 inline void GamepadInit(void) {}
 inline void GamepadShutdown(void) {}
+inline void GamepadSetReplayFile(const char *path) {}
 inline void GamepadUpdate(void) {}
 inline GAMEPAD_BOOL GamepadIsConnected(GAMEPAD_DEVICE device) { return GAMEPAD_FALSE; }
 inline GAMEPAD_BOOL GamepadButtonDown(GAMEPAD_DEVICE device, GAMEPAD_BUTTON button) { return GAMEPAD_FALSE; }
@@ -34,32 +35,115 @@ struct Controller_Map {
     std::map<ControllerAnalogActionHandle_t, std::pair<std::set<int>, enum EInputSourceMode>> active_analog;
 };
 
+// action names are stored uppercase, this compares them case insensitively so the lookups don't need a copy
+struct Controller_Name_Less {
+    typedef void is_transparent;
+
+    static bool less(const char *a, const char *b) {
+        for (;; ++a, ++b) {
+            int ca = std::toupper((unsigned char)*a), cb = std::toupper((unsigned char)*b);
+            if (ca != cb || !ca) return ca < cb;
+        }
+    }
+
+    bool operator()(const std::string &a, const std::string &b) const { return less(a.c_str(), b.c_str()); }
+    bool operator()(const std::string &a, const char *b) const { return less(a.c_str(), b); }
+    bool operator()(const char *a, const std::string &b) const { return less(a, b.c_str()); }
+};
+
+// how many different analog sources a binding can have, one per entry of Steam_Controller::analog_strings
+#define CONTROLLER_ANALOG_SOURCES 5
+
+struct Controller_Analog_Binding {
+    // analog ids in the order they are checked, both triggers, both sticks and the dpad at most
+    int sources[CONTROLLER_ANALOG_SOURCES];
+    unsigned count;
+    enum EInputSourceMode mode;
+};
+
 struct Controller_Action {
     ControllerHandle_t controller_handle;
-    struct Controller_Map active_map;
-    ControllerDigitalActionHandle_t active_set;
+    ControllerActionSetHandle_t active_set = 0;
+    std::vector<ControllerActionSetHandle_t> active_layers;
+
+    // the active set with its layers on top, indexed by action handle
+    // a digital binding is the mask of its buttons, see Steam_Controller::update_buttons_down
+    std::vector<uint32> digital_bindings;
+    std::vector<Controller_Analog_Binding> analog_bindings;
 
     Controller_Action(ControllerHandle_t controller_handle) {
         this->controller_handle = controller_handle;
     }
 
-    void activate_action_set(ControllerDigitalActionHandle_t active_set, std::map<ControllerActionSetHandle_t, struct Controller_Map> &controller_maps) {
+    static void apply_map(const struct Controller_Map &map, std::vector<uint32> &digital, std::vector<Controller_Analog_Binding> &analog) {
+        for (auto & d : map.active_digital) {
+            if (d.first >= digital.size()) continue;
+            uint32 mask = 0;
+            for (int button : d.second) mask |= 1u << button;
+            digital[d.first] = mask;
+        }
+
+        for (auto & a : map.active_analog) {
+            if (a.first >= analog.size()) continue;
+            Controller_Analog_Binding binding = {};
+            for (int source : a.second.first) {
+                if (binding.count < CONTROLLER_ANALOG_SOURCES) binding.sources[binding.count++] = source;
+            }
+            binding.mode = a.second.second;
+            analog[a.first] = binding;
+        }
+    }
+
+    // only done when the set or the layers change, the per frame queries just index the tables
+    void compile(const std::map<ControllerActionSetHandle_t, struct Controller_Map> &controller_maps, uint64 handle_count) {
+        digital_bindings.assign(handle_count, 0);
+        analog_bindings.assign(handle_count, Controller_Analog_Binding{{}, 0, k_EInputSourceMode_None});
+
         auto map = controller_maps.find(active_set);
-        if (map == controller_maps.end()) return;
+        if (map != controller_maps.end()) apply_map(map->second, digital_bindings, analog_bindings);
+
+        for (auto layer : active_layers) {
+            map = controller_maps.find(layer);
+            if (map != controller_maps.end()) apply_map(map->second, digital_bindings, analog_bindings);
+        }
+    }
+
+    void activate_action_set(ControllerActionSetHandle_t active_set, const std::map<ControllerActionSetHandle_t, struct Controller_Map> &controller_maps, uint64 handle_count) {
+        if (this->active_set == active_set) return;
+        if (controller_maps.find(active_set) == controller_maps.end()) return;
         this->active_set = active_set;
-        this->active_map = map->second;
+        compile(controller_maps, handle_count);
+    }
+
+    void activate_layer(ControllerActionSetHandle_t layer, const std::map<ControllerActionSetHandle_t, struct Controller_Map> &controller_maps, uint64 handle_count) {
+        if (controller_maps.find(layer) == controller_maps.end()) return;
+        if (std::find(active_layers.begin(), active_layers.end(), layer) != active_layers.end()) return;
+        if (active_layers.size() >= STEAM_INPUT_MAX_ACTIVE_LAYERS) return;
+        active_layers.push_back(layer);
+        compile(controller_maps, handle_count);
     }
 
-    std::set<int> button_id(ControllerDigitalActionHandle_t handle) {
-        auto a = active_map.active_digital.find(handle);
-        if (a == active_map.active_digital.end()) return {};
-        return a->second;
+    void deactivate_layer(ControllerActionSetHandle_t layer, const std::map<ControllerActionSetHandle_t, struct Controller_Map> &controller_maps, uint64 handle_count) {
+        auto it = std::find(active_layers.begin(), active_layers.end(), layer);
+        if (it == active_layers.end()) return;
+        active_layers.erase(it);
+        compile(controller_maps, handle_count);
     }
 
-    std::pair<std::set<int>, enum EInputSourceMode> analog_id(ControllerAnalogActionHandle_t handle) {
-        auto a = active_map.active_analog.find(handle);
-        if (a == active_map.active_analog.end()) return std::pair<std::set<int>, enum EInputSourceMode>({}, k_EInputSourceMode_None);
-        return a->second;
+    void deactivate_all_layers(const std::map<ControllerActionSetHandle_t, struct Controller_Map> &controller_maps, uint64 handle_count) {
+        if (active_layers.empty()) return;
+        active_layers.clear();
+        compile(controller_maps, handle_count);
+    }
+
+    uint32 button_mask(ControllerDigitalActionHandle_t handle) const {
+        if (handle >= digital_bindings.size()) return 0;
+        return digital_bindings[handle];
+    }
+
+    const Controller_Analog_Binding *analog_binding(ControllerAnalogActionHandle_t handle) const {
+        if (handle >= analog_bindings.size() || !analog_bindings[handle].count) return nullptr;
+        return &analog_bindings[handle];
     }
 };
 
@@ -93,6 +177,8 @@ enum EXTRA_GAMEPAD_BUTTONS {
 #define STICK_DPAD 3
 #define DEADZONE_BUTTON_STICK 0.3
 
+static_assert(BUTTON_STICK_RIGHT_RIGHT < 32, "digital bindings are 32 bit button masks");
+
 class Steam_Controller :
 public ISteamController001,
 public ISteamController003,
@@ -152,12 +238,17 @@ public ISteamInput
         {"trigger", k_EInputSourceMode_Trigger},
     };
 
-    std::map<std::string, ControllerActionSetHandle_t> action_handles;
-    std::map<std::string, ControllerDigitalActionHandle_t> digital_action_handles;
-    std::map<std::string, ControllerAnalogActionHandle_t> analog_action_handles;
+    std::map<std::string, ControllerActionSetHandle_t, Controller_Name_Less> action_handles;
+    std::map<std::string, ControllerDigitalActionHandle_t, Controller_Name_Less> digital_action_handles;
+    std::map<std::string, ControllerAnalogActionHandle_t, Controller_Name_Less> analog_action_handles;
+    // all the handles are below this
+    uint64 handle_count = 1;
 
     std::map<ControllerActionSetHandle_t, struct Controller_Map> controller_maps;
-    std::map<ControllerHandle_t, struct Controller_Action> controllers;
+    // index: controller handle - 1
+    std::vector<struct Controller_Action> controllers;
+    // pressed buttons of every gamepad, updated after GamepadUpdate
+    uint32 buttons_down[GAMEPAD_COUNT] = {};
 
     std::map<EInputActionOrigin, std::string> steaminput_glyphs;
     std::map<EControllerActionOrigin, std::string> steamcontroller_glyphs;
@@ -226,6 +317,44 @@ public ISteamInput
                 }
             }
         }
+
+        handle_count = handle_num;
+    }
+
+    Controller_Action *find_controller(ControllerHandle_t controller_handle) {
+        if (controller_handle < 1 || controller_handle > controllers.size()) return nullptr;
+        return &controllers[controller_handle - 1];
+    }
+
+    // the digital state of every button a digital action can be bound to, once per frame instead of once per query
+    void update_buttons_down() {
+        for (int i = 0; i < GAMEPAD_COUNT; ++i) {
+            GAMEPAD_DEVICE device = (GAMEPAD_DEVICE)i;
+            uint32 mask = 0;
+            if (GamepadIsConnected(device)) {
+                for (int button = 0; button < BUTTON_COUNT; ++button) {
+                    if (GamepadButtonDown(device, (GAMEPAD_BUTTON)button)) mask |= 1u << button;
+                }
+
+                if (GamepadTriggerLength(device, TRIGGER_LEFT) > 0.8) mask |= 1u << BUTTON_LTRIGGER;
+                if (GamepadTriggerLength(device, TRIGGER_RIGHT) > 0.8) mask |= 1u << BUTTON_RTRIGGER;
+
+                for (int stick = STICK_LEFT; stick <= STICK_RIGHT; ++stick) {
+                    int first = stick == STICK_LEFT ? BUTTON_STICK_LEFT_UP : BUTTON_STICK_RIGHT_UP;
+                    float x = 0, y = 0, len = GamepadStickLength(device, (GAMEPAD_STICK)stick);
+                    GamepadStickNormXY(device, (GAMEPAD_STICK)stick, &x, &y);
+                    x *= len;
+                    y *= len;
+                    // same order as EXTRA_GAMEPAD_BUTTONS: up, down, left, right
+                    if (y > DEADZONE_BUTTON_STICK) mask |= 1u << first;
+                    if (y < -DEADZONE_BUTTON_STICK) mask |= 1u << (first + 1);
+                    if (x < -DEADZONE_BUTTON_STICK) mask |= 1u << (first + 2);
+                    if (x > DEADZONE_BUTTON_STICK) mask |= 1u << (first + 3);
+                }
+            }
+
+            buttons_down[i] = mask;
+        }
     }
 
 public:
@@ -305,18 +434,25 @@ bool Init(bool bExplicitlyCallRunFrame)
         return true;
     }
 
+#if defined(__linux__)
+    if (settings->controller_replay_file.size()) {
+        GamepadSetReplayFile(settings->controller_replay_file.c_str());
+    }
+#endif
+
     GamepadInit();
     GamepadUpdate();
+    update_buttons_down();
 
     for (int i = 1; i < 5; ++i) {
         struct Controller_Action cont_action(i);
         //Activate the first action set.
         //TODO: check exactly what decides which gets activated by default
         if (action_handles.size() >= 1) {
-            cont_action.activate_action_set(action_handles.begin()->second, controller_maps);
+            cont_action.activate_action_set(action_handles.begin()->second, controller_maps, handle_count);
         }
 
-        controllers.insert(std::pair<ControllerHandle_t, struct Controller_Action>(i, cont_action));
+        controllers.push_back(cont_action);
     }
 
     rumble_thread_data = new Rumble_Thread_Data();
@@ -346,7 +482,7 @@ bool Shutdown()
         return true;
     }
 
-    controllers = std::map<ControllerHandle_t, struct Controller_Action>();
+    controllers.clear();
     rumble_thread_data->rumble_mutex.lock();
     rumble_thread_data->kill_rumble_thread = true;
     rumble_thread_data->rumble_mutex.unlock();
@@ -421,6 +557,7 @@ void RunFrame(bool bReservedValue)
     }
 
     GamepadUpdate();
+    update_buttons_down();
 }
 
 void RunFrame()
@@ -471,10 +608,7 @@ ControllerActionSetHandle_t GetActionSetHandle( const char *pszActionSetName )
 {
     PRINT_DEBUG("Steam_Controller::GetActionSetHandle %s\n", pszActionSetName);
     if (!pszActionSetName) return 0;
-    std::string upper_action_name(pszActionSetName);
-    std::transform(upper_action_name.begin(), upper_action_name.end(), upper_action_name.begin(),[](unsigned char c){ return std::toupper(c); });
-
-    auto set_handle = action_handles.find(upper_action_name);
+    auto set_handle = action_handles.find(pszActionSetName);
     if (set_handle == action_handles.end()) return 0;
 
     PRINT_DEBUG("Steam_Controller::GetActionSetHandle %s ret %llu\n", pszActionSetName, set_handle->second);
@@ -490,46 +624,84 @@ void ActivateActionSet( ControllerHandle_t controllerHandle, ControllerActionSet
     PRINT_DEBUG("Steam_Controller::ActivateActionSet %llu %llu\n", controllerHandle, actionSetHandle);
     if (controllerHandle == STEAM_CONTROLLER_HANDLE_ALL_CONTROLLERS) {
         for (auto & c: controllers) {
-            c.second.activate_action_set(actionSetHandle, controller_maps);
+            c.activate_action_set(actionSetHandle, controller_maps, handle_count);
         }
     }
 
-    auto controller = controllers.find(controllerHandle);
-    if (controller == controllers.end()) return;
+    Controller_Action *controller = find_controller(controllerHandle);
+    if (!controller) return;
 
-    controller->second.activate_action_set(actionSetHandle, controller_maps);
+    controller->activate_action_set(actionSetHandle, controller_maps, handle_count);
 }
 
 ControllerActionSetHandle_t GetCurrentActionSet( ControllerHandle_t controllerHandle )
 {
     //TODO: should return zero if no action set specifically activated with ActivateActionSet
     PRINT_DEBUG("Steam_Controller::GetCurrentActionSet %llu\n", controllerHandle);
-    auto controller = controllers.find(controllerHandle);
-    if (controller == controllers.end()) return 0;
+    Controller_Action *controller = find_controller(controllerHandle);
+    if (!controller) return 0;
 
-    return controller->second.active_set;
+    return controller->active_set;
 }
 
 
 void ActivateActionSetLayer( ControllerHandle_t controllerHandle, ControllerActionSetHandle_t actionSetLayerHandle )
 {
-    PRINT_DEBUG("Steam_Controller::ActivateActionSetLayer\n");
+    PRINT_DEBUG("Steam_Controller::ActivateActionSetLayer %llu %llu\n", controllerHandle, actionSetLayerHandle);
+    if (controllerHandle == STEAM_CONTROLLER_HANDLE_ALL_CONTROLLERS) {
+        for (auto & c: controllers) {
+            c.activate_layer(actionSetLayerHandle, controller_maps, handle_count);
+        }
+    }
+
+    Controller_Action *controller = find_controller(controllerHandle);
+    if (!controller) return;
+
+    controller->activate_layer(actionSetLayerHandle, controller_maps, handle_count);
 }
 
 void DeactivateActionSetLayer( ControllerHandle_t controllerHandle, ControllerActionSetHandle_t actionSetLayerHandle )
 {
-    PRINT_DEBUG("Steam_Controller::DeactivateActionSetLayer\n");
+    PRINT_DEBUG("Steam_Controller::DeactivateActionSetLayer %llu %llu\n", controllerHandle, actionSetLayerHandle);
+    if (controllerHandle == STEAM_CONTROLLER_HANDLE_ALL_CONTROLLERS) {
+        for (auto & c: controllers) {
+            c.deactivate_layer(actionSetLayerHandle, controller_maps, handle_count);
+        }
+    }
+
+    Controller_Action *controller = find_controller(controllerHandle);
+    if (!controller) return;
+
+    controller->deactivate_layer(actionSetLayerHandle, controller_maps, handle_count);
 }
 
 void DeactivateAllActionSetLayers( ControllerHandle_t controllerHandle )
 {
-    PRINT_DEBUG("Steam_Controller::DeactivateAllActionSetLayers\n");
+    PRINT_DEBUG("Steam_Controller::DeactivateAllActionSetLayers %llu\n", controllerHandle);
+    if (controllerHandle == STEAM_CONTROLLER_HANDLE_ALL_CONTROLLERS) {
+        for (auto & c: controllers) {
+            c.deactivate_all_layers(controller_maps, handle_count);
+        }
+    }
+
+    Controller_Action *controller = find_controller(controllerHandle);
+    if (!controller) return;
+
+    controller->deactivate_all_layers(controller_maps, handle_count);
 }
 
 int GetActiveActionSetLayers( ControllerHandle_t controllerHandle, ControllerActionSetHandle_t *handlesOut )
 {
-    PRINT_DEBUG("Steam_Controller::GetActiveActionSetLayers\n");
-    return 0;
+    PRINT_DEBUG("Steam_Controller::GetActiveActionSetLayers %llu\n", controllerHandle);
+    Controller_Action *controller = find_controller(controllerHandle);
+    if (!controller || !handlesOut) return 0;
+
+    int count = 0;
+    for (auto layer : controller->active_layers) {
+        handlesOut[count++] = layer;
+    }
+
+    return count;
 }
 
 
@@ -540,13 +712,10 @@ ControllerDigitalActionHandle_t GetDigitalActionHandle( const char *pszActionNam
 {
     PRINT_DEBUG("Steam_Controller::GetDigitalActionHandle %s\n", pszActionName);
     if (!pszActionName) return 0;
-    std::string upper_action_name(pszActionName);
-    std::transform(upper_action_name.begin(), upper_action_name.end(), upper_action_name.begin(),[](unsigned char c){ return std::toupper(c); });
-
-    auto handle = digital_action_handles.find(upper_action_name);
+    auto handle = digital_action_handles.find(pszActionName);
     if (handle == digital_action_handles.end()) {
         //apparently GetDigitalActionHandle also works with analog handles
-        handle = analog_action_handles.find(upper_action_name);
+        handle = analog_action_handles.find(pszActionName);
         if (handle == analog_action_handles.end()) return 0;
     }
 
@@ -563,65 +732,13 @@ ControllerDigitalActionData_t GetDigitalActionData( ControllerHandle_t controlle
     digitalData.bActive = false;
     digitalData.bState = false;
 
-    auto controller = controllers.find(controllerHandle);
-    if (controller == controllers.end()) return digitalData;
+    Controller_Action *controller = find_controller(controllerHandle);
+    if (!controller) return digitalData;
 
-    std::set<int> buttons = controller->second.button_id(digitalActionHandle);
-    if (!buttons.size()) return digitalData;
+    uint32 buttons = controller->button_mask(digitalActionHandle);
+    if (!buttons) return digitalData;
     digitalData.bActive = true;
-
-    GAMEPAD_DEVICE device = (GAMEPAD_DEVICE)(controllerHandle - 1);
-
-    for (auto button : buttons) {
-        bool pressed = false;
-        if (button < BUTTON_COUNT) {
-            pressed = GamepadButtonDown(device, (GAMEPAD_BUTTON)button);
-        } else {
-            switch (button) {
-                case BUTTON_LTRIGGER:
-                    pressed = GamepadTriggerLength(device, TRIGGER_LEFT) > 0.8;
-                    break;
-                case BUTTON_RTRIGGER:
-                    pressed = GamepadTriggerLength(device, TRIGGER_RIGHT) > 0.8;
-                    break;
-                case BUTTON_STICK_LEFT_UP:
-                case BUTTON_STICK_LEFT_DOWN:
-                case BUTTON_STICK_LEFT_LEFT:
-                case BUTTON_STICK_LEFT_RIGHT: {
-                    float x = 0, y = 0, len = GamepadStickLength(device, STICK_LEFT);
-                    GamepadStickNormXY(device, STICK_LEFT, &x, &y);
-                    x *= len;
-                    y *= len;
-                    if (button == BUTTON_STICK_LEFT_UP) pressed = y > DEADZONE_BUTTON_STICK;
-                    if (button == BUTTON_STICK_LEFT_DOWN) pressed = y < -DEADZONE_BUTTON_STICK;
-                    if (button == BUTTON_STICK_LEFT_RIGHT) pressed = x > DEADZONE_BUTTON_STICK;
-                    if (button == BUTTON_STICK_LEFT_LEFT) pressed = x < -DEADZONE_BUTTON_STICK;
-                    break;
-                }
-                case BUTTON_STICK_RIGHT_UP:
-                case BUTTON_STICK_RIGHT_DOWN:
-                case BUTTON_STICK_RIGHT_LEFT:
-                case BUTTON_STICK_RIGHT_RIGHT: {
-                    float x = 0, y = 0, len = GamepadStickLength(device, STICK_RIGHT);
-                    GamepadStickNormXY(device, STICK_RIGHT, &x, &y);
-                    x *= len;
-                    y *= len;
-                    if (button == BUTTON_STICK_RIGHT_UP) pressed = y > DEADZONE_BUTTON_STICK;
-                    if (button == BUTTON_STICK_RIGHT_DOWN) pressed = y < -DEADZONE_BUTTON_STICK;
-                    if (button == BUTTON_STICK_RIGHT_RIGHT) pressed = x > DEADZONE_BUTTON_STICK;
-                    if (button == BUTTON_STICK_RIGHT_LEFT) pressed = x < -DEADZONE_BUTTON_STICK;
-                    break;
-                }
-                default:
-                    break;
-            }
-        }
-
-        if (pressed) {
-            digitalData.bState = true;
-            break;
-        }
-    }
+    digitalData.bState = (buttons_down[controllerHandle - 1] & buttons) != 0;
 
     return digitalData;
 }
@@ -644,8 +761,8 @@ int GetDigitalActionOrigins( ControllerHandle_t controllerHandle, ControllerActi
 int GetDigitalActionOrigins( InputHandle_t inputHandle, InputActionSetHandle_t actionSetHandle, InputDigitalActionHandle_t digitalActionHandle, EInputActionOrigin *originsOut )
 {
     PRINT_DEBUG("Steam_Controller::GetDigitalActionOrigins steaminput\n");
-    auto controller = controllers.find(inputHandle);
-    if (controller == controllers.end()) return 0;
+    Controller_Action *controller = find_controller(inputHandle);
+    if (!controller) return 0;
 
     auto map = controller_maps.find(actionSetHandle);
     if (map == controller_maps.end()) return 0;
@@ -759,10 +876,7 @@ ControllerAnalogActionHandle_t GetAnalogActionHandle( const char *pszActionName
 {
     PRINT_DEBUG("Steam_Controller::GetAnalogActionHandle %s\n", pszActionName);
     if (!pszActionName) return 0;
-    std::string upper_action_name(pszActionName);
-    std::transform(upper_action_name.begin(), upper_action_name.end(), upper_action_name.begin(),[](unsigned char c){ return std::toupper(c); });
-
-    auto handle = analog_action_handles.find(upper_action_name);
+    auto handle = analog_action_handles.find(pszActionName);
     if (handle == analog_action_handles.end()) return 0;
 
     return handle->second;
@@ -780,16 +894,17 @@ ControllerAnalogActionData_t GetAnalogActionData( ControllerHandle_t controllerH
     data.x = data.y = 0;
     data.bActive = false;
 
-    auto controller = controllers.find(controllerHandle);
-    if (controller == controllers.end()) return data;
+    Controller_Action *controller = find_controller(controllerHandle);
+    if (!controller) return data;
 
-    auto analog = controller->second.analog_id(analogActionHandle);
-    if (!analog.first.size()) return data;
+    const Controller_Analog_Binding *analog = controller->analog_binding(analogActionHandle);
+    if (!analog) return data;
 
     data.bActive = true;
-    data.eMode = analog.second;
+    data.eMode = analog->mode;
 
-    for (auto a : analog.first) {
+    for (unsigned i = 0; i < analog->count; ++i) {
+        int a = analog->sources[i];
         if (a >= JOY_ID_START) {
             int joystick_id = a - JOY_ID_START;
             if (joystick_id == STICK_DPAD) {
@@ -838,8 +953,8 @@ int GetAnalogActionOrigins( ControllerHandle_t controllerHandle, ControllerActio
 int GetAnalogActionOrigins( InputHandle_t inputHandle, InputActionSetHandle_t actionSetHandle, InputAnalogActionHandle_t analogActionHandle, EInputActionOrigin *originsOut )
 {
     PRINT_DEBUG("Steam_Controller::GetAnalogActionOrigins steaminput\n");
-    auto controller = controllers.find(inputHandle);
-    if (controller == controllers.end()) return 0;
+    Controller_Action *controller = find_controller(inputHandle);
+    if (!controller) return 0;
 
     auto map = controller_maps.find(actionSetHandle);
     if (map == controller_maps.end()) return 0;
@@ -929,8 +1044,8 @@ void TriggerSimpleHapticEvent( InputHandle_t inputHandle, EControllerHapticLocat
 void TriggerVibration( ControllerHandle_t controllerHandle, unsigned short usLeftSpeed, unsigned short usRightSpeed )
 {
     PRINT_DEBUG("Steam_Controller::TriggerVibration %hu %hu\n", usLeftSpeed, usRightSpeed);
-    auto controller = controllers.find(controllerHandle);
-    if (controller == controllers.end()) return;
+    Controller_Action *controller = find_controller(controllerHandle);
+    if (!controller) return;
 
     unsigned int rumble_length_ms = 0;
 #if defined(__linux__)
@@ -968,8 +1083,8 @@ void SetLEDColor( ControllerHandle_t controllerHandle, uint8 nColorR, uint8 nCol
 int GetGamepadIndexForController( ControllerHandle_t ulControllerHandle )
 {
     PRINT_DEBUG("Steam_Controller::GetGamepadIndexForController\n");
-    auto controller = controllers.find(ulControllerHandle);
-    if (controller == controllers.end()) return -1;
+    Controller_Action *controller = find_controller(ulControllerHandle);
+    if (!controller) return -1;
 
     return ulControllerHandle - 1;
 }
@@ -980,8 +1095,8 @@ ControllerHandle_t GetControllerForGamepadIndex( int nIndex )
 {
     PRINT_DEBUG("Steam_Controller::GetControllerForGamepadIndex %i\n", nIndex);
     ControllerHandle_t out = nIndex + 1;
-    auto controller = controllers.find(out);
-    if (controller == controllers.end()) return 0;
+    Controller_Action *controller = find_controller(out);
+    if (!controller) return 0;
     return out;
 }
 
@@ -1143,8 +1258,8 @@ const char *GetGlyphForActionOrigin_Legacy( EInputActionOrigin eOrigin )
 ESteamInputType GetInputTypeForHandle( ControllerHandle_t controllerHandle )
 {
     PRINT_DEBUG("Steam_Controller::GetInputTypeForHandle %llu\n", controllerHandle);
-    auto controller = controllers.find(controllerHandle);
-    if (controller == controllers.end()) return k_ESteamInputType_Unknown;
+    Controller_Action *controller = find_controller(controllerHandle);
+    if (!controller) return k_ESteamInputType_Unknown;
     return k_ESteamInputType_XBox360Controller;
 }
 
@@ -20,8 +20,11 @@
 
 #include "base.h"
 #include "overlay/steam_overlay.h"
+#include "sha/sha1.hpp"
 
 #define SEND_FRIEND_RATE 4.0
+#define AVATAR_REQUEST_TIMEOUT 10.0
+#define AVATAR_SIZE_LARGE 184
 
 struct Avatar_Numbers {
     int smallest;
@@ -29,6 +32,25 @@ struct Avatar_Numbers {
     int large;
 };
 
+struct Avatar_Images {
+    std::string small, medium, large;
+};
+
+// avatar a friend told us about, identified by the sha1 of the large RGBA image
+struct Friend_Avatar {
+    std::string hash;
+    bool waiting = false; //requested from the friend, waiting for the png
+    bool loading = false; //being decoded by a worker
+    std::chrono::high_resolution_clock::time_point requested;
+};
+
+struct Avatar_Load_Result {
+    uint64 steam_id;
+    std::string hash;
+    bool success;
+    struct Avatar_Images images;
+};
+
 class Steam_Friends : 
 public ISteamFriends003,
 public ISteamFriends004,
@@ -55,9 +77,14 @@ public ISteamFriends
 
     Friend us;
     bool modified;
+    Message_Arena message_arena;
     std::vector<Friend> friends;
 
     std::map<uint64, struct Avatar_Numbers> avatars;
+    std::map<uint64, struct Friend_Avatar> friend_avatars;
+    std::vector<std::future<struct Avatar_Load_Result>> avatar_loads;
+    std::optional<struct Avatar_Images> default_avatar;
+    std::string avatar_hash, avatar_png;
     CSteamID lobby_id;
 
     std::chrono::high_resolution_clock::time_point last_sent_friends;
@@ -94,6 +121,162 @@ bool isAppIdCompatible(Friend *f)
     return settings->get_local_game_id().AppID() == f->appid();
 }
 
+std::string find_avatar_file(std::string base_name)
+{
+    static const char *extensions[] = {".png", ".jpg", ".jpeg"};
+    for (auto ext : extensions) {
+        std::string file_path = Local_Storage::get_game_settings_path() + base_name + ext;
+        if (file_size_(file_path)) return file_path;
+    }
+
+    for (auto ext : extensions) {
+        std::string file_path;
+        if (settings->local_save.length() > 0) {
+            file_path = settings->local_save + "/settings/" + base_name + ext;
+        } else {
+            file_path = Local_Storage::get_user_appdata_path() + "/settings/" + base_name + ext;
+        }
+
+        if (file_size_(file_path)) return file_path;
+    }
+
+    return "";
+}
+
+std::string get_avatar_cache_path()
+{
+    std::string path = settings->local_save.length() > 0 ? settings->local_save : Local_Storage::get_user_appdata_path();
+    return path + "/" + Local_Storage::avatar_cache_folder + "/";
+}
+
+static std::string get_avatar_hash(std::string const& large)
+{
+    SHA1 checksum;
+    checksum.update(large);
+    return checksum.final();
+}
+
+static struct Avatar_Images make_avatar_images(std::string large, int width, int height)
+{
+    struct Avatar_Images images;
+    images.large = Local_Storage::resize_image(large, width, height, AVATAR_SIZE_LARGE);
+    images.medium = Local_Storage::resize_image(images.large, AVATAR_SIZE_LARGE, AVATAR_SIZE_LARGE, 64);
+    images.small = Local_Storage::resize_image(images.large, AVATAR_SIZE_LARGE, AVATAR_SIZE_LARGE, 32);
+    return images;
+}
+
+// decodes the image once and makes the 3 sizes out of it
+static bool load_avatar_images(std::string const& file_path, struct Avatar_Images &images)
+{
+    if (file_path.empty()) return false;
+
+    int width, height;
+    std::string image = Local_Storage::load_image_data(file_path, "", &width, &height);
+    if (image.empty()) return false;
+
+    images = make_avatar_images(std::move(image), width, height);
+    return true;
+}
+
+static bool read_avatar_cache_file(std::string const& file_path, std::string &data, size_t expected_size = 0)
+{
+    size_t size = file_size_(file_path);
+    if (!size || (expected_size && size != expected_size)) return false;
+
+    data.resize(size);
+    int read = Local_Storage::get_file_data(file_path, &data[0], (unsigned int)size);
+    return read > 0 && (size_t)read == size;
+}
+
+// runs on a worker thread, uses the resized images cached on disk or decodes them from the png/raw image
+static struct Avatar_Load_Result load_friend_avatar(uint64 steam_id, std::string hash, std::string png, std::string raw, std::string cache_path)
+{
+    struct Avatar_Load_Result result;
+    result.steam_id = steam_id;
+    result.hash = hash;
+    result.success = false;
+
+    if (read_avatar_cache_file(cache_path + hash + "_184.rgba", result.images.large, AVATAR_SIZE_LARGE * AVATAR_SIZE_LARGE * 4) &&
+        read_avatar_cache_file(cache_path + hash + "_64.rgba", result.images.medium, 64 * 64 * 4) &&
+        read_avatar_cache_file(cache_path + hash + "_32.rgba", result.images.small, 32 * 32 * 4)) {
+        result.success = true;
+        return result;
+    }
+
+    std::string large;
+    int width = AVATAR_SIZE_LARGE, height = AVATAR_SIZE_LARGE;
+    if (raw.size() == AVATAR_SIZE_LARGE * AVATAR_SIZE_LARGE * 4) {
+        large = std::move(raw);
+    } else {
+        if (png.empty()) read_avatar_cache_file(cache_path + hash + ".png", png);
+        if (png.size()) large = Local_Storage::load_image_data("", png, &width, &height);
+    }
+
+    if (large.empty() || width != AVATAR_SIZE_LARGE || height != AVATAR_SIZE_LARGE || get_avatar_hash(large) != hash) {
+        PRINT_DEBUG("Steam_Friends::load_friend_avatar bad avatar " "%" PRIu64 " %s\n", steam_id, hash.c_str());
+        return result;
+    }
+
+    result.images = make_avatar_images(std::move(large), width, height);
+    result.success = true;
+
+    if (png.size()) Local_Storage::store_file_data(cache_path, hash + ".png", &png[0], png.size());
+    Local_Storage::store_file_data(cache_path, hash + "_184.rgba", &result.images.large[0], result.images.large.size());
+    Local_Storage::store_file_data(cache_path, hash + "_64.rgba", &result.images.medium[0], result.images.medium.size());
+    Local_Storage::store_file_data(cache_path, hash + "_32.rgba", &result.images.small[0], result.images.small.size());
+    return result;
+}
+
+struct Avatar_Images get_default_avatar()
+{
+    if (!default_avatar.has_value()) {
+        struct Avatar_Images images;
+        if (!load_avatar_images(find_avatar_file("account_avatar_default"), images)) {
+            images.small = std::string(32 * 32 * 4, 0);
+            images.medium = std::string(64 * 64 * 4, 0);
+            images.large = std::string(AVATAR_SIZE_LARGE * AVATAR_SIZE_LARGE * 4, 0);
+        }
+
+        default_avatar = images;
+    }
+
+    return default_avatar.value();
+}
+
+// replaces the avatar images of a user, the handles only change if the image changed
+void set_avatar_images(uint64 steam_id, struct Avatar_Images const& images, bool notify)
+{
+    struct Avatar_Numbers avatar_numbers;
+    avatar_numbers.smallest = settings->add_image(images.small, 32, 32);
+    avatar_numbers.medium = settings->add_image(images.medium, 64, 64);
+    avatar_numbers.large = settings->add_image(images.large, AVATAR_SIZE_LARGE, AVATAR_SIZE_LARGE);
+
+    auto old = avatars.find(steam_id);
+    bool changed = true;
+    if (old != avatars.end()) {
+        changed = old->second.smallest != avatar_numbers.smallest || old->second.medium != avatar_numbers.medium || old->second.large != avatar_numbers.large;
+        settings->remove_image(old->second.smallest);
+        settings->remove_image(old->second.medium);
+        settings->remove_image(old->second.large);
+    }
+
+    avatars[steam_id] = avatar_numbers;
+    if (!notify || !changed) return;
+
+    int sizes[] = {32, 64, AVATAR_SIZE_LARGE};
+    int numbers[] = {avatar_numbers.smallest, avatar_numbers.medium, avatar_numbers.large};
+    for (int i = 0; i < 3; ++i) {
+        AvatarImageLoaded_t data;
+        data.m_steamID = (uint64)steam_id;
+        data.m_iImage = numbers[i];
+        data.m_iWide = sizes[i];
+        data.m_iTall = sizes[i];
+        callbacks->addCBResult(data.k_iCallback, &data, sizeof(data));
+    }
+
+    persona_change((uint64)steam_id, k_EPersonaChangeAvatar);
+}
+
 struct Avatar_Numbers add_friend_avatars(CSteamID id)
 {
     uint64 steam_id = id.ConvertToUint64();
@@ -102,101 +285,93 @@ struct Avatar_Numbers add_friend_avatars(CSteamID id)
         return avatar_ids->second;
     }
 
-    struct Avatar_Numbers avatar_numbers;
-    std::string small_avatar(32 * 32 * 4, 0);
-    std::string medium_avatar(64 * 64 * 4, 0);
-    std::string large_avatar(184 * 184 * 4, 0);
+    struct Avatar_Images images;
+    images.small = std::string(32 * 32 * 4, 0);
+    images.medium = std::string(64 * 64 * 4, 0);
+    images.large = std::string(AVATAR_SIZE_LARGE * AVATAR_SIZE_LARGE * 4, 0);
 
     if (!(settings->disable_account_avatar) && (id == settings->get_local_steam_id())) {
-        std::string file_path;
-        unsigned long long file_size;
-
-        for (int i = 0; i < 3; i++) {
-            std::string file_name;
-            if (i == 0) file_name = "account_avatar.png";
-            if (i == 1) file_name = "account_avatar.jpg";
-            if (i == 2) file_name = "account_avatar.jpeg";
-            file_path = Local_Storage::get_game_settings_path() + file_name;
-            file_size = file_size_(file_path);
-            if (file_size) break;
+        // no else statement here for default or else this breaks default images for friends
+        if (load_avatar_images(find_avatar_file("account_avatar"), images)) {
+            avatar_hash = get_avatar_hash(images.large);
+            us.set_avatar_hash(avatar_hash);
         }
+    } else if (!(settings->disable_account_avatar)) {
+        //the friend's own avatar replaces this one once it's loaded
+        images = get_default_avatar();
+    }
 
-        if (!file_size) {
-            for (int i = 0; i < 3; i++) {
-                std::string file_name;
-                if (i == 0) file_name = "account_avatar.png";
-                if (i == 1) file_name = "account_avatar.jpg";
-                if (i == 2) file_name = "account_avatar.jpeg";
-
-                if (settings->local_save.length() > 0) {
-                    file_path = settings->local_save + "/settings/" + file_name;
-                } else {
-                    file_path = Local_Storage::get_user_appdata_path() + "/settings/" + file_name;
-                }
+    set_avatar_images(steam_id, images, false);
+    return avatars[steam_id];
+}
 
-                file_size = file_size_(file_path);
-                if (file_size) break;
-            }
-        }
+// called when a friend tells us which avatar it has, fetches it from the disk cache or asks the friend for it
+void check_friend_avatar(Friend const& f)
+{
+    if (settings->disable_account_avatar) return;
 
-        // no else statement here for default or else this breaks default images for friends
-        if (file_size) {
-            small_avatar = Local_Storage::load_image_resized(file_path, "", 32);
-            medium_avatar = Local_Storage::load_image_resized(file_path, "", 64);
-            large_avatar = Local_Storage::load_image_resized(file_path, "", 184);
-        }
-    } else if (!(settings->disable_account_avatar)) {
-        Friend *f = find_friend(id);
-        if (f && (large_avatar.compare(f->avatar()) != 0)) {
-            large_avatar = f->avatar();
-            medium_avatar = Local_Storage::load_image_resized("", f->avatar(), 64);
-            small_avatar = Local_Storage::load_image_resized("", f->avatar(), 32);
-        } else {
-            std::string file_path;
-            unsigned long long file_size;
-
-            for (int i = 0; i < 3; i++) {
-                std::string file_name;
-                if (i == 0) file_name = "account_avatar_default.png";
-                if (i == 1) file_name = "account_avatar_default.jpg";
-                if (i == 2) file_name = "account_avatar_default.jpeg";
-                file_path = Local_Storage::get_game_settings_path() + file_name;
-                file_size = file_size_(file_path);
-                if (file_size) break;
-            }
+    std::string hash = f.avatar_hash();
+    std::string raw;
+    if (hash.empty()) {
+        //older versions send the raw image instead
+        if (f.avatar().size() != AVATAR_SIZE_LARGE * AVATAR_SIZE_LARGE * 4) return;
+        raw = f.avatar();
+        hash = get_avatar_hash(raw);
+    }
 
-            if (!file_size) {
-                for (int i = 0; i < 3; i++) {
-                    std::string file_name;
-                    if (i == 0) file_name = "account_avatar_default.png";
-                    if (i == 1) file_name = "account_avatar_default.jpg";
-                    if (i == 2) file_name = "account_avatar_default.jpeg";
-
-                    if (settings->local_save.length() > 0) {
-                        file_path = settings->local_save + "/settings/" + file_name;
-                    } else {
-                        file_path = Local_Storage::get_user_appdata_path() + "/settings/" + file_name;
-                    }
-
-                    file_size = file_size_(file_path);
-                    if (file_size) break;
-                }
-            }
+    struct Friend_Avatar &avatar = friend_avatars[f.id()];
+    if (avatar.hash == hash) return;
 
-            if (file_size) {
-                small_avatar = Local_Storage::load_image_resized(file_path, "", 32);
-                medium_avatar = Local_Storage::load_image_resized(file_path, "", 64);
-                large_avatar = Local_Storage::load_image_resized(file_path, "", 184);
-            }
+    avatar.hash = hash;
+    avatar.waiting = false;
+    std::string cache_path = get_avatar_cache_path();
+    if (raw.size() || file_size_(cache_path + hash + "_184.rgba") || file_size_(cache_path + hash + ".png")) {
+        avatar.loading = true;
+        avatar_loads.push_back(std::async(std::launch::async, load_friend_avatar, (uint64)f.id(), hash, std::string(), std::move(raw), cache_path));
+    } else {
+        send_avatar_request(f.id(), avatar);
+    }
+}
+
+void send_avatar_request(uint64 steam_id, struct Friend_Avatar &avatar)
+{
+    PRINT_DEBUG("Steam_Friends::send_avatar_request " "%" PRIu64 " %s\n", steam_id, avatar.hash.c_str());
+    Common_Message msg;
+    Friend_Messages *friend_messages = new Friend_Messages();
+    friend_messages->set_type(Friend_Messages::AVATAR_REQUEST);
+    friend_messages->set_avatar_hash(avatar.hash);
+    msg.set_allocated_friend_messages(friend_messages);
+    msg.set_source_id(settings->get_local_steam_id().ConvertToUint64());
+    msg.set_dest_id(steam_id);
+    network->sendTo(&msg, true);
+    avatar.waiting = true;
+    avatar.requested = std::chrono::high_resolution_clock::now();
+}
+
+void run_avatar_loads()
+{
+    for (auto &a : friend_avatars) {
+        if (a.second.waiting && check_timedout(a.second.requested, AVATAR_REQUEST_TIMEOUT) && find_friend((uint64)a.first)) {
+            send_avatar_request(a.first, a.second);
         }
     }
 
-    avatar_numbers.smallest = settings->add_image(small_avatar, 32, 32);
-    avatar_numbers.medium = settings->add_image(medium_avatar, 64, 64);
-    avatar_numbers.large = settings->add_image(large_avatar, 184, 184);
+    auto l = std::begin(avatar_loads);
+    while (l != std::end(avatar_loads)) {
+        if (l->wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ++l;
+            continue;
+        }
 
-    avatars[steam_id] = avatar_numbers;
-    return avatar_numbers;
+        struct Avatar_Load_Result result = l->get();
+        l = avatar_loads.erase(l);
+
+        auto avatar = friend_avatars.find(result.steam_id);
+        if (avatar == friend_avatars.end() || avatar->second.hash != result.hash) continue;
+
+        avatar->second.loading = false;
+        if (result.success) set_avatar_images(result.steam_id, result.images, true);
+    }
 }
 
 public:
@@ -1158,16 +1333,21 @@ void RunCallbacks()
         resend_friend_data();
     }
 
+    run_avatar_loads();
+
     if (modified) {
-        Common_Message msg;
-        msg.set_source_id(settings->get_local_steam_id().ConvertToUint64());
-        Friend *f = new Friend(us);
+        add_friend_avatars(settings->get_local_steam_id());
+        Message_Arena::Scope scope(message_arena);
+        Common_Message *msg = scope.create<Common_Message>();
+        msg->set_source_id(settings->get_local_steam_id().ConvertToUint64());
+        Friend *f = scope.create<Friend>();
+        f->CopyFrom(us);
         f->set_id(settings->get_local_steam_id().ConvertToUint64());
         f->set_name(settings->get_local_name());
         f->set_appid(settings->get_local_game_id().AppID());
         f->set_lobby_id(settings->get_lobby().ConvertToUint64());
-        msg.set_allocated_friend_(f);
-        network->sendToAllIndividuals(&msg, true);
+        msg->set_allocated_friend_(f);
+        network->sendToAllIndividuals(msg, true);
         modified = false;
         last_sent_friends = std::chrono::high_resolution_clock::now();
     }
@@ -1189,19 +1369,20 @@ void Callback(Common_Message *msg)
 
         if (msg->low_level().type() == Low_Level::CONNECT) {
             PRINT_DEBUG("Steam_Friends Connect\n");
-            Common_Message msg_;
-            msg_.set_source_id(settings->get_local_steam_id().ConvertToUint64());
-            msg_.set_dest_id(msg->source_id());
-            Friend *f = new Friend(us);
+            Message_Arena::Scope scope(message_arena);
+            Common_Message *msg_ = scope.create<Common_Message>();
+            msg_->set_source_id(settings->get_local_steam_id().ConvertToUint64());
+            msg_->set_dest_id(msg->source_id());
+            //only the hash of the avatar is sent, the friend requests the image if it doesn't have it cached
+            add_friend_avatars(settings->get_local_steam_id());
+            Friend *f = scope.create<Friend>();
+            f->CopyFrom(us);
             f->set_id(settings->get_local_steam_id().ConvertToUint64());
             f->set_name(settings->get_local_name());
             f->set_appid(settings->get_local_game_id().AppID());
             f->set_lobby_id(settings->get_lobby().ConvertToUint64());
-            int avatar_number = GetLargeFriendAvatar(settings->get_local_steam_id());
-            if (settings->images[avatar_number].data.length() > 0) f->set_avatar(settings->images[avatar_number].data);
-            else f->set_avatar("");
-            msg_.set_allocated_friend_(f);
-            network->sendTo(&msg_, true);
+            msg_->set_allocated_friend_(f);
+            network->sendTo(msg_, true);
         }
     }
 
@@ -1211,9 +1392,11 @@ void Callback(Common_Message *msg)
         if (!f) {
             if (msg->friend_().id() != settings->get_local_steam_id().ConvertToUint64()) {
                 friends.push_back(msg->friend_());
+                friends.back().clear_avatar();
                 overlay->FriendConnect(msg->friend_());
                 persona_change((uint64)msg->friend_().id(), k_EPersonaChangeName);
-                GetLargeFriendAvatar((uint64)msg->friend_().id());
+                add_friend_avatars((uint64)msg->friend_().id());
+                check_friend_avatar(msg->friend_());
             }
         } else {
             std::map<std::string, std::string> map1(f->rich_presence().begin(), f->rich_presence().end());
@@ -1227,6 +1410,8 @@ void Callback(Common_Message *msg)
             }
             //TODO: callbacks?
             *f = msg->friend_();
+            check_friend_avatar(*f);
+            f->clear_avatar();
         }
     }
 
@@ -1274,6 +1459,36 @@ void Callback(Common_Message *msg)
                 callbacks->addCBResult(data.k_iCallback, &data, sizeof(data));
             }
         }
+
+        if (msg->friend_messages().type() == Friend_Messages::AVATAR_REQUEST) {
+            PRINT_DEBUG("Steam_Friends Got Avatar Request %s\n", msg->friend_messages().avatar_hash().c_str());
+            if (avatar_hash.size() && msg->friend_messages().avatar_hash() == avatar_hash) {
+                if (avatar_png.empty()) {
+                    struct Avatar_Numbers numbers = add_friend_avatars(settings->get_local_steam_id());
+                    avatar_png = Local_Storage::encode_image_png(settings->images[numbers.large].data, AVATAR_SIZE_LARGE, AVATAR_SIZE_LARGE);
+                }
+
+                Common_Message msg_;
+                Friend_Messages *friend_messages = new Friend_Messages();
+                friend_messages->set_type(Friend_Messages::AVATAR);
+                friend_messages->set_avatar_hash(avatar_hash);
+                friend_messages->set_avatar(avatar_png);
+                msg_.set_allocated_friend_messages(friend_messages);
+                msg_.set_source_id(settings->get_local_steam_id().ConvertToUint64());
+                msg_.set_dest_id(msg->source_id());
+                network->sendTo(&msg_, true);
+            }
+        }
+
+        if (msg->friend_messages().type() == Friend_Messages::AVATAR) {
+            PRINT_DEBUG("Steam_Friends Got Avatar %s %zu\n", msg->friend_messages().avatar_hash().c_str(), msg->friend_messages().avatar().size());
+            auto avatar = friend_avatars.find(msg->source_id());
+            if (avatar != friend_avatars.end() && avatar->second.waiting && avatar->second.hash == msg->friend_messages().avatar_hash() && msg->friend_messages().avatar().size()) {
+                avatar->second.waiting = false;
+                avatar->second.loading = true;
+                avatar_loads.push_back(std::async(std::launch::async, load_friend_avatar, (uint64)msg->source_id(), avatar->second.hash, msg->friend_messages().avatar(), std::string(), get_avatar_cache_path()));
+            }
+        }
     }
 }
 
@@ -17,14 +17,18 @@
 
 #include "base.h"
 #include "common_includes.h"
-#include <curl/curl.h>
+#include "http_cache.h"
 
 
 struct Steam_Http_Request {
 	HTTPRequestHandle handle;
 	uint64 context_value;
 
-	std::string response;
+	// shared with the cache and the other requests for the same url, nullptr if there's no response
+	std::shared_ptr<const std::string> response;
+	Http_Cache::Headers headers;
+
+	uint32 response_size() const { return response ? (uint32)response->size() : 0; }
 };
 
 class Steam_HTTP :
@@ -16,6 +16,7 @@
    <http://www.gnu.org/licenses/>.  */
 
 #include "base.h" // For SteamItemDef_t
+#include "inventory_store.h"
 
 struct Steam_Inventory_Requests {
     double timeout = 0.1;
@@ -44,6 +45,8 @@ class Steam_Inventory :
 public:
     static constexpr auto items_user_file = "items.json";
     static constexpr auto items_default_file = "default_items.json";
+    // consumed items are written to disk once the inventory has been unchanged for this long
+    static constexpr double items_save_delay = 1.0;
 
 private:
     class Settings *settings;
@@ -54,8 +57,10 @@ private:
 
     std::vector<struct Steam_Inventory_Requests> inventory_requests;
 
-    nlohmann::json defined_items;
-    nlohmann::json user_items;
+    Inventory_Store store{};
+    bool items_changed = false;
+    std::chrono::steady_clock::time_point items_changed_time{};
+    std::future<bool> items_save{};
 
     bool inventory_loaded;
     bool call_definition_update;
@@ -93,11 +98,14 @@ void read_items_db()
 {
     std::string items_db_path = Local_Storage::get_game_settings_path() + items_user_file;
     PRINT_DEBUG("Steam_Inventory::Items file path: %s\n", items_db_path.c_str());
+    nlohmann::json defined_items = nlohmann::json::object();
     local_storage->load_json(items_db_path, defined_items);
+    store.load_definitions(defined_items);
 }
 
 void read_inventory_db()
 {
+    nlohmann::json user_items = nlohmann::json::object();
     // If we havn't got any inventory
     if (!local_storage->load_json_file("", items_user_file, user_items))
     {
@@ -106,6 +114,20 @@ void read_inventory_db()
         PRINT_DEBUG("Steam_Inventory::Default items file path: %s\n", items_db_path.c_str());
         local_storage->load_json(items_db_path, user_items);
     }
+
+    store.load_items(user_items);
+}
+
+void save_inventory_db()
+{
+    // a copy of the items so the json is built and written without the lock
+    std::vector<SteamItemDetails_t> items = store.get_items();
+    Local_Storage *storage = local_storage;
+    items_save = std::async(std::launch::async, [storage, items]() {
+        return storage->write_json_file("", items_user_file, Inventory_Store::items_to_json(items));
+    });
+
+    items_changed = false;
 }
 
 public:
@@ -124,8 +146,6 @@ Steam_Inventory(class Settings *settings, class SteamCallResults *callback_resul
     callbacks(callbacks),
     run_every_runcb(run_every_runcb),
     local_storage(local_storage),
-    defined_items(nlohmann::json::object()),
-    user_items(nlohmann::json::object()),
     inventory_loaded(false),
     call_definition_update(false),
     item_definitions_loaded(false)
@@ -136,6 +156,12 @@ Steam_Inventory(class Settings *settings, class SteamCallResults *callback_resul
 ~Steam_Inventory()
 {
     this->run_every_runcb->remove(&Steam_Inventory::run_every_runcb_cb, this);
+
+    if (items_save.valid()) items_save.wait();
+    if (items_changed) {
+        save_inventory_db();
+        items_save.wait();
+    }
 }
 
 // INVENTORY ASYNC RESULT MANAGEMENT
@@ -186,38 +212,16 @@ bool GetResultItems( SteamInventoryResult_t resultHandle,
 
         if (request->full_query) {
             // We end if we reached the end of items or the end of buffer
-            for( auto i = user_items.begin(); i != user_items.end() && max_items; ++i, --max_items )
-            {
-                pOutItemsArray->m_iDefinition = std::stoi(i.key());
-                pOutItemsArray->m_itemId = pOutItemsArray->m_iDefinition;
-                try
-                {
-                    pOutItemsArray->m_unQuantity = i.value().get<int>();
-                }
-                catch (...)
-                {
-                    pOutItemsArray->m_unQuantity = 0;
-                }
-                pOutItemsArray->m_unFlags = k_ESteamItemNoTrade;
-                ++pOutItemsArray;
-            }
+            const std::vector<SteamItemDetails_t> &items = store.get_items();
+            uint32 count = std::min(max_items, static_cast<uint32>(items.size()));
+            if (count) std::copy(items.begin(), items.begin() + count, pOutItemsArray);
+            pOutItemsArray += count;
         } else {
             for (auto &itemid : request->instance_ids) {
                 if (!max_items) break;
-                auto it = user_items.find(std::to_string(itemid));
-                if (it != user_items.end()) {
-                    pOutItemsArray->m_iDefinition = itemid;
-                    pOutItemsArray->m_itemId = itemid;
-
-                    try
-                    {
-                        pOutItemsArray->m_unQuantity = it->get<int>();
-                    }
-                    catch (...)
-                    {
-                        pOutItemsArray->m_unQuantity = 0;
-                    }
-                    pOutItemsArray->m_unFlags = k_ESteamItemNoTrade;
+                const SteamItemDetails_t *item = store.find_item(itemid);
+                if (item) {
+                    *pOutItemsArray = *item;
                     ++pOutItemsArray;
                     --max_items;
                 }
@@ -229,9 +233,9 @@ bool GetResultItems( SteamInventoryResult_t resultHandle,
     else if (punOutItemsArraySize != nullptr)
     {
         if (request->full_query) {
-            *punOutItemsArraySize = user_items.size();
+            *punOutItemsArraySize = store.get_items().size();
         } else {
-            *punOutItemsArraySize = std::count_if(request->instance_ids.begin(), request->instance_ids.end(), [this](SteamItemInstanceID_t item_id){ return user_items.find(std::to_string(item_id)) != user_items.end();});
+            *punOutItemsArraySize = std::count_if(request->instance_ids.begin(), request->instance_ids.end(), [this](SteamItemInstanceID_t item_id){ return store.find_item(item_id) != nullptr;});
         }
     }
 
@@ -499,26 +503,13 @@ bool ConsumeItem( SteamInventoryResult_t *pResultHandle, SteamItemInstanceID_t i
     PRINT_DEBUG("Steam_Inventory::ConsumeItem %llu %u\n", itemConsume, unQuantity);
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
 
-    auto it = user_items.find(std::to_string(itemConsume));
-    if (it != user_items.end()) {
-        try
-        {
-            uint32 current = it->get<int>();
-            PRINT_DEBUG("Steam_Inventory::ConsumeItem previous %u\n", current);
-            if (current < unQuantity) unQuantity = current;
-            uint32 result = current - unQuantity;
-            if (result == 0) {
-                user_items.erase(it);
-            } else {
-                *it = result;
-            }
-        }
-        catch (...) {}
-
-    } else {
+    if (!store.consume_item(itemConsume, unQuantity)) {
         return false;
     }
 
+    items_changed = true;
+    items_changed_time = std::chrono::steady_clock::now();
+
     struct Steam_Inventory_Requests* request = new_inventory_result(false, &itemConsume, 1);
 
     if (pResultHandle != nullptr)
@@ -655,15 +646,15 @@ bool GetItemDefinitionIDs(
 
     if (pItemDefIDs == nullptr || *punItemDefIDsArraySize == 0)
     {
-        *punItemDefIDsArraySize = defined_items.size();
+        *punItemDefIDsArraySize = store.get_definitions().size();
         return true;
     }
 
-    if (*punItemDefIDsArraySize < defined_items.size())
+    if (*punItemDefIDsArraySize < store.get_definitions().size())
         return false;
 
-    for (auto i = defined_items.begin(); i != defined_items.end(); ++i)
-        *pItemDefIDs++ = std::stoi(i.key());
+    for (auto &definition : store.get_definitions())
+        *pItemDefIDs++ = definition.id;
 
     return true;
 }
@@ -683,46 +674,37 @@ bool GetItemDefinitionProperty( SteamItemDef_t iDefinition, const char *pchPrope
 {
     PRINT_DEBUG("Steam_Inventory::GetItemDefinitionProperty %i %s\n", iDefinition, pchPropertyName);
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
+    if (!punValueBufferSizeOut) return false;
 
-    auto item = defined_items.find(std::to_string(iDefinition));
-    if (item != defined_items.end())
+    const Inventory_Store::Definition *item = store.find_definition(iDefinition);
+    if (item)
     {
         if (pchPropertyName != nullptr)
         {
-            // Should I check for punValueBufferSizeOut == nullptr ?
             // Try to get the property
-            auto attr = item.value().find(pchPropertyName);
-            if (attr != item.value().end())
+            const Inventory_Store::Property *attr = Inventory_Store::find_property(*item, pchPropertyName);
+            if (attr)
             {
-                std::string val;
-                try
+                if (!attr->is_string)
                 {
-                    val = attr.value().get<std::string>();
-                }
-                catch (...)
-                {
-                    pchPropertyName = "";
                     *punValueBufferSizeOut = 0;
-                    PRINT_DEBUG("  Error, item: %d, attr: %s is not a string!", iDefinition, pchPropertyName);
+                    PRINT_DEBUG("  Error, item: %d, attr: %s is not a string!\n", iDefinition, pchPropertyName);
                     return true;
                 }
-                if (pchValueBuffer != nullptr)
+
+                const std::string &val = attr->value;
+                if (pchValueBuffer != nullptr && *punValueBufferSizeOut)
                 {
-                    // copy what we can
-                    strncpy(pchValueBuffer, val.c_str(), *punValueBufferSizeOut);
+                    // copy what we can, and make sure we have a null terminator
                     *punValueBufferSizeOut = std::min(static_cast<uint32>(val.length() + 1), *punValueBufferSizeOut);
+                    memcpy(pchValueBuffer, val.c_str(), *punValueBufferSizeOut - 1);
+                    pchValueBuffer[*punValueBufferSizeOut-1] = '\0';
                 }
                 else
                 {
                     // Set punValueBufferSizeOut to the property size
                     *punValueBufferSizeOut = val.length() + 1;
                 }
-
-                if (pchValueBuffer != nullptr)
-                {
-                    // Make sure we have a null terminator
-                    pchValueBuffer[*punValueBufferSizeOut-1] = '\0';
-                }
             }
             // Property not found
             else
@@ -734,35 +716,24 @@ bool GetItemDefinitionProperty( SteamItemDef_t iDefinition, const char *pchPrope
         }
         else // Pass a NULL pointer for pchPropertyName to get a comma - separated list of available property names.
         {
-            // If pchValueBuffer is NULL, *punValueBufferSize will contain the suggested buffer size
-            if (pchValueBuffer == nullptr)
+            const std::string &names = item->property_names;
+            if (item->properties.empty())
             {
-                // Should I check for punValueBufferSizeOut == nullptr ?
+                if (pchValueBuffer != nullptr && *punValueBufferSizeOut) pchValueBuffer[0] = '\0';
                 *punValueBufferSizeOut = 0;
-                for (auto i = item.value().begin(); i != item.value().end(); ++i)
-                    *punValueBufferSizeOut += i.key().length() + 1; // Size of key + comma, and the last is not a comma but null char
+            }
+            // If pchValueBuffer is NULL, *punValueBufferSize will contain the suggested buffer size
+            else if (pchValueBuffer == nullptr || *punValueBufferSizeOut == 0)
+            {
+                *punValueBufferSizeOut = names.length() + 1;
             }
             else
             {
-                // strncat always add the null terminator, so remove 1 to the string length
-                uint32_t len = *punValueBufferSizeOut-1;
-                *punValueBufferSizeOut = 0;
-                memset(pchValueBuffer, 0, len);
-                for( auto i = item.value().begin(); i != item.value().end() && len > 0; ++i )
-                {
-                    strncat(pchValueBuffer, i.key().c_str(), len);
-                    // Count how many chars we copied
-                    // Either the string length or the buffer size if its too small
-                    uint32 x = std::min(len, static_cast<uint32>(i.key().length()));
-                    *punValueBufferSizeOut += x;
-                    len -= x;
-
-                    if (len && std::distance(i, item.value().end()) != 1) // If this is not the last item, add a comma
-                        strncat(pchValueBuffer, ",", len--);
-
-                    // Always add 1, its a comma or the null terminator
-                    ++*punValueBufferSizeOut;
-                }
+                // copy what we can, the last char is always the null terminator
+                uint32 len = std::min(*punValueBufferSizeOut - 1, static_cast<uint32>(names.length()));
+                memcpy(pchValueBuffer, names.c_str(), len);
+                pchValueBuffer[len] = '\0';
+                *punValueBufferSizeOut = len + 1;
             }
         }
 
@@ -961,6 +932,14 @@ void RunCallbacks()
             }
         }
     }
+
+    if (items_changed && (!items_save.valid() || items_save.wait_for(std::chrono::seconds(0)) == std::future_status::ready)) {
+        // consuming several items in a row only writes the file once
+        if (std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - items_changed_time).count() > items_save_delay) {
+            if (items_save.valid() && !items_save.get()) PRINT_DEBUG("Steam_Inventory::RunCallbacks couldn't save the inventory\n");
+            save_inventory_db();
+        }
+    }
 }
 
 };
@@ -22,6 +22,7 @@
 #define PENDING_JOIN_TIMEOUT 10.0
 #define REQUEST_LOBBY_DATA_TIMEOUT 6.0
 #define LOBBY_DELETED_TIMEOUT 2
+#define LOBBY_SYNC_REQUEST_INTERVAL 1.0
 
 struct Pending_Joins {
     SteamAPICall_t api_id;
@@ -43,19 +44,44 @@ struct Data_Requested {
 };
 
 struct Filter_Values {
-	std::string key;
+	std::string key; //lowercase
 	std::string value_string;
 	int value_int;
 	bool is_int;
 	ELobbyComparison eComparisonType;
 };
 
+struct Near_Filter {
+    std::string key; //lowercase
+    int value;
+};
+
+// a lobby metadata value as seen by the search, numbers are parsed once when the index is built
+struct Lobby_Search_Value {
+    std::string value;
+    bool is_int;
+    long long value_int;
+};
+
+struct Lobby_Search_Result {
+    uint64 room_id;
+    // index of its first distance to the near value filters, every result has one per filter
+    size_t distances;
+};
+
 struct Chat_Entry {
     std::string message;
     EChatEntryType type;
     CSteamID lobby_id, user_id;
 };
 
+// changes made by the owner since the last time the lobby was sent, flushed once per RunCallbacks
+struct Lobby_Pending_Changes {
+    bool full = false;
+    std::set<std::string> values;
+    std::map<uint64, std::set<std::string>> member_values;
+};
+
 #define FILTER_MAX_DEFAULT 4096
 
 
@@ -81,10 +107,23 @@ public ISteamMatchmaking
     std::vector<struct Pending_Creates> pending_creates;
 
     std::vector<struct Filter_Values> filter_values;
+    std::vector<struct Near_Filter> filter_near_values;
     int filter_max_results;
+    int filter_slots_available;
     std::vector<struct Filter_Values> filter_values_copy;
+    std::vector<struct Near_Filter> filter_near_values_copy;
     int filter_max_results_copy;
+    int filter_slots_available_copy;
     std::vector<CSteamID> filtered_lobbies;
+    // room_id -> lowercase key -> value, dropped whenever the lobby values change and rebuilt by the next search
+    std::unordered_map<uint64, std::unordered_map<std::string, struct Lobby_Search_Value>> lobby_search_index;
+    // lowercase key -> value -> room_ids, so a search only looks at the lobbies its most selective filter can match
+    std::unordered_map<std::string, std::map<std::string, std::set<uint64>>> lobby_string_index;
+    std::unordered_map<std::string, std::map<long long, std::set<uint64>>> lobby_int_index;
+    // lobbies whose values changed since the last search
+    std::set<uint64> lobby_search_pending;
+    // room_id -> index in lobbies, results are returned in the order of lobbies
+    std::unordered_map<uint64, size_t> lobby_positions;
     std::chrono::high_resolution_clock::time_point lobby_last_search;
     SteamAPICall_t search_call_api_id;
     bool searching;
@@ -93,6 +132,8 @@ public ISteamMatchmaking
     std::vector<struct Data_Requested> data_requested;
 
     std::map<uint64, ::google::protobuf::Map<std::string, std::string>> self_lobby_member_data;
+    std::map<uint64, struct Lobby_Pending_Changes> pending_lobby_changes;
+    std::map<uint64, std::chrono::high_resolution_clock::time_point> sync_requested;
 google::protobuf::Map<std::string,std::string>::const_iterator caseinsensitive_find(const ::google::protobuf::Map< ::std::string, ::std::string >& map, std::string key)
 {
     auto x = map.begin();
@@ -109,6 +150,273 @@ google::protobuf::Map<std::string,std::string>::const_iterator caseinsensitive_f
     return x;
 }
 
+static std::string lowercase_key(std::string key)
+{
+    std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c){ return std::tolower(c); });
+    return key;
+}
+
+static Lobby_Search_Value parse_search_value(const std::string &value)
+{
+    struct Lobby_Search_Value v;
+    v.value = value;
+    v.is_int = true;
+    v.value_int = 0;
+    //TODO: check if this is how real steam behaves
+    if (value.size()) {
+        const char *start = value.c_str();
+        char *end = nullptr;
+        errno = 0;
+        v.value_int = strtoll(start, &end, 0);
+        if (end == start || errno == ERANGE) v.is_int = false;
+    }
+
+    return v;
+}
+
+// removes the lobby from the search indexes, it's indexed again by the next search unless it was removed
+void unindex_lobby_search(uint64 room_id)
+{
+    auto index = lobby_search_index.find(room_id);
+    if (index == lobby_search_index.end()) return;
+
+    for (auto const &p : index->second) {
+        auto &strings = lobby_string_index[p.first];
+        auto value = strings.find(p.second.value);
+        if (value != strings.end()) {
+            value->second.erase(room_id);
+            if (value->second.empty()) strings.erase(value);
+        }
+        if (strings.empty()) lobby_string_index.erase(p.first);
+
+        if (p.second.is_int) {
+            auto &ints = lobby_int_index[p.first];
+            auto value_int = ints.find(p.second.value_int);
+            if (value_int != ints.end()) {
+                value_int->second.erase(room_id);
+                if (value_int->second.empty()) ints.erase(value_int);
+            }
+            if (ints.empty()) lobby_int_index.erase(p.first);
+        }
+    }
+
+    lobby_search_index.erase(index);
+}
+
+void invalidate_search_index(uint64 room_id)
+{
+    unindex_lobby_search(room_id);
+    lobby_search_pending.insert(room_id);
+}
+
+void index_lobby_search(Lobby *lobby)
+{
+    uint64 room_id = lobby->room_id();
+    std::unordered_map<std::string, struct Lobby_Search_Value> &values = lobby_search_index[room_id];
+    for (auto const &p : lobby->values()) {
+        std::string key = lowercase_key(p.first);
+        struct Lobby_Search_Value v = parse_search_value(p.second);
+        lobby_string_index[key][v.value].insert(room_id);
+        if (v.is_int) lobby_int_index[key][v.value_int].insert(room_id);
+        values.emplace(std::move(key), std::move(v));
+    }
+}
+
+void update_search_index()
+{
+    for (uint64 room_id : lobby_search_pending) {
+        auto position = lobby_positions.find(room_id);
+        if (position == lobby_positions.end()) continue;
+
+        unindex_lobby_search(room_id);
+        index_lobby_search(&lobbies[position->second]);
+    }
+
+    lobby_search_pending.clear();
+}
+
+std::unordered_map<std::string, struct Lobby_Search_Value> &get_search_values(Lobby *lobby)
+{
+    auto index = lobby_search_index.find(lobby->room_id());
+    if (index != lobby_search_index.end()) return index->second;
+
+    index_lobby_search(lobby);
+    return lobby_search_index[lobby->room_id()];
+}
+
+template<typename T>
+static std::pair<typename std::map<T, std::set<uint64>>::const_iterator, typename std::map<T, std::set<uint64>>::const_iterator>
+search_range(const std::map<T, std::set<uint64>> &values, const T &value, ELobbyComparison eComparisonType)
+{
+    switch (eComparisonType) {
+        case k_ELobbyComparisonEqualToOrLessThan: return {values.begin(), values.upper_bound(value)};
+        case k_ELobbyComparisonLessThan: return {values.begin(), values.lower_bound(value)};
+        case k_ELobbyComparisonEqual: return values.equal_range(value);
+        case k_ELobbyComparisonGreaterThan: return {values.upper_bound(value), values.end()};
+        case k_ELobbyComparisonEqualToOrGreaterThan: return {values.lower_bound(value), values.end()};
+        default: return {values.end(), values.end()};
+    }
+}
+
+template<typename T>
+static size_t search_candidates(const std::map<T, std::set<uint64>> &values, const T &value, ELobbyComparison eComparisonType, std::vector<uint64> *candidates)
+{
+    auto range = search_range(values, value, eComparisonType);
+    size_t count = 0;
+    for (auto it = range.first; it != range.second; ++it) {
+        count += it->second.size();
+        if (candidates) candidates->insert(candidates->end(), it->second.begin(), it->second.end());
+    }
+
+    return count;
+}
+
+// counts the lobbies that can match filter f and adds them to candidates if it isn't null
+// a lobby without the key can only match a not equal filter, which isn't indexed and returns SIZE_MAX
+size_t search_candidates(const struct Filter_Values &f, std::vector<uint64> *candidates)
+{
+    if (f.eComparisonType == k_ELobbyComparisonNotEqual) return SIZE_MAX;
+
+    if (f.is_int) {
+        auto values = lobby_int_index.find(f.key);
+        if (values != lobby_int_index.end()) return search_candidates(values->second, (long long)f.value_int, f.eComparisonType, candidates);
+    } else {
+        auto values = lobby_string_index.find(f.key);
+        if (values != lobby_string_index.end()) return search_candidates(values->second, f.value_string, f.eComparisonType, candidates);
+    }
+
+    return 0;
+}
+
+void update_lobby_positions()
+{
+    lobby_positions.clear();
+    for (size_t i = 0; i < lobbies.size(); ++i) lobby_positions[lobbies[i].room_id()] = i;
+}
+
+static bool compare_search_value(int compare, ELobbyComparison eComparisonType)
+{
+    switch (eComparisonType) {
+        case k_ELobbyComparisonEqualToOrLessThan: return compare <= 0;
+        case k_ELobbyComparisonLessThan: return compare < 0;
+        case k_ELobbyComparisonEqual: return compare == 0;
+        case k_ELobbyComparisonGreaterThan: return compare > 0;
+        case k_ELobbyComparisonEqualToOrGreaterThan: return compare >= 0;
+        case k_ELobbyComparisonNotEqual: return compare != 0;
+    }
+
+    return false;
+}
+
+static bool lobby_filter_matches(const struct Filter_Values &f, const std::unordered_map<std::string, struct Lobby_Search_Value> &values)
+{
+    auto value = values.find(f.key);
+    if (value == values.end()) {
+        //If the key is not in the lobby do we take it into account?
+        return f.eComparisonType == k_ELobbyComparisonNotEqual;
+    }
+
+    int compare;
+    if (f.is_int) {
+        //Same case as if the key is not in the lobby?
+        if (!value->second.is_int) return false;
+        compare = (value->second.value_int > f.value_int) - (value->second.value_int < f.value_int);
+    } else {
+        compare = value->second.value.compare(f.value_string);
+    }
+
+    return compare_search_value(compare, f.eComparisonType);
+}
+
+// fills filtered_lobbies with the lobbies matching the current search, closest to the near value filters first
+void search_lobbies()
+{
+    update_search_index();
+
+    // only the lobbies matching the filter with the fewest of them are checked, all of them without an indexed filter
+    const struct Filter_Values *narrowest = nullptr;
+    size_t narrowest_count = SIZE_MAX;
+    for (auto & f : filter_values_copy) {
+        size_t count = search_candidates(f, nullptr);
+        if (count < narrowest_count) {
+            narrowest = &f;
+            narrowest_count = count;
+        }
+    }
+
+    std::vector<size_t> positions;
+    if (narrowest) {
+        std::vector<uint64> candidates;
+        candidates.reserve(narrowest_count);
+        search_candidates(*narrowest, &candidates);
+        positions.reserve(candidates.size());
+        for (uint64 room_id : candidates) {
+            auto position = lobby_positions.find(room_id);
+            if (position != lobby_positions.end()) positions.push_back(position->second);
+        }
+        std::sort(positions.begin(), positions.end());
+    } else {
+        positions.resize(lobbies.size());
+        for (size_t i = 0; i < positions.size(); ++i) positions[i] = i;
+    }
+
+    std::vector<struct Lobby_Search_Result> results;
+    std::vector<unsigned long long> distances;
+    for (size_t position : positions) {
+        Lobby &l = lobbies[position];
+        bool use = l.joinable() && (l.type() == k_ELobbyTypePublic || l.type() == k_ELobbyTypeInvisible || l.type() == k_ELobbyTypeFriendsOnly) && !l.deleted();
+        if (!use) continue;
+
+        if (filter_slots_available_copy >= 0 && l.member_limit() && ((int)l.member_limit() - l.members_size()) < filter_slots_available_copy) continue;
+
+        auto &values = get_search_values(&l);
+        for (auto & f : filter_values_copy) {
+            if (!lobby_filter_matches(f, values)) {
+                use = false;
+                break;
+            }
+        }
+
+        PRINT_DEBUG("Steam_MatchMaking Lobby " "%" PRIu64 " use %u\n", l.room_id(), use);
+        if (!use) continue;
+
+        struct Lobby_Search_Result result;
+        result.room_id = l.room_id();
+        result.distances = distances.size();
+        for (auto & n : filter_near_values_copy) {
+            auto value = values.find(n.key);
+            if (value != values.end() && value->second.is_int) {
+                long long v = value->second.value_int;
+                distances.push_back(v < n.value ? (unsigned long long)n.value - (unsigned long long)v : (unsigned long long)v - (unsigned long long)n.value);
+            } else {
+                distances.push_back(ULLONG_MAX);
+            }
+        }
+
+        results.push_back(result);
+    }
+
+    size_t max_results = std::min(results.size(), (size_t)std::max(filter_max_results_copy, 0));
+    if (filter_near_values_copy.size()) {
+        //stable on ties so lobbies keep the order they were found in
+        std::vector<size_t> order(results.size());
+        for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+        size_t near_count = filter_near_values_copy.size();
+        std::partial_sort(order.begin(), order.begin() + max_results, order.end(), [&results, &distances, near_count](size_t a, size_t b) {
+            auto distances_a = distances.begin() + results[a].distances, distances_b = distances.begin() + results[b].distances;
+            auto mismatch = std::mismatch(distances_a, distances_a + near_count, distances_b);
+            if (mismatch.first != distances_a + near_count) return *mismatch.first < *mismatch.second;
+            return a < b;
+        });
+
+        filtered_lobbies.clear();
+        for (size_t i = 0; i < max_results; ++i) filtered_lobbies.push_back((uint64)results[order[i]].room_id);
+    } else {
+        filtered_lobbies.clear();
+        for (size_t i = 0; i < max_results; ++i) filtered_lobbies.push_back((uint64)results[i].room_id);
+    }
+}
+
 Lobby *get_lobby(CSteamID id)
 {
     if (!id.IsLobby())
@@ -128,14 +436,107 @@ void send_lobby_data()
     for(auto & l: lobbies) {
         if (get_lobby_member(&l, settings->get_local_steam_id()) && l.owner() == settings->get_local_steam_id().ConvertToUint64() && !l.deleted()) {
             PRINT_DEBUG("Steam_MatchMaking::Sending lobby " "%" PRIu64 "\n", l.room_id());
+            send_lobby(&l, k_steamIDNil);
+        }
+    }
+}
+
+void send_lobby(Lobby *lobby, CSteamID dest)
+{
+    Common_Message msg = Common_Message();
+    msg.set_source_id(settings->get_local_steam_id().ConvertToUint64());
+    msg.set_allocated_lobby(new Lobby(*lobby));
+    if (dest.IsValid()) {
+        msg.set_dest_id(dest.ConvertToUint64());
+        network->sendTo(&msg, true);
+    } else {
+        network->sendToAllIndividuals(&msg, true);
+    }
+}
+
+void mark_lobby_changed(Lobby *lobby, std::string key)
+{
+    pending_lobby_changes[lobby->room_id()].values.insert(key);
+}
+
+void mark_lobby_member_changed(Lobby *lobby, uint64 member_id, std::string key)
+{
+    pending_lobby_changes[lobby->room_id()].member_values[member_id].insert(key);
+}
+
+// sends the changes made since the last flush, only the keys that changed unless the members or the lobby settings changed
+void send_lobby_changes()
+{
+    auto p = std::begin(pending_lobby_changes);
+    while (p != std::end(pending_lobby_changes)) {
+        Lobby *lobby = get_lobby((uint64)p->first);
+        if (!lobby || lobby->deleted() || lobby->owner() != settings->get_local_steam_id().ConvertToUint64()) {
+            p = pending_lobby_changes.erase(p);
+            continue;
+        }
+
+        Lobby_Delta *delta = new Lobby_Delta();
+        bool full = p->second.full;
+        for (auto const &key : p->second.values) {
+            auto value = lobby->values().find(key);
+            if (value != lobby->values().end()) {
+                (*delta->mutable_values())[key] = value->second;
+            } else {
+                delta->add_values_removed(key);
+            }
+        }
+
+        for (auto const &m : p->second.member_values) {
+            Lobby_Member *member = get_lobby_member(lobby, (uint64)m.first);
+            if (!member) {
+                full = true;
+                break;
+            }
+
+            Lobby_Delta_Member_Values *member_values = delta->add_members();
+            member_values->set_id(m.first);
+            for (auto const &key : m.second) {
+                auto value = member->values().find(key);
+                if (value != member->values().end()) {
+                    (*member_values->mutable_values())[key] = value->second;
+                } else {
+                    member_values->add_removed(key);
+                }
+            }
+        }
+
+        uint64 base_version = lobby->version();
+        lobby->set_version(base_version + 1);
+        if (!full && delta->ByteSizeLong() < lobby->ByteSizeLong()) {
+            PRINT_DEBUG("Steam_MatchMaking::Sending lobby delta " "%" PRIu64 " %i %i\n", lobby->room_id(), delta->values_size() + delta->values_removed_size(), delta->members_size());
+            delta->set_room_id(lobby->room_id());
+            delta->set_base_version(base_version);
+            delta->set_version(lobby->version());
             Common_Message msg = Common_Message();
             msg.set_source_id(settings->get_local_steam_id().ConvertToUint64());
-            msg.set_allocated_lobby(new Lobby(l));
+            msg.set_allocated_lobby_delta(delta);
             network->sendToAllIndividuals(&msg, true);
+        } else {
+            delete delta;
+            send_lobby(lobby, k_steamIDNil);
         }
+
+        p = pending_lobby_changes.erase(p);
     }
 }
 
+void request_lobby_sync(Lobby *lobby)
+{
+    auto r = sync_requested.find(lobby->room_id());
+    if (r != sync_requested.end() && !check_timedout(r->second, LOBBY_SYNC_REQUEST_INTERVAL)) return;
+
+    PRINT_DEBUG("Steam_MatchMaking::Requesting lobby sync " "%" PRIu64 " %" PRIu64 "\n", lobby->room_id(), lobby->version());
+    sync_requested[lobby->room_id()] = std::chrono::high_resolution_clock::now();
+    Lobby_Messages *message = new Lobby_Messages();
+    message->set_type(Lobby_Messages::SYNC_REQUEST);
+    send_owner_packet((uint64)lobby->room_id(), message);
+}
+
 void trigger_lobby_dataupdate(CSteamID lobby, CSteamID member, bool success, double cb_timeout=0.005, bool send_changed_lobby=true)
 {
     PRINT_DEBUG("Steam_MatchMaking::Lobby dataupdate %llu %llu\n", lobby.ConvertToUint64(), member.ConvertToUint64());
@@ -156,10 +557,7 @@ void trigger_lobby_dataupdate(CSteamID lobby, CSteamID member, bool success, dou
     Lobby *l = get_lobby(lobby);
     if (l && l->owner() == settings->get_local_steam_id().ConvertToUint64()) {
         if (send_changed_lobby) {
-            Common_Message msg = Common_Message();
-            msg.set_source_id(settings->get_local_steam_id().ConvertToUint64());
-            msg.set_allocated_lobby(new Lobby(*l));
-            network->sendToAllIndividuals(&msg, true);
+            pending_lobby_changes[l->room_id()].full = true;
         }
     }
 }
@@ -242,6 +640,8 @@ bool change_owner(Lobby *lobby, CSteamID new_owner)
     Lobby_Messages *message = new Lobby_Messages();
     message->set_type(Lobby_Messages::CHANGE_OWNER);
     message->set_idata(new_owner.ConvertToUint64());
+    //the new owner must have our pending changes before it starts sending its own
+    send_lobby_changes();
     lobby->set_owner(new_owner.ConvertToUint64());
     send_owner_packet((uint64)lobby->room_id(), message);
     trigger_lobby_dataupdate((uint64)lobby->room_id(), (uint64)lobby->room_id(), true);
@@ -261,16 +661,24 @@ void send_gameservercreated_cb(uint64 room_id, uint64 server_id, uint32 ip, uint
 void remove_lobbies()
 {
     uint64 current_time = std::chrono::duration_cast<std::chrono::duration<uint64>>(std::chrono::system_clock::now().time_since_epoch()).count();
+    bool removed = false;
     auto g = std::begin(lobbies);
     while (g != std::end(lobbies)) {
         if (g->members().size() == 0 || (g->deleted() && (g->time_deleted() + LOBBY_DELETED_TIMEOUT < current_time))) {
             PRINT_DEBUG("Steam_MatchMaking::REMOVING LOBBY " "%" PRIu64 "\n", g->room_id());
             self_lobby_member_data.erase(g->room_id());
+            pending_lobby_changes.erase(g->room_id());
+            sync_requested.erase(g->room_id());
+            unindex_lobby_search(g->room_id());
+            lobby_search_pending.erase(g->room_id());
             g = lobbies.erase(g);
+            removed = true;
         } else {
             ++g;
         }
     }
+
+    if (removed) update_lobby_positions();
 }
 
 void on_self_enter_leave_lobby(CSteamID id, int type, bool leaving)
@@ -315,6 +723,7 @@ Steam_Matchmaking(class Settings *settings, class Networking *network, class Ste
     this->callback_results = callback_results;
     this->callbacks = callbacks;
     this->filter_max_results = FILTER_MAX_DEFAULT;
+    this->filter_slots_available = -1;
     search_call_api_id = 0;
     searching = false;
 }
@@ -535,9 +944,13 @@ SteamAPICall_t RequestLobbyList()
     filtered_lobbies.clear();
     lobby_last_search = std::chrono::high_resolution_clock::now();
     filter_values_copy = filter_values;
+    filter_near_values_copy = filter_near_values;
     filter_max_results_copy = filter_max_results;
+    filter_slots_available_copy = filter_slots_available;
     filter_values.clear();
+    filter_near_values.clear();
     filter_max_results = FILTER_MAX_DEFAULT;
+    filter_slots_available = -1;
     searching = true;
     if (search_call_api_id) callback_results->rmCallBack(search_call_api_id, NULL);
     search_call_api_id = callback_results->reserveCallResult();
@@ -563,7 +976,7 @@ void AddRequestLobbyListStringFilter( const char *pchKeyToMatch, const char *pch
 
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     struct Filter_Values fv;
-    fv.key = std::string(pchKeyToMatch);
+    fv.key = lowercase_key(pchKeyToMatch);
     fv.value_string = std::string(pchValueToMatch);
     fv.is_int = false;
     fv.eComparisonType = eComparisonType;
@@ -577,7 +990,7 @@ void AddRequestLobbyListNumericalFilter( const char *pchKeyToMatch, int nValueTo
     PRINT_DEBUG("Steam_MatchMaking::AddRequestLobbyListNumericalFilter %s %i %i\n", pchKeyToMatch, nValueToMatch, eComparisonType);
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     struct Filter_Values fv;
-    fv.key = std::string(pchKeyToMatch);
+    fv.key = lowercase_key(pchKeyToMatch);
     fv.value_int = nValueToMatch;
     fv.is_int = true;
     fv.eComparisonType = eComparisonType;
@@ -589,9 +1002,13 @@ void AddRequestLobbyListNumericalFilter( const char *pchKeyToMatch, int nValueTo
 void AddRequestLobbyListNearValueFilter( const char *pchKeyToMatch, int nValueToBeCloseTo )
 {
     PRINT_DEBUG("Steam_MatchMaking::AddRequestLobbyListNearValueFilter %s %u\n", pchKeyToMatch, nValueToBeCloseTo);
-    std::lock_guard<std::recursive_mutex> lock(global_mutex);
+    if (!pchKeyToMatch) return;
 
-    
+    std::lock_guard<std::recursive_mutex> lock(global_mutex);
+    struct Near_Filter nf;
+    nf.key = lowercase_key(pchKeyToMatch);
+    nf.value = nValueToBeCloseTo;
+    filter_near_values.push_back(nf);
 }
 
 // returns only lobbies with the specified number of slots available
@@ -599,8 +1016,7 @@ void AddRequestLobbyListFilterSlotsAvailable( int nSlotsAvailable )
 {
     PRINT_DEBUG("Steam_MatchMaking::AddRequestLobbyListFilterSlotsAvailable %i\n", nSlotsAvailable);
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
-
-    
+    filter_slots_available = nSlotsAvailable;
 }
 
 // sets the distance for which we should search for lobbies (based on users IP address to location map on the Steam backed)
@@ -696,7 +1112,9 @@ void Create_pending_lobbies()
             lobby.set_owner(settings->get_local_steam_id().ConvertToUint64());
             lobby.set_appid(settings->get_local_game_id().AppID());
             enter_lobby(&lobby, settings->get_local_steam_id());
+            lobby_positions[lobby.room_id()] = lobbies.size();
             lobbies.push_back(lobby);
+            invalidate_search_index(lobby.room_id());
 
             if (settings->disable_lobby_creation) {
                 LobbyCreated_t data;
@@ -751,6 +1169,8 @@ SteamAPICall_t CreateLobby( ELobbyType eLobbyType, int cMaxMembers )
     p_c.cMaxMembers = cMaxMembers;
     p_c.created = std::chrono::high_resolution_clock::now();
     pending_creates.push_back(p_c);
+    // so peers that just started see the lobby without waiting for the next announce
+    network->restartAnnounces();
     return p_c.api_id;
 }
 
@@ -941,14 +1361,19 @@ bool SetLobbyData( CSteamID steamIDLobby, const char *pchKey, const char *pchVal
         auto result = caseinsensitive_find(lobby->values(), pchKey);
         if (result == lobby->values().end()) {
             (*lobby->mutable_values())[pchKey] = pchValue;
+            mark_lobby_changed(lobby, pchKey);
         } else {
             if (result->second == std::string(pchValue)) changed = false;
-            (*lobby->mutable_values())[result->first] = pchValue;
+            std::string key = result->first;
+            (*lobby->mutable_values())[key] = pchValue;
+            if (changed) mark_lobby_changed(lobby, key);
         }
+
+        invalidate_search_index(lobby->room_id());
     }
 
     if (changed)
-        trigger_lobby_dataupdate(steamIDLobby, steamIDLobby, true, 0.005, changed);
+        trigger_lobby_dataupdate(steamIDLobby, steamIDLobby, true, 0.005, false);
 
     return true;
 }
@@ -1004,8 +1429,12 @@ bool DeleteLobbyData( CSteamID steamIDLobby, const char *pchKey )
         return false;
     }
 
-    lobby->mutable_values()->erase(pchKey);
-    trigger_lobby_dataupdate(steamIDLobby, steamIDLobby, true);
+    if (lobby->mutable_values()->erase(pchKey)) {
+        mark_lobby_changed(lobby, pchKey);
+        invalidate_search_index(lobby->room_id());
+    }
+
+    trigger_lobby_dataupdate(steamIDLobby, steamIDLobby, true, 0.005, false);
     
     return true;
 }
@@ -1055,12 +1484,11 @@ void SetLobbyMemberData( CSteamID steamIDLobby, const char *pchKey, const char *
     if (member) {
         if (lobby->owner() == settings->get_local_steam_id().ConvertToUint64()) {
             auto result = caseinsensitive_find(member->values(), std::string(pchKey));
-            if (result == member->values().end()) {
-                (*member->mutable_values())[pchKey] = pchValue;
-            } else {
-                (*member->mutable_values())[result->first] = pchValue;
-            }
-            trigger_lobby_dataupdate(steamIDLobby, (uint64)member->id(), true);
+            std::string key = pchKey;
+            if (result != member->values().end()) key = result->first;
+            (*member->mutable_values())[key] = pchValue;
+            mark_lobby_member_changed(lobby, member->id(), key);
+            trigger_lobby_dataupdate(steamIDLobby, (uint64)member->id(), true, 0.005, false);
         } else {
             Lobby_Messages *message = new Lobby_Messages();
             message->set_type(Lobby_Messages::MEMBER_DATA);
@@ -1341,6 +1769,7 @@ void RunBackground()
 {
     remove_lobbies();
     Create_pending_lobbies();
+    send_lobby_changes();
 
     if (check_timedout(last_sent_lobbies, SEND_LOBBY_RATE)) {
         send_lobby_data();
@@ -1353,69 +1782,15 @@ void RunCallbacks()
     RunBackground();
 
     if (searching) {
-        PRINT_DEBUG("Steam_MatchMaking::Searching for lobbies %zu\n", lobbies.size());
-        for(auto & l: lobbies) {
-            bool use = l.joinable() && (l.type() == k_ELobbyTypePublic || l.type() == k_ELobbyTypeInvisible || l.type() == k_ELobbyTypeFriendsOnly) && !l.deleted();
-            PRINT_DEBUG("Steam_MatchMaking use lobby: %u, filters: %zu, joinable: %u, type: %u, deleted: %u\n", use, filter_values_copy.size(), l.joinable(), l.type(), l.deleted());
-            for (auto & f : filter_values_copy) {
-                PRINT_DEBUG("Steam_MatchMaking %s:%s/%i %u %i\n", f.key.c_str(), f.value_string.c_str(), f.value_int, f.is_int, f.eComparisonType);
-                auto value = caseinsensitive_find(l.values(), f.key);
-                if (value != l.values().end()) {
-                    //TODO: eComparisonType
-                    if (!f.is_int) {
-                        PRINT_DEBUG("Steam_MatchMaking Compare Values %s %s\n", value->second.c_str(), f.value_string.c_str());
-                        if (f.eComparisonType == k_ELobbyComparisonEqual) {
-                            if (value->second == f.value_string) {
-                                PRINT_DEBUG("Steam_MatchMaking Equal\n");
-                                //use = use;
-                            } else {
-                                PRINT_DEBUG("Steam_MatchMaking Not Equal\n");
-                                use = false;
-                            }
-                        }
-                    } else {
-                        try {
-                            PRINT_DEBUG("Steam_MatchMaking %s\n", value->second.c_str());
-                            int compare_to = 0;
-                            //TODO: check if this is how real steam behaves
-                            if (value->second.size()) {
-                                compare_to = std::stoll(value->second, 0, 0);
-                            }
-                            PRINT_DEBUG("Steam_MatchMaking Compare Values %i %i\n", compare_to, f.value_int);
-                            if (f.eComparisonType == k_ELobbyComparisonEqual) {
-                                if (compare_to == f.value_int) {
-                                    PRINT_DEBUG("Steam_MatchMaking Equal\n");
-                                    //use = use;
-                                } else {
-                                    PRINT_DEBUG("Steam_MatchMaking Not Equal\n");
-                                    use = false;
-                                }
-                            }
-                        } catch (...) {
-                            //Same case as if the key is not in the lobby?
-                            use = false;
-                        }
-                        //TODO: add more comparisons
-                    }
-                } else {
-                    PRINT_DEBUG("Steam_MatchMaking Compare Key not in lobby\n");
-                    if (f.eComparisonType == k_ELobbyComparisonEqual) {
-                        //If the key is not in the lobby do we take it into account?
-                        use = false;
-                    }
-                }
-            }
-
-            PRINT_DEBUG("Steam_MatchMaking Lobby " "%" PRIu64 " use %u\n", l.room_id(), use);
-            if (use) PUSH_BACK_IF_NOT_IN(filtered_lobbies, (uint64)l.room_id());
-            if (filtered_lobbies.size() >= filter_max_results_copy) {
-                searching = false;
-                LobbyMatchList_t data;
-                data.m_nLobbiesMatching = filtered_lobbies.size();
-                callback_results->addCallResult(search_call_api_id, data.k_iCallback, &data, sizeof(data));
-                callbacks->addCBResult(data.k_iCallback, &data, sizeof(data));
-                search_call_api_id = 0;
-            }
+        PRINT_DEBUG("Steam_MatchMaking::Searching for lobbies %zu, filters: %zu, near filters: %zu\n", lobbies.size(), filter_values_copy.size(), filter_near_values_copy.size());
+        search_lobbies();
+        if (filtered_lobbies.size() >= filter_max_results_copy) {
+            searching = false;
+            LobbyMatchList_t data;
+            data.m_nLobbiesMatching = filtered_lobbies.size();
+            callback_results->addCallResult(search_call_api_id, data.k_iCallback, &data, sizeof(data));
+            callbacks->addCBResult(data.k_iCallback, &data, sizeof(data));
+            search_call_api_id = 0;
         }
     }
 
@@ -1508,6 +1883,7 @@ void Callback(Common_Message *msg)
                 size_t old_size = lobbies.size();
                 lobbies.resize(old_size + 1);
                 lobbies[old_size].set_room_id(msg->lobby().room_id());
+                lobby_positions[msg->lobby().room_id()] = old_size;
                 lobby = &(lobbies[old_size]);
             }
 
@@ -1581,6 +1957,7 @@ void Callback(Common_Message *msg)
                     }
 
                     *lobby = msg->lobby();
+                    invalidate_search_index(lobby->room_id());
                 }
             }
         }
@@ -1600,6 +1977,13 @@ void Callback(Common_Message *msg)
                     }
                 }
 
+                if (msg->lobby_messages().type() == Lobby_Messages::SYNC_REQUEST) {
+                    PRINT_DEBUG("Steam_MatchMaking LOBBY MESSAGE: SYNC_REQUEST\n");
+                    if (get_lobby_member(lobby, (uint64)msg->source_id())) {
+                        send_lobby(lobby, (uint64)msg->source_id());
+                    }
+                }
+
                 if (msg->lobby_messages().type() == Lobby_Messages::MEMBER_DATA) {
                     PRINT_DEBUG("Steam_MatchMaking LOBBY MESSAGE: MEMBER_DATA\n");
                     Lobby_Member *member = get_lobby_member(lobby, (uint64)msg->source_id());
@@ -1607,14 +1991,13 @@ void Callback(Common_Message *msg)
                         for (auto const &p : msg->lobby_messages().map()) {
                             PRINT_DEBUG("Steam_MatchMaking member data %s:%s\n", p.first.c_str(), p.second.c_str());
                             auto result = caseinsensitive_find(member->values(), p.first);
-                            if (result == member->values().end()) {
-                                (*member->mutable_values())[p.first] = p.second;
-                            } else {
-                                (*member->mutable_values())[result->first] = p.second;
-                            }
+                            std::string key = p.first;
+                            if (result != member->values().end()) key = result->first;
+                            (*member->mutable_values())[key] = p.second;
+                            mark_lobby_member_changed(lobby, member->id(), key);
                         }
 
-                        trigger_lobby_dataupdate((uint64)lobby->room_id(), (uint64)member->id(), true);
+                        trigger_lobby_dataupdate((uint64)lobby->room_id(), (uint64)member->id(), true, 0.005, false);
                     }
                 }
             }
@@ -1651,6 +2034,52 @@ void Callback(Common_Message *msg)
         }
     }
 
+    if (msg->has_lobby_delta()) {
+        PRINT_DEBUG("Steam_MatchMaking LOBBY DELTA " "%" PRIu64 " %" PRIu64 " %" PRIu64 "\n", msg->lobby_delta().room_id(), msg->lobby_delta().base_version(), msg->lobby_delta().version());
+        Lobby *lobby = get_lobby((uint64)msg->lobby_delta().room_id());
+        if (lobby && !lobby->deleted() && lobby->owner() == msg->source_id() && lobby->owner() != settings->get_local_steam_id().ConvertToUint64()) {
+            bool we_are_in_lobby = !!get_lobby_member(lobby, settings->get_local_steam_id());
+            if (lobby->version() == msg->lobby_delta().base_version()) {
+                bool missing_member = false;
+                for (auto const &m : msg->lobby_delta().members()) {
+                    if (!get_lobby_member(lobby, (uint64)m.id())) missing_member = true;
+                }
+
+                if (missing_member) {
+                    if (we_are_in_lobby) request_lobby_sync(lobby);
+                } else {
+                    for (auto const &p : msg->lobby_delta().values()) {
+                        (*lobby->mutable_values())[p.first] = p.second;
+                    }
+
+                    for (auto const &key : msg->lobby_delta().values_removed()) {
+                        lobby->mutable_values()->erase(key);
+                    }
+
+                    lobby->set_version(msg->lobby_delta().version());
+                    invalidate_search_index(lobby->room_id());
+                    if (we_are_in_lobby) trigger_lobby_dataupdate((uint64)lobby->room_id(), (uint64)lobby->room_id(), true);
+
+                    for (auto const &m : msg->lobby_delta().members()) {
+                        Lobby_Member *member = get_lobby_member(lobby, (uint64)m.id());
+                        for (auto const &p : m.values()) {
+                            (*member->mutable_values())[p.first] = p.second;
+                        }
+
+                        for (auto const &key : m.removed()) {
+                            member->mutable_values()->erase(key);
+                        }
+
+                        if (we_are_in_lobby) trigger_lobby_dataupdate((uint64)lobby->room_id(), (uint64)m.id(), true);
+                    }
+                }
+            } else if (lobby->version() < msg->lobby_delta().base_version()) {
+                //missed an update, the full lobby broadcast will fix it eventually if we aren't in it
+                if (we_are_in_lobby) request_lobby_sync(lobby);
+            }
+        }
+    }
+
     if (msg->has_low_level()) {
         if (msg->low_level().type() == Low_Level::CONNECT) {
             
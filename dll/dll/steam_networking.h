@@ -84,6 +84,8 @@ public ISteamNetworking
     std::map<CSteamID, std::chrono::high_resolution_clock::time_point> new_connection_times;
     std::queue<CSteamID> new_connections_to_call_cb;
 
+    Message_Arena message_arena;
+
 bool connection_exists(CSteamID id)
 {
     std::lock_guard<std::recursive_mutex> lock(connections_edit_mutex);
@@ -274,26 +276,27 @@ bool SendP2PPacket( CSteamID steamIDRemote, const void *pubData, uint32 cubData,
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     bool reliable = false;
     if (eP2PSendType == k_EP2PSendReliable || eP2PSendType == k_EP2PSendReliableWithBuffering) reliable = true;
-    Common_Message msg;
-    msg.set_source_id(settings->get_local_steam_id().ConvertToUint64());
-    msg.set_dest_id(steamIDRemote.ConvertToUint64());
-    msg.set_allocated_network(new Network_pb);
+    Message_Arena::Scope scope(message_arena);
+    Common_Message *msg = scope.create<Common_Message>();
+    msg->set_source_id(settings->get_local_steam_id().ConvertToUint64());
+    msg->set_dest_id(steamIDRemote.ConvertToUint64());
+    msg->set_allocated_network(scope.create<Network_pb>());
 
     if (!connection_exists(steamIDRemote)) {
-        msg.mutable_network()->set_type(Network_pb::NEW_CONNECTION);
-        network->sendTo(&msg, true);
+        msg->mutable_network()->set_type(Network_pb::NEW_CONNECTION);
+        network->sendTo(msg, true);
     }
 
-    msg.mutable_network()->set_channel(nChannel);
-    msg.mutable_network()->set_data(pubData, cubData);
-    msg.mutable_network()->set_type(Network_pb::DATA);
+    msg->mutable_network()->set_channel(nChannel);
+    msg->mutable_network()->set_data(pubData, cubData);
+    msg->mutable_network()->set_type(Network_pb::DATA);
 
     struct Steam_Networking_Connection *conn = get_or_create_connection(steamIDRemote);
     new_connection_times.erase(steamIDRemote);
 
     conn->open_channels.insert(nChannel);
-    bool ret = network->sendTo(&msg, reliable);
-    PRINT_DEBUG("Sent message with size: %zu %u\n", msg.network().data().size(), ret);
+    bool ret = network->sendTo(msg, reliable);
+    PRINT_DEBUG("Sent message with size: %zu %u\n", msg->network().data().size(), ret);
     return ret;
 }
 
@@ -914,7 +917,18 @@ void Callback(Common_Message *msg)
 #endif
 
         if (msg->network().type() == Network_pb::DATA) {
-            unprocessed_messages.push_back(Common_Message(*msg));
+            std::lock_guard<std::recursive_mutex> lock(messages_mutex);
+            CSteamID source_id((uint64)msg->source_id());
+            if (unprocessed_messages.empty() && connection_exists(source_id)) {
+                //known peer, readable right away instead of after the next RunCallbacks
+                messages.push_back(Common_Message(*msg));
+                Common_Message &received = messages.back();
+                get_or_create_connection(source_id)->open_channels.insert(received.network().channel());
+                received.mutable_network()->set_processed(true);
+                received.mutable_network()->set_time_processed(std::chrono::duration_cast<std::chrono::duration<uint64>>(std::chrono::system_clock::now().time_since_epoch()).count());
+            } else {
+                unprocessed_messages.push_back(Common_Message(*msg));
+            }
         }
 
         if (msg->network().type() == Network_pb::NEW_CONNECTION) {
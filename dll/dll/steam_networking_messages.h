@@ -18,10 +18,11 @@
 #include "base.h"
 
 #define NETWORKING_MESSAGES_TIMEOUT 30.0
+// max amount of released message objects kept around for reuse
+#define NETWORKING_MESSAGES_POOL_SIZE 256
 
 struct Steam_Message_Connection {
     SteamNetworkingIdentity remote_identity;
-    std::map<int, std::queue<std::string>> data;
 
     std::list<int> channels;
     bool accepted = false;
@@ -33,6 +34,19 @@ struct Steam_Message_Connection {
     std::chrono::high_resolution_clock::time_point created = std::chrono::high_resolution_clock::now();
 };
 
+// a received message waiting in a channel inbox, in arrival order
+struct Steam_Message_Pending {
+    CSteamID remote_id;
+    unsigned conn_id;
+    std::string data;
+    SteamNetworkingMicroseconds time_received;
+};
+
+// the message object handed to the game, owns its payload so no extra copy is needed
+struct Steam_Message_Pooled : public SteamNetworkingMessage_t {
+    std::string data;
+};
+
 class Steam_Networking_Messages :
 public ISteamNetworkingMessages
 {
@@ -44,9 +58,15 @@ public ISteamNetworkingMessages
 
     std::map<CSteamID, Steam_Message_Connection> connections;
     std::list<Common_Message> incoming_data;
+    // channel -> pending messages from all peers
+    std::map<int, std::deque<Steam_Message_Pending>> inbox;
+
+    // released message objects, shared by all instances since the game may release them at any time
+    inline static std::vector<Steam_Message_Pooled *> message_pool{};
 
     unsigned id_counter = 0;
     std::chrono::steady_clock::time_point created;
+    Message_Arena message_arena;
 public:
 
 static void steam_callback(void *object, Common_Message *msg)
@@ -90,6 +110,7 @@ std::map<CSteamID, Steam_Message_Connection>::iterator find_or_create_message_co
 {
     auto conn = connections.find(identityRemote.GetSteamID());
     if (conn == connections.end() || (conn->second.dead && restartbroken)) {
+        if (conn != connections.end()) drop_pending_messages(conn->first);
         ++id_counter;
         struct Steam_Message_Connection con;
         con.remote_identity = identityRemote;
@@ -198,29 +219,57 @@ EResult SendMessageToUser( const SteamNetworkingIdentity &identityRemote, const
         return k_EResultNoConnection;
     }
 
-    Common_Message msg;
-    msg.set_source_id(settings->get_local_steam_id().ConvertToUint64());
-    msg.set_dest_id(conn->second.remote_identity.GetSteamID64());
-    msg.set_allocated_networking_messages(new Networking_Messages);
-    msg.mutable_networking_messages()->set_type(Networking_Messages::DATA);
-    msg.mutable_networking_messages()->set_channel(nRemoteChannel);
-    msg.mutable_networking_messages()->set_id_from(conn->second.id);
-    msg.mutable_networking_messages()->set_data(pubData, cubData);
-
-    network->sendTo(&msg, reliable);
+    Message_Arena::Scope scope(message_arena);
+    Common_Message *msg = scope.create<Common_Message>();
+    msg->set_source_id(settings->get_local_steam_id().ConvertToUint64());
+    msg->set_dest_id(conn->second.remote_identity.GetSteamID64());
+    msg->set_allocated_networking_messages(scope.create<Networking_Messages>());
+    msg->mutable_networking_messages()->set_type(Networking_Messages::DATA);
+    msg->mutable_networking_messages()->set_channel(nRemoteChannel);
+    msg->mutable_networking_messages()->set_id_from(conn->second.id);
+    msg->mutable_networking_messages()->set_data(pubData, cubData);
+
+    network->sendTo(msg, reliable);
     return k_EResultOK;
 }
 
-static void free_steam_message_data(SteamNetworkingMessage_t *pMsg)
+static void release_pooled_message(SteamNetworkingMessage_t *pMsg)
+{
+    Steam_Message_Pooled *pooled = static_cast<Steam_Message_Pooled *>(pMsg);
+    std::lock_guard<std::recursive_mutex> lock(global_mutex);
+    if (message_pool.size() < NETWORKING_MESSAGES_POOL_SIZE) {
+        pooled->data.clear();
+        pooled->m_pData = NULL;
+        pooled->m_cbSize = 0;
+        message_pool.push_back(pooled);
+    } else {
+        delete pooled;
+    }
+}
+
+static Steam_Message_Pooled *acquire_pooled_message()
 {
-    free(pMsg->m_pData);
-    pMsg->m_pData = NULL;
+    if (message_pool.empty()) {
+        return new Steam_Message_Pooled();
+    }
+
+    Steam_Message_Pooled *pooled = message_pool.back();
+    message_pool.pop_back();
+    // the game might have touched these before releasing the object
+    pooled->m_nFlags = 0;
+    pooled->m_nUserData = 0;
+    pooled->m_idxLane = 0;
+    return pooled;
 }
 
-static void delete_steam_message(SteamNetworkingMessage_t *pMsg)
+void drop_pending_messages(CSteamID steam_id)
 {
-    if (pMsg->m_pfnFreeData) pMsg->m_pfnFreeData(pMsg);
-    delete pMsg;
+    for (auto &chan : inbox) {
+        auto &pending = chan.second;
+        pending.erase(std::remove_if(pending.begin(), pending.end(), [&steam_id](const Steam_Message_Pending &p) {
+            return p.remote_id == steam_id;
+        }), pending.end());
+    }
 }
 
 /// Reads the next message that has been sent from another user via SendMessageToUser() on the given channel.
@@ -233,34 +282,29 @@ int ReceiveMessagesOnChannel( int nLocalChannel, SteamNetworkingMessage_t **ppOu
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     int message_counter = 0;
 
-    for (auto & conn : connections) {
-        auto chan = conn.second.data.find(nLocalChannel);
-        if (chan != conn.second.data.end()) {
-            while (!chan->second.empty() && message_counter < nMaxMessages) {
-                SteamNetworkingMessage_t *pMsg = new SteamNetworkingMessage_t(); //TODO size is wrong
-                unsigned long size = chan->second.front().size();
-                pMsg->m_pData = malloc(size);
-                pMsg->m_cbSize = size;
-                memcpy(pMsg->m_pData, chan->second.front().data(), size);
-                pMsg->m_conn = conn.second.id;
-                pMsg->m_identityPeer = conn.second.remote_identity;
-                pMsg->m_nConnUserData = -1;
-                pMsg->m_usecTimeReceived = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - created).count();
-                //TODO: messagenumber?
-                // pMsg->m_nMessageNumber = connect_socket->second.packet_receive_counter;
-                // ++connect_socket->second.packet_receive_counter;
-
-                pMsg->m_pfnFreeData = &free_steam_message_data;
-                pMsg->m_pfnRelease = &delete_steam_message;
-                pMsg->m_nChannel = nLocalChannel;
-                ppOutMessages[message_counter] = pMsg;
-                ++message_counter;
-                chan->second.pop();
-            }
-        }
-
-        if (message_counter >= nMaxMessages) {
-            break;
+    auto chan = inbox.find(nLocalChannel);
+    if (chan != inbox.end()) {
+        auto &pending = chan->second;
+        while (!pending.empty() && message_counter < nMaxMessages) {
+            Steam_Message_Pending &p = pending.front();
+            Steam_Message_Pooled *pMsg = acquire_pooled_message();
+            pMsg->data = std::move(p.data);
+            pMsg->m_pData = &pMsg->data[0];
+            pMsg->m_cbSize = pMsg->data.size();
+            pMsg->m_conn = p.conn_id;
+            pMsg->m_identityPeer.SetSteamID(p.remote_id);
+            pMsg->m_nConnUserData = -1;
+            pMsg->m_usecTimeReceived = p.time_received;
+            //TODO: messagenumber?
+            pMsg->m_nMessageNumber = 0;
+
+            // the payload is owned by the pooled object, Release() gives both back
+            pMsg->m_pfnFreeData = NULL;
+            pMsg->m_pfnRelease = &release_pooled_message;
+            pMsg->m_nChannel = nLocalChannel;
+            ppOutMessages[message_counter] = pMsg;
+            ++message_counter;
+            pending.pop_front();
         }
     }
 
@@ -311,6 +355,7 @@ bool CloseSessionWithUser( const SteamNetworkingIdentity &identityRemote )
     msg.mutable_networking_messages()->set_id_from(conn->second.id);
     network->sendTo(&msg, true);
 
+    drop_pending_messages(conn->first);
     connections.erase(conn);
     return true;
 }
@@ -361,10 +406,18 @@ ESteamNetworkingConnectionState GetSessionConnectionInfo( const SteamNetworkingI
 
     if (pQuickStatus) {
         memset(pQuickStatus, 0, sizeof(SteamNetConnectionRealTimeStatus_t));
+        //sessions with ourselves and peers that weren't measured yet get the old made up numbers
+        struct Link_Stats stats = {10, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+        if (!network->getLinkStats(identityRemote.GetSteamID(), &stats) || stats.ping < 0) stats.ping = 10;
+
         pQuickStatus->m_eState = state;
-        pQuickStatus->m_nPing = 10; //TODO: calculate real numbers?
-        pQuickStatus->m_flConnectionQualityLocal = 1.0;
-        pQuickStatus->m_flConnectionQualityRemote = 1.0;
+        pQuickStatus->m_nPing = stats.ping;
+        pQuickStatus->m_flConnectionQualityLocal = 1.0 - stats.loss;
+        pQuickStatus->m_flConnectionQualityRemote = 1.0 - stats.loss;
+        pQuickStatus->m_flOutPacketsPerSec = stats.out_packets_per_sec;
+        pQuickStatus->m_flOutBytesPerSec = stats.out_bytes_per_sec;
+        pQuickStatus->m_flInPacketsPerSec = stats.in_packets_per_sec;
+        pQuickStatus->m_flInBytesPerSec = stats.in_bytes_per_sec;
         //TODO
     }
 
@@ -379,6 +432,16 @@ void end_connection(CSteamID steam_id)
     }
 }
 
+void receive_data(CSteamID source_id, const Steam_Message_Connection &conn, int channel, std::string &&data)
+{
+    Steam_Message_Pending pending;
+    pending.remote_id = source_id;
+    pending.conn_id = conn.id;
+    pending.data = std::move(data);
+    pending.time_received = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - created).count();
+    inbox[channel].push_back(std::move(pending));
+}
+
 void RunCallbacks()
 {
     auto msg = std::begin(incoming_data);
@@ -387,8 +450,9 @@ void RunCallbacks()
 
         auto conn = connections.find(source_id);
         if (conn != connections.end()) {
-            if (conn->second.remote_id == msg->networking_messages().id_from())
-                conn->second.data[msg->networking_messages().channel()].push(msg->networking_messages().data());
+            if (conn->second.remote_id == msg->networking_messages().id_from()) {
+                receive_data(source_id, conn->second, msg->networking_messages().channel(), std::move(*msg->mutable_networking_messages()->mutable_data()));
+            }
         }
 
         msg = incoming_data.erase(msg);
@@ -397,6 +461,7 @@ void RunCallbacks()
     auto conn = std::begin(connections);
     while (conn != std::end(connections)) {
         if (!conn->second.accepted && check_timedout(conn->second.created, NETWORKING_MESSAGES_TIMEOUT)) {
+            drop_pending_messages(conn->first);
             conn = connections.erase(conn);
         } else {
             ++conn;
@@ -438,7 +503,19 @@ void Callback(Common_Message *msg)
         }
 
         if (msg->networking_messages().type() == Networking_Messages::DATA) {
-            incoming_data.push_back(Common_Message(*msg));
+            CSteamID source_id((uint64)msg->source_id());
+            auto conn = connections.find(source_id);
+            //both sides opened the session at once and the CONNECTION_NEW got lost (sent before the tcp connection was up)
+            if (conn != connections.end() && conn->second.remote_id == 0 && !conn->second.dead) {
+                conn->second.remote_id = msg->networking_messages().id_from();
+            }
+
+            if (incoming_data.empty() && conn != connections.end() && conn->second.remote_id == msg->networking_messages().id_from()) {
+                //established connection, readable right away instead of after the next RunCallbacks
+                receive_data(source_id, conn->second, msg->networking_messages().channel(), std::string(msg->networking_messages().data()));
+            } else {
+                incoming_data.push_back(Common_Message(*msg));
+            }
         }
     }
 }
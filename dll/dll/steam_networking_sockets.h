@@ -88,6 +88,7 @@ public ISteamNetworkingSockets
 
     struct shared_between_client_server *s;
     std::chrono::steady_clock::time_point created;
+    Message_Arena message_arena;
 
     static const int SNS_DISABLED_PORT = -1;
 
@@ -754,23 +755,25 @@ EResult SendMessageToConnection( HSteamNetConnection hConn, const void *pData, u
     if (connect_socket->second.status == CONNECT_SOCKET_TIMEDOUT) return k_EResultNoConnection;
     if (connect_socket->second.status != CONNECT_SOCKET_CONNECTED && connect_socket->second.status != CONNECT_SOCKET_CONNECTING) return k_EResultInvalidState;
 
-    Common_Message msg;
-    msg.set_source_id(connect_socket->second.created_by.ConvertToUint64());
-    msg.set_dest_id(connect_socket->second.remote_identity.GetSteamID64());
-    msg.set_allocated_networking_sockets(new Networking_Sockets);
-    msg.mutable_networking_sockets()->set_type(Networking_Sockets::DATA);
-    msg.mutable_networking_sockets()->set_virtual_port(connect_socket->second.virtual_port);
-    msg.mutable_networking_sockets()->set_real_port(connect_socket->second.real_port);
-    msg.mutable_networking_sockets()->set_connection_id_from(connect_socket->first);
-    msg.mutable_networking_sockets()->set_connection_id(connect_socket->second.remote_id);
-    msg.mutable_networking_sockets()->set_data(pData, cbData);
+    Message_Arena::Scope scope(message_arena);
+    Common_Message *msg = scope.create<Common_Message>();
+    msg->set_source_id(connect_socket->second.created_by.ConvertToUint64());
+    msg->set_dest_id(connect_socket->second.remote_identity.GetSteamID64());
+    Networking_Sockets *sockets_msg = scope.create<Networking_Sockets>();
+    sockets_msg->set_type(Networking_Sockets::DATA);
+    sockets_msg->set_virtual_port(connect_socket->second.virtual_port);
+    sockets_msg->set_real_port(connect_socket->second.real_port);
+    sockets_msg->set_connection_id_from(connect_socket->first);
+    sockets_msg->set_connection_id(connect_socket->second.remote_id);
+    sockets_msg->set_data(pData, cbData);
     uint64 message_number = connect_socket->second.packet_send_counter;
-    msg.mutable_networking_sockets()->set_message_number(message_number);
+    sockets_msg->set_message_number(message_number);
+    msg->set_allocated_networking_sockets(sockets_msg);
     connect_socket->second.packet_send_counter += 1;
 
     bool reliable = false;
     if (nSendFlags & k_nSteamNetworkingSend_Reliable) reliable = true;
-    if (network->sendTo(&msg, reliable)) {
+    if (network->sendTo(msg, reliable)) {
         if (pOutMessageNumber) *pOutMessageNumber = message_number;
         return k_EResultOK;
     }
@@ -990,15 +993,19 @@ EResult GetConnectionRealTimeStatus( HSteamNetConnection hConn, SteamNetConnecti
     if (connect_socket == s->connect_sockets.end()) return k_EResultNoConnection;
 
     if (pStatus) {
+        //connections to ourselves and peers that weren't measured yet get the old made up numbers
+        struct Link_Stats stats = {10, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+        if (!network->getLinkStats(connect_socket->second.remote_identity.GetSteamID(), &stats) || stats.ping < 0) stats.ping = 10;
+
         pStatus->m_eState = convert_status(connect_socket->second.status);
-        pStatus->m_nPing = 10; //TODO: calculate real numbers?
-        pStatus->m_flConnectionQualityLocal = 1.0;
-        pStatus->m_flConnectionQualityRemote = 1.0;
-        //TODO: rest
-        pStatus->m_flOutPacketsPerSec = 0.0;
-        pStatus->m_flOutBytesPerSec = 0.0;
-        pStatus->m_flInPacketsPerSec = 0.0;
-        pStatus->m_flInBytesPerSec = 0.0;
+        pStatus->m_nPing = stats.ping;
+        pStatus->m_flConnectionQualityLocal = 1.0 - stats.loss;
+        pStatus->m_flConnectionQualityRemote = 1.0 - stats.loss;
+        //the rates are the ones of the whole link to that peer
+        pStatus->m_flOutPacketsPerSec = stats.out_packets_per_sec;
+        pStatus->m_flOutBytesPerSec = stats.out_bytes_per_sec;
+        pStatus->m_flInPacketsPerSec = stats.in_packets_per_sec;
+        pStatus->m_flInBytesPerSec = stats.in_bytes_per_sec;
         pStatus->m_cbSentUnackedReliable = 0.0;
         pStatus->m_usecQueueTime = 0.0;
 
@@ -1079,7 +1086,25 @@ bool GetQuickConnectionStatus( HSteamNetConnection hConn, SteamNetworkingQuickCo
 int GetDetailedConnectionStatus( HSteamNetConnection hConn, char *pszBuf, int cbBuf )
 {
     PRINT_DEBUG("Steam_Networking_Sockets::GetDetailedConnectionStatus\n");
-    return -1;
+    std::lock_guard<std::recursive_mutex> lock(global_mutex);
+    auto connect_socket = s->connect_sockets.find(hConn);
+    if (connect_socket == s->connect_sockets.end()) return -1;
+
+    CSteamID remote_id = connect_socket->second.remote_identity.GetSteamID();
+    std::string status = "Connection " + std::to_string(hConn) + " to " + std::to_string(remote_id.ConvertToUint64()) + "\n";
+    struct Link_Stats stats;
+    if (network->getLinkStats(remote_id, &stats)) {
+        status += Networking::linkStatsString(stats) + "\n";
+    } else {
+        status += "no link measurements\n";
+    }
+
+    if (!pszBuf || cbBuf <= 0) return status.size() + 1;
+
+    int copied = std::min((int)status.size(), cbBuf - 1);
+    memcpy(pszBuf, status.c_str(), copied);
+    pszBuf[copied] = '\0';
+    return copied == (int)status.size() ? 0 : status.size() + 1;
 }
 
 /// Returns local IP and port that a listen socket created using CreateListenSocketIP is bound to.
@@ -28,6 +28,8 @@ public ISteamNetworkingUtils
     class SteamCallResults *callback_results;
     class SteamCallBacks *callbacks;
     class RunEveryRunCB *run_every_runcb;
+
+    static constexpr char ping_location_tag[4] = {'l', 'a', 'n', 0};
     std::chrono::time_point<std::chrono::steady_clock> initialized_time = std::chrono::steady_clock::now();
     FSteamNetworkingSocketsDebugOutput debug_function;
     bool relay_initialized = false;
@@ -159,12 +161,42 @@ ESteamNetworkingAvailability GetRelayNetworkStatus( SteamRelayNetworkStatus_t *p
     return k_ESteamNetworkingAvailability_Current;
 }
 
+// a ping location is the steam id of its user, the ping to it is the one measured by Networking
+void set_ping_location(SteamNetworkPingLocation_t &location, CSteamID steam_id)
+{
+    memset(&location, 0, sizeof(location));
+    memcpy(location.m_data, ping_location_tag, sizeof(ping_location_tag));
+    uint64 id = steam_id.ConvertToUint64();
+    memcpy(location.m_data + 8, &id, sizeof(id));
+}
+
+CSteamID get_ping_location(const SteamNetworkPingLocation_t &location)
+{
+    if (memcmp(location.m_data, ping_location_tag, sizeof(ping_location_tag)) != 0) return k_steamIDNil;
+
+    uint64 id;
+    memcpy(&id, location.m_data + 8, sizeof(id));
+    return CSteamID(id);
+}
+
+// milliseconds, -1 if it's unknown
+int ping_to_location(const SteamNetworkPingLocation_t &location)
+{
+    CSteamID steam_id = get_ping_location(location);
+    if (!steam_id.IsValid()) return -1;
+    if (steam_id == settings->get_local_steam_id()) return 0;
+
+    struct Link_Stats stats;
+    if (!network->getLinkStats(steam_id, &stats)) return -1;
+    return stats.ping;
+}
+
 float GetLocalPingLocation( SteamNetworkPingLocation_t &result )
 {
     PRINT_DEBUG("Steam_Networking_Utils::GetLocalPingLocation\n");
+    std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (relay_initialized) {
-        result.m_data[2] = 123;
-        result.m_data[8] = 67;
+        set_ping_location(result, settings->get_local_steam_id());
         return 2.0;
     }
 
@@ -174,6 +206,12 @@ float GetLocalPingLocation( SteamNetworkPingLocation_t &result )
 int EstimatePingTimeBetweenTwoLocations( const SteamNetworkPingLocation_t &location1, const SteamNetworkPingLocation_t &location2 )
 {
     PRINT_DEBUG("Steam_Networking_Utils::EstimatePingTimeBetweenTwoLocations\n");
+    std::lock_guard<std::recursive_mutex> lock(global_mutex);
+    int ping1 = ping_to_location(location1), ping2 = ping_to_location(location2);
+    if (ping1 == 0 && ping2 >= 0) return ping2;
+    if (ping2 == 0 && ping1 >= 0) return ping1;
+    //two other peers, on a lan both go through the same switch as us
+    if (ping1 >= 0 && ping2 >= 0) return (ping1 + ping2) / 2;
     //return k_nSteamNetworkingPing_Unknown;
     return 10;
 }
@@ -182,6 +220,9 @@ int EstimatePingTimeBetweenTwoLocations( const SteamNetworkPingLocation_t &locat
 int EstimatePingTimeFromLocalHost( const SteamNetworkPingLocation_t &remoteLocation )
 {
     PRINT_DEBUG("Steam_Networking_Utils::EstimatePingTimeFromLocalHost\n");
+    std::lock_guard<std::recursive_mutex> lock(global_mutex);
+    int ping = ping_to_location(remoteLocation);
+    if (ping >= 0) return ping;
     return 10;
 }
 
@@ -189,13 +230,25 @@ int EstimatePingTimeFromLocalHost( const SteamNetworkPingLocation_t &remoteLocat
 void ConvertPingLocationToString( const SteamNetworkPingLocation_t &location, char *pszBuf, int cchBufSize )
 {
     PRINT_DEBUG("Steam_Networking_Utils::ConvertPingLocationToString\n");
-    strncpy(pszBuf, "fra=10+2", cchBufSize);
+    if (!pszBuf || cchBufSize <= 0) return;
+
+    CSteamID steam_id = get_ping_location(location);
+    if (steam_id.IsValid()) {
+        snprintf(pszBuf, cchBufSize, "lan=%s", std::to_string(steam_id.ConvertToUint64()).c_str());
+    } else {
+        strncpy(pszBuf, "fra=10+2", cchBufSize);
+        pszBuf[cchBufSize - 1] = '\0';
+    }
 }
 
 
 bool ParsePingLocationString( const char *pszString, SteamNetworkPingLocation_t &result )
 {
     PRINT_DEBUG("Steam_Networking_Utils::ParsePingLocationString\n");
+    if (pszString && strncmp(pszString, "lan=", 4) == 0) {
+        set_ping_location(result, CSteamID((uint64)std::strtoull(pszString + 4, nullptr, 10)));
+    }
+
     return true;
 }
 
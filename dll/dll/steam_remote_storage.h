@@ -478,7 +478,7 @@ SteamAPICall_t UGCDownload( UGCHandle_t hContent, uint32 unPriority )
         downloaded_files[hContent].file = shared_files[hContent];
         downloaded_files[hContent].total_size = data.m_nSizeInBytes;
     } else if (auto query_res = ugc_bridge->get_ugc_query_result(hContent)) {
-        auto mod = settings->getMod(query_res.value().mod_id);
+        auto &mod = settings->getMod(query_res.value().mod_id);
         auto &mod_name = query_res.value().is_primary_file
             ? mod.primaryFileName
             : mod.previewFileName;
@@ -578,7 +578,7 @@ int32 UGCRead( UGCHandle_t hContent, void *pvData, int32 cubDataToRead, uint32 c
     case Downloaded_File::DownloadSource::FromUGCDownloadToLocation:
     {
         PRINT_DEBUG("  Steam_Remote_Storage::UGCRead source = AfterSendQueryUGCRequest || FromUGCDownloadToLocation [%i]\n", (int)f.source);
-        auto mod = settings->getMod(f.mod_query_info.mod_id);
+        auto &mod = settings->getMod(f.mod_query_info.mod_id);
         auto &mod_name = f.mod_query_info.is_primary_file
             ? mod.primaryFileName
             : mod.previewFileName;
@@ -822,7 +822,7 @@ SteamAPICall_t GetPublishedFileDetails( PublishedFileId_t unPublishedFileId, uin
     data.m_nPublishedFileId = unPublishedFileId;
 
     if (settings->isModInstalled(unPublishedFileId)) {
-        auto mod = settings->getMod(unPublishedFileId);
+        auto &mod = settings->getMod(unPublishedFileId);
         data.m_eResult = EResult::k_EResultOK;
         data.m_bAcceptedForUse = mod.acceptedForUse;
         data.m_bBanned = mod.banned;
@@ -890,7 +890,7 @@ SteamAPICall_t EnumerateUserPublishedFiles( uint32 unStartIndex )
     auto mods = settings->modSet();
     std::vector<PublishedFileId_t> user_pubed{};
     for (auto& id : mods) {
-        auto mod = settings->getMod(id);
+        auto &mod = settings->getMod(id);
         if (mod.steamIDOwner == settings->get_local_steam_id().ConvertToUint64()) {
             user_pubed.push_back(id);
         }
@@ -907,7 +907,6 @@ SteamAPICall_t EnumerateUserPublishedFiles( uint32 unStartIndex )
         uint32_t iterated = 0;
         for (; i != user_pubed.end() && iterated < k_unEnumeratePublishedFilesMaxResults; i++) {
             PublishedFileId_t modId = *i;
-            auto mod = settings->getMod(modId);
             data.m_rgPublishedFileId[iterated] = modId;
             iterated++;
             PRINT_DEBUG("  EnumerateUserPublishedFiles file %llu\n", modId);
@@ -958,7 +957,7 @@ SteamAPICall_t EnumerateUserSubscribedFiles( uint32 unStartIndex )
         uint32_t iterated = 0;
         for (; i != ugc_bridge->subbed_mods_itr_end() && iterated < k_unEnumeratePublishedFilesMaxResults; i++) {
             PublishedFileId_t modId = *i;
-            auto mod = settings->getMod(modId);
+            auto &mod = settings->getMod(modId);
             uint32 time = mod.timeAddedToUserList; //this can be changed, default is 1554997000
             data.m_rgPublishedFileId[iterated] = modId;
             data.m_rgRTimeSubscribed[iterated] = time;
@@ -1012,7 +1011,7 @@ SteamAPICall_t GetPublishedItemVoteDetails( PublishedFileId_t unPublishedFileId
     data.m_unPublishedFileId = unPublishedFileId;
     if (settings->isModInstalled(unPublishedFileId)) {
         data.m_eResult = EResult::k_EResultOK;
-        auto mod = settings->getMod(unPublishedFileId);
+        auto &mod = settings->getMod(unPublishedFileId);
         data.m_fScore = mod.score;
         data.m_nReports = 0; // TODO is this ok?
         data.m_nVotesAgainst = mod.votesDown;
@@ -1037,7 +1036,7 @@ SteamAPICall_t UpdateUserPublishedItemVote( PublishedFileId_t unPublishedFileId,
     RemoteStorageUpdateUserPublishedItemVoteResult_t data{};
     data.m_nPublishedFileId = unPublishedFileId;
     if (settings->isModInstalled(unPublishedFileId)) {
-        auto mod = settings->getMod(unPublishedFileId);
+        auto &mod = settings->getMod(unPublishedFileId);
         if (mod.steamIDOwner == settings->get_local_steam_id().ConvertToUint64()) {
             data.m_eResult = EResult::k_EResultOK;
         } else { // not published by this user
@@ -1062,7 +1061,7 @@ SteamAPICall_t GetUserPublishedItemVoteDetails( PublishedFileId_t unPublishedFil
     RemoteStorageGetPublishedItemVoteDetailsResult_t data{};
     data.m_unPublishedFileId = unPublishedFileId;
     if (settings->isModInstalled(unPublishedFileId)) {
-        auto mod = settings->getMod(unPublishedFileId);
+        auto &mod = settings->getMod(unPublishedFileId);
         if (mod.steamIDOwner == settings->get_local_steam_id().ConvertToUint64()) {
             data.m_eResult = EResult::k_EResultOK;
             data.m_fScore = mod.score;
@@ -1164,7 +1163,7 @@ SteamAPICall_t UGCDownloadToLocation( UGCHandle_t hContent, const char *pchLocat
 
     auto query_res = ugc_bridge->get_ugc_query_result(hContent);
     if (query_res) {
-        auto mod = settings->getMod(query_res.value().mod_id);
+        auto &mod = settings->getMod(query_res.value().mod_id);
         auto &mod_name = query_res.value().is_primary_file
             ? mod.primaryFileName
             : mod.previewFileName;
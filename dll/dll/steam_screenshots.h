@@ -23,18 +23,57 @@ struct screenshot_infos_t
 	nlohmann::json metadatas;
 };
 
+// a screenshot waiting to be written by a worker
+struct Screenshot_Job
+{
+	ScreenshotHandle handle;
+	// relative to the screenshots folder, with the extension
+	std::string file_name;
+	std::string thumbnail_name;
+	// copy of the game's RGB frame, empty when source_path is set instead
+	std::string pixels;
+	int width, height;
+	// image already in the library, only its thumbnail is left to make
+	std::string source_path;
+};
+
 class Steam_Screenshots : public ISteamScreenshots
 {
     bool hooked = false;
 	std::map<ScreenshotHandle, screenshot_infos_t> _screenshots;
+	std::string last_screenshot_name;
+	unsigned last_screenshot_count = 0;
 
+	class Settings* settings;
 	class Local_Storage* local_storage;
 	class SteamCallBacks* callbacks;
+	class RunEveryRunCB* run_every_runcb;
+
+	// the images are encoded on these threads so the game only pays for the copy of the frame
+	// the results are posted as ScreenshotReady_t by RunCallbacks
+	std::vector<std::thread> workers;
+	std::mutex jobs_mutex;
+	std::condition_variable jobs_cv;
+	std::queue<Screenshot_Job> jobs;
+	std::vector<std::pair<ScreenshotHandle, EResult>> finished_jobs;
+	bool stop_workers = false;
 
 	ScreenshotHandle create_screenshot_handle();
+	std::string create_screenshot_name();
+	void queue_job(Screenshot_Job &&job);
+	EResult run_job(Screenshot_Job &job);
+	static void worker_thread(Steam_Screenshots *steam_screenshots);
 
 public:
-	Steam_Screenshots(class Local_Storage* local_storage, class SteamCallBacks* callbacks);
+	// thumbnails are this wide, like steam's
+	static constexpr int thumbnail_width = 200;
+
+	static void steam_run_every_runcb(void *object);
+
+	Steam_Screenshots(class Settings* settings, class Local_Storage* local_storage, class SteamCallBacks* callbacks, class RunEveryRunCB* run_every_runcb);
+	~Steam_Screenshots();
+
+	void RunCallbacks();
 
 	// Writes a screenshot to the user's screenshot library given the raw image data, which must be in RGB format.
 	// The return value is a handle that is valid for the duration of the game process and can be used to apply tags.
@@ -16,13 +16,23 @@
    <http://www.gnu.org/licenses/>.  */
 
 #include "base.h"
+#include "ugc_catalog.h"
 
 struct UGC_query {
     UGCQueryHandle_t handle;
-    std::set<PublishedFileId_t> return_only;
+    std::vector<PublishedFileId_t> return_only;
     bool return_all_subscribed;
-
-    std::set<PublishedFileId_t> results;
+    bool return_all;
+    // 1 based, 0 returns every result at once
+    uint32 page;
+    // the query was created with a cursor, the next one is returned with the results
+    bool cursor;
+    Ugc_Catalog::Sort sort;
+    Ugc_Catalog::Filter filter;
+
+    uint32 total_matching;
+    // results of the requested page
+    std::vector<PublishedFileId_t> results;
 };
 
 class Steam_UGC :
@@ -53,12 +63,19 @@ public ISteamUGC
     class SteamCallBacks *callbacks;
 
     UGCQueryHandle_t handle = 50; // just makes debugging easier, any initial val is fine, even 1
-    std::vector<struct UGC_query> ugc_queries{};
+    std::unordered_map<UGCQueryHandle_t, struct UGC_query> ugc_queries{};
     std::set<PublishedFileId_t> favorites{};
 
+    // built on the first query, the mods don't change while the game runs
+    Ugc_Catalog catalog{};
+    bool catalog_built = false;
+
 UGCQueryHandle_t new_ugc_query(
     bool return_all_subscribed = false,
-    std::set<PublishedFileId_t> return_only = std::set<PublishedFileId_t>())
+    bool return_all = false,
+    uint32 page = 0,
+    Ugc_Catalog::Sort sort = Ugc_Catalog::Sort::NONE,
+    std::vector<PublishedFileId_t> return_only = std::vector<PublishedFileId_t>())
 {
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     
@@ -68,10 +85,60 @@ UGCQueryHandle_t new_ugc_query(
     struct UGC_query query{};
     query.handle = handle;
     query.return_all_subscribed = return_all_subscribed;
-    query.return_only = return_only;
-    ugc_queries.push_back(query);
-    PRINT_DEBUG("Steam_UGC::new_ugc_query handle = %llu\n", query.handle);
-    return query.handle;
+    query.return_all = return_all;
+    query.page = page;
+    query.sort = sort;
+    query.return_only = std::move(return_only);
+    ugc_queries[handle] = std::move(query);
+    PRINT_DEBUG("Steam_UGC::new_ugc_query handle = %llu\n", handle);
+    return handle;
+}
+
+struct UGC_query *get_query(UGCQueryHandle_t handle)
+{
+    auto it = ugc_queries.find(handle);
+    if (ugc_queries.end() == it) return nullptr;
+    return &it->second;
+}
+
+const Ugc_Catalog &get_catalog()
+{
+    if (!catalog_built) {
+        catalog.build(settings->getModTable()->entries);
+        catalog_built = true;
+    }
+
+    return catalog;
+}
+
+static Ugc_Catalog::Sort query_sort(EUGCQuery eQueryType)
+{
+    switch (eQueryType) {
+    case k_EUGCQuery_RankedByVote:
+    case k_EUGCQuery_RankedByVotesUp:
+        return Ugc_Catalog::Sort::VOTES_DESC;
+    case k_EUGCQuery_RankedByPublicationDate:
+    case k_EUGCQuery_AcceptedForGameRankedByAcceptanceDate:
+        return Ugc_Catalog::Sort::CREATED_DESC;
+    case k_EUGCQuery_RankedByLastUpdatedDate:
+        return Ugc_Catalog::Sort::UPDATED_DESC;
+    default:
+        return Ugc_Catalog::Sort::NONE;
+    }
+}
+
+static Ugc_Catalog::Sort user_list_sort(EUserUGCListSortOrder eSortOrder)
+{
+    switch (eSortOrder) {
+    case k_EUserUGCListSortOrder_CreationOrderDesc:
+        return Ugc_Catalog::Sort::CREATED_DESC;
+    case k_EUserUGCListSortOrder_LastUpdatedDesc:
+        return Ugc_Catalog::Sort::UPDATED_DESC;
+    case k_EUserUGCListSortOrder_VoteScoreDesc:
+        return Ugc_Catalog::Sort::VOTES_DESC;
+    default:
+        return Ugc_Catalog::Sort::NONE;
+    }
 }
 
 void set_details(PublishedFileId_t id, SteamUGCDetails_t *pDetails)
@@ -85,7 +152,7 @@ void set_details(PublishedFileId_t id, SteamUGCDetails_t *pDetails)
             PRINT_DEBUG("  mod is installed, setting details\n");
             pDetails->m_eResult = k_EResultOK;
 
-            auto mod = settings->getMod(id);
+            auto &mod = settings->getMod(id);
             pDetails->m_bAcceptedForUse = mod.acceptedForUse;
             pDetails->m_bBanned = mod.banned;
             pDetails->m_bTagsTruncated = mod.tagsTruncated;
@@ -182,7 +249,7 @@ UGCQueryHandle_t CreateQueryUserUGCRequest( AccountID_t unAccountID, EUserUGCLis
     if (unAccountID != settings->get_local_steam_id().GetAccountID()) return k_UGCQueryHandleInvalid;
     
     // TODO
-    return new_ugc_query(eListType == k_EUserUGCList_Subscribed || eListType == k_EUserUGCList_Published);
+    return new_ugc_query(eListType == k_EUserUGCList_Subscribed || eListType == k_EUserUGCList_Published, false, unPage, user_list_sort(eSortOrder));
 }
 
 
@@ -196,8 +263,7 @@ UGCQueryHandle_t CreateQueryAllUGCRequest( EUGCQuery eQueryType, EUGCMatchingUGC
     if (unPage < 1) return k_UGCQueryHandleInvalid;
     if (eQueryType < 0) return k_UGCQueryHandleInvalid;
     
-    // TODO
-    return new_ugc_query();
+    return new_ugc_query(false, true, unPage, query_sort(eQueryType));
 }
 
 // Query for all matching UGC using the new deep paging interface. Creator app id or consumer app id must be valid and be set to the current running app. pchCursor should be set to NULL or "*" to get the first result set.
@@ -209,8 +275,16 @@ UGCQueryHandle_t CreateQueryAllUGCRequest( EUGCQuery eQueryType, EUGCMatchingUGC
     if (nCreatorAppID != settings->get_local_game_id().AppID() || nConsumerAppID != settings->get_local_game_id().AppID()) return k_UGCQueryHandleInvalid;
     if (eQueryType < 0) return k_UGCQueryHandleInvalid;
     
-    // TODO
-    return new_ugc_query();
+    // the cursor is the page number as a string, "*" is the first page
+    uint32 page = 1;
+    if (pchCursor && pchCursor[0] && strcmp(pchCursor, "*") != 0) {
+        page = (uint32)strtoul(pchCursor, nullptr, 10);
+        if (page < 1) return k_UGCQueryHandleInvalid;
+    }
+
+    UGCQueryHandle_t query_handle = new_ugc_query(false, true, page, query_sort(eQueryType));
+    get_query(query_handle)->cursor = true;
+    return query_handle;
 }
 
 // Query for the details of the given published file ids (the RequestUGCDetails call is deprecated and replaced with this)
@@ -223,8 +297,8 @@ UGCQueryHandle_t CreateQueryUGCDetailsRequest( PublishedFileId_t *pvecPublishedF
     if (unNumPublishedFileIDs < 1) return k_UGCQueryHandleInvalid;
     
     // TODO
-    std::set<PublishedFileId_t> only(pvecPublishedFileID, pvecPublishedFileID + unNumPublishedFileIDs);
-    return new_ugc_query(false, only);
+    std::vector<PublishedFileId_t> only(pvecPublishedFileID, pvecPublishedFileID + unNumPublishedFileIDs);
+    return new_ugc_query(false, false, 0, Ugc_Catalog::Sort::NONE, std::move(only));
 }
 
 
@@ -236,26 +310,43 @@ SteamAPICall_t SendQueryUGCRequest( UGCQueryHandle_t handle )
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return k_uAPICallInvalid;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request)
+    auto request = get_query(handle);
+    if (!request)
         return k_uAPICallInvalid;
 
-    if (request->return_all_subscribed) {
-        request->results = std::set<PublishedFileId_t>(ugc_bridge->subbed_mods_itr_begin(), ugc_bridge->subbed_mods_itr_end());
-    }
+    const Ugc_Catalog &mods_catalog = get_catalog();
+    std::vector<PublishedFileId_t> matching{};
+    if (request->return_all) {
+        matching = mods_catalog.query(request->filter, request->sort);
+    } else {
+        std::vector<PublishedFileId_t> candidates{};
+        if (request->return_all_subscribed) {
+            candidates.assign(ugc_bridge->subbed_mods_itr_begin(), ugc_bridge->subbed_mods_itr_end());
+        }
 
-    if (request->return_only.size()) {
+        std::set<PublishedFileId_t> added(candidates.begin(), candidates.end());
         for (auto & s : request->return_only) {
-            if (ugc_bridge->has_subbed_mod(s)) {
-                request->results.insert(s);
+            if (ugc_bridge->has_subbed_mod(s) && added.insert(s).second) {
+                candidates.push_back(s);
             }
         }
+
+        matching = mods_catalog.query(request->filter, request->sort, &candidates);
+    }
+
+    request->total_matching = (uint32)matching.size();
+    if (request->page) {
+        size_t first = std::min((size_t)(request->page - 1) * kNumUGCResultsPerPage, matching.size());
+        size_t last = std::min(first + kNumUGCResultsPerPage, matching.size());
+        request->results.assign(matching.begin() + first, matching.begin() + last);
+    } else {
+        request->results = std::move(matching);
     }
 
     // send these handles to stea_remote_storage since the game will later
     // call Steam_Remote_Storage::UGCDownload() with these files handles (primary + preview)
     for (auto fileid : request->results) {
-        auto mod = settings->getMod(fileid);
+        auto &mod = settings->getMod(fileid);
         ugc_bridge->add_ugc_query_result(mod.handleFile, fileid, true);
         ugc_bridge->add_ugc_query_result(mod.handlePreviewFile, fileid, false);
     }
@@ -264,8 +355,12 @@ SteamAPICall_t SendQueryUGCRequest( UGCQueryHandle_t handle )
     data.m_handle = handle;
     data.m_eResult = k_EResultOK;
     data.m_unNumResultsReturned = request->results.size();
-    data.m_unTotalMatchingResults = request->results.size();
+    data.m_unTotalMatchingResults = request->total_matching;
     data.m_bCachedData = false;
+    if (request->cursor && (size_t)request->page * kNumUGCResultsPerPage < request->total_matching) {
+        std::string next_cursor = std::to_string(request->page + 1);
+        next_cursor.copy(data.m_rgchNextCursor, sizeof(data.m_rgchNextCursor) - 1);
+    }
     return callback_results->addCallResult(data.k_iCallback, &data, sizeof(data));
 }
 
@@ -277,8 +372,8 @@ bool GetQueryUGCResult( UGCQueryHandle_t handle, uint32 index, SteamUGCDetails_t
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) {
+    auto request = get_query(handle);
+    if (!request) {
         return false;
     }
 
@@ -286,53 +381,42 @@ bool GetQueryUGCResult( UGCQueryHandle_t handle, uint32 index, SteamUGCDetails_t
         return false;
     }
 
-    auto it = request->results.begin();
-    std::advance(it, index);
-    PublishedFileId_t file_id = *it;
-    set_details(file_id, pDetails);
+    set_details(request->results[index], pDetails);
     return true;
 }
 
-std::optional<Mod_entry> get_query_ugc(UGCQueryHandle_t handle, uint32 index) {
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return std::nullopt;
-    if (index >= request->results.size()) return std::nullopt;
+// nullptr if the result doesn't exist
+const Mod_entry *get_query_ugc(UGCQueryHandle_t handle, uint32 index) {
+    auto request = get_query(handle);
+    if (!request) return nullptr;
+    if (index >= request->results.size()) return nullptr;
 
-    auto it = request->results.begin();
-    std::advance(it, index);
-    
-    PublishedFileId_t file_id = *it;
-    if (!settings->isModInstalled(file_id)) return std::nullopt;
+    PublishedFileId_t file_id = request->results[index];
+    if (!settings->isModInstalled(file_id)) return nullptr;
 
-    return settings->getMod(file_id);
+    return &settings->getMod(file_id);
 }
 
-std::optional<std::vector<std::string>> get_query_ugc_tags(UGCQueryHandle_t handle, uint32 index) {
-    auto res = get_query_ugc(handle, index);
-    if (!res.has_value()) return std::nullopt;
+const std::vector<std::string> *get_query_ugc_tags(UGCQueryHandle_t handle, uint32 index) {
+    auto mod = get_query_ugc(handle, index);
+    if (!mod) return nullptr;
 
-    auto tags_tokens = std::vector<std::string>{};
-    std::stringstream ss(res.value().tags);
-    std::string tmp{};
-    while(ss >> tmp) {
-        if (tmp.back() == ',') tmp = tmp.substr(0, tmp.size() - 1);
-        tags_tokens.push_back(tmp);
-    }
+    return get_catalog().get_tags(mod->id);
+}
 
-    return tags_tokens;
+const std::string *get_query_ugc_tag(UGCQueryHandle_t handle, uint32 index, uint32 indexTag) {
+    auto tags = get_query_ugc_tags(handle, index);
+    if (!tags) return nullptr;
+    if (indexTag >= tags->size()) return nullptr;
 
+    return &(*tags)[indexTag];
 }
 
-std::optional<std::string> get_query_ugc_tag(UGCQueryHandle_t handle, uint32 index, uint32 indexTag) {
-    auto res = get_query_ugc_tags(handle, index);
-    if (!res.has_value()) return std::nullopt;
-    if (indexTag >= res.value().size()) return std::nullopt;
+const std::vector<std::pair<std::string, std::string>> *get_query_ugc_key_value_tags(UGCQueryHandle_t handle, uint32 index) {
+    auto mod = get_query_ugc(handle, index);
+    if (!mod) return nullptr;
 
-    std::string tmp = res.value()[indexTag];
-    if (tmp.back() == ',') {
-        tmp = tmp.substr(0, tmp.size() - 1);
-    }
-    return tmp;
+    return get_catalog().get_key_value_tags(mod->id);
 }
 
 uint32 GetQueryUGCNumTags( UGCQueryHandle_t handle, uint32 index )
@@ -343,7 +427,7 @@ uint32 GetQueryUGCNumTags( UGCQueryHandle_t handle, uint32 index )
     if (handle == k_UGCQueryHandleInvalid) return 0;
     
     auto res = get_query_ugc_tags(handle, index);
-    return res.has_value() ? res.value().size() : 0;
+    return res ? (uint32)res->size() : 0;
 }
 
 bool GetQueryUGCTag( UGCQueryHandle_t handle, uint32 index, uint32 indexTag, STEAM_OUT_STRING_COUNT( cchValueSize ) char* pchValue, uint32 cchValueSize )
@@ -355,10 +439,10 @@ bool GetQueryUGCTag( UGCQueryHandle_t handle, uint32 index, uint32 indexTag, STE
     if (!pchValue || !cchValueSize) return false;
 
     auto res = get_query_ugc_tag(handle, index, indexTag);
-    if (!res.has_value()) return false;
+    if (!res) return false;
 
     memset(pchValue, 0, cchValueSize);
-    res.value().copy(pchValue, cchValueSize - 1);
+    res->copy(pchValue, cchValueSize - 1);
     return true;
 }
 
@@ -371,10 +455,10 @@ bool GetQueryUGCTagDisplayName( UGCQueryHandle_t handle, uint32 index, uint32 in
     if (!pchValue || !cchValueSize) return false;
 
     auto res = get_query_ugc_tag(handle, index, indexTag);
-    if (!res.has_value()) return false;
+    if (!res) return false;
 
     memset(pchValue, 0, cchValueSize);
-    res.value().copy(pchValue, cchValueSize - 1);
+    res->copy(pchValue, cchValueSize - 1);
     return true;
 }
 
@@ -386,12 +470,11 @@ bool GetQueryUGCPreviewURL( UGCQueryHandle_t handle, uint32 index, STEAM_OUT_STR
     if (handle == k_UGCQueryHandleInvalid) return false;
     if (!pchURL || !cchURLSize) return false;
 
-    auto res = get_query_ugc(handle, index);
-    if (!res.has_value()) return false;
+    auto mod = get_query_ugc(handle, index);
+    if (!mod) return false;
 
-    auto mod = res.value();
-    PRINT_DEBUG("Steam_UGC:GetQueryUGCPreviewURL: '%s'\n", mod.previewURL.c_str());
-    mod.previewURL.copy(pchURL, cchURLSize - 1);
+    PRINT_DEBUG("Steam_UGC:GetQueryUGCPreviewURL: '%s'\n", mod->previewURL.c_str());
+    mod->previewURL.copy(pchURL, cchURLSize - 1);
     return true;
 }
 
@@ -402,8 +485,8 @@ bool GetQueryUGCMetadata( UGCQueryHandle_t handle, uint32 index, STEAM_OUT_STRIN
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
+    auto request = get_query(handle);
+    if (!request) return false;
 
     return false;
 }
@@ -415,8 +498,8 @@ bool GetQueryUGCChildren( UGCQueryHandle_t handle, uint32 index, PublishedFileId
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
+    auto request = get_query(handle);
+    if (!request) return false;
     
     return false;
 }
@@ -428,8 +511,8 @@ bool GetQueryUGCStatistic( UGCQueryHandle_t handle, uint32 index, EItemStatistic
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
+    auto request = get_query(handle);
+    if (!request) return false;
     
     return false;
 }
@@ -440,8 +523,8 @@ bool GetQueryUGCStatistic( UGCQueryHandle_t handle, uint32 index, EItemStatistic
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
+    auto request = get_query(handle);
+    if (!request) return false;
     
     return false;
 }
@@ -452,8 +535,8 @@ uint32 GetQueryUGCNumAdditionalPreviews( UGCQueryHandle_t handle, uint32 index )
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return 0;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return 0;
+    auto request = get_query(handle);
+    if (!request) return 0;
     
     return 0;
 }
@@ -465,8 +548,8 @@ bool GetQueryUGCAdditionalPreview( UGCQueryHandle_t handle, uint32 index, uint32
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
+    auto request = get_query(handle);
+    if (!request) return false;
     
     return false;
 }
@@ -477,46 +560,61 @@ bool GetQueryUGCAdditionalPreview( UGCQueryHandle_t handle, uint32 index, uint32
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
+    auto request = get_query(handle);
+    if (!request) return false;
     
     return false;
 }
 
 uint32 GetQueryUGCNumKeyValueTags( UGCQueryHandle_t handle, uint32 index )
 {
-    PRINT_DEBUG("TODO Steam_UGC::GetQueryUGCNumKeyValueTags\n");
+    PRINT_DEBUG("Steam_UGC::GetQueryUGCNumKeyValueTags\n");
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return 0;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return 0;
-    
-    return 0;
+    auto res = get_query_ugc_key_value_tags(handle, index);
+    return res ? (uint32)res->size() : 0;
 }
 
 
 bool GetQueryUGCKeyValueTag( UGCQueryHandle_t handle, uint32 index, uint32 keyValueTagIndex, STEAM_OUT_STRING_COUNT(cchKeySize) char *pchKey, uint32 cchKeySize, STEAM_OUT_STRING_COUNT(cchValueSize) char *pchValue, uint32 cchValueSize )
 {
-    PRINT_DEBUG("TODO Steam_UGC::GetQueryUGCKeyValueTag\n");
+    PRINT_DEBUG("Steam_UGC::GetQueryUGCKeyValueTag\n");
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return false;
+    if (!pchKey || !cchKeySize || !pchValue || !cchValueSize) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
-    
-    return false;
+    auto res = get_query_ugc_key_value_tags(handle, index);
+    if (!res || keyValueTagIndex >= res->size()) return false;
+
+    auto &kv = (*res)[keyValueTagIndex];
+    memset(pchKey, 0, cchKeySize);
+    kv.first.copy(pchKey, cchKeySize - 1);
+    memset(pchValue, 0, cchValueSize);
+    kv.second.copy(pchValue, cchValueSize - 1);
+    return true;
 }
 
 bool GetQueryUGCKeyValueTag( UGCQueryHandle_t handle, uint32 index, const char *pchKey, STEAM_OUT_STRING_COUNT(cchValueSize) char *pchValue, uint32 cchValueSize )
 {
-    PRINT_DEBUG("TODO Steam_UGC::GetQueryUGCKeyValueTag2\n");
+    PRINT_DEBUG("Steam_UGC::GetQueryUGCKeyValueTag2\n");
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return false;
+    if (!pchKey || !pchValue || !cchValueSize) return false;
+
+    auto res = get_query_ugc_key_value_tags(handle, index);
+    if (!res) return false;
+
+    // keys are case insensitive, the first match is returned
+    std::string key = ascii_to_lowercase(pchKey);
+    for (auto &kv : *res) {
+        if (ascii_to_lowercase(kv.first) == key) {
+            memset(pchValue, 0, cchValueSize);
+            kv.second.copy(pchValue, cchValueSize - 1);
+            return true;
+        }
+    }
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
-    
     return false;
 }
 
@@ -526,8 +624,8 @@ uint32 GetQueryUGCContentDescriptors( UGCQueryHandle_t handle, uint32 index, EUG
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return 0;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return 0;
+    auto request = get_query(handle);
+    if (!request) return 0;
     
     return 0;
 }
@@ -539,48 +637,54 @@ bool ReleaseQueryUGCRequest( UGCQueryHandle_t handle )
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
-
-    ugc_queries.erase(request);
-    return true;
+    return ugc_queries.erase(handle) > 0;
 }
 
 
 // Options to set for querying UGC
 bool AddRequiredTag( UGCQueryHandle_t handle, const char *pTagName )
 {
-    PRINT_DEBUG("TODO Steam_UGC::AddRequiredTag\n");
+    PRINT_DEBUG("Steam_UGC::AddRequiredTag\n");
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return false;
+    if (!pTagName) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
+    auto request = get_query(handle);
+    if (!request) return false;
     
+    request->filter.required_tags.push_back(pTagName);
     return true;
 }
 
 bool AddRequiredTagGroup( UGCQueryHandle_t handle, const SteamParamStringArray_t *pTagGroups )
 {
-    PRINT_DEBUG("TODO Steam_UGC::AddRequiredTagGroup\n");
+    PRINT_DEBUG("Steam_UGC::AddRequiredTagGroup\n");
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return false;
+    if (!pTagGroups) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
+    auto request = get_query(handle);
+    if (!request) return false;
     
+    std::vector<std::string> group{};
+    for (int32 i = 0; i < pTagGroups->m_nNumStrings; ++i) {
+        if (pTagGroups->m_ppStrings[i]) group.push_back(pTagGroups->m_ppStrings[i]);
+    }
+    request->filter.required_tag_groups.push_back(std::move(group));
     return true;
 }
 
 bool AddExcludedTag( UGCQueryHandle_t handle, const char *pTagName )
 {
-    PRINT_DEBUG("TODO Steam_UGC::AddExcludedTag\n");
+    PRINT_DEBUG("Steam_UGC::AddExcludedTag\n");
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return false;
+    if (!pTagName) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
+    auto request = get_query(handle);
+    if (!request) return false;
     
+    request->filter.excluded_tags.push_back(pTagName);
     return true;
 }
 
@@ -591,8 +695,8 @@ bool SetReturnOnlyIDs( UGCQueryHandle_t handle, bool bReturnOnlyIDs )
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
+    auto request = get_query(handle);
+    if (!request) return false;
     
     return true;
 }
@@ -603,8 +707,8 @@ bool SetReturnKeyValueTags( UGCQueryHandle_t handle, bool bReturnKeyValueTags )
     PRINT_DEBUG("TODO Steam_UGC::SetReturnKeyValueTags\n");
     if (handle == k_UGCQueryHandleInvalid) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
+    auto request = get_query(handle);
+    if (!request) return false;
     
     return true;
 }
@@ -615,8 +719,8 @@ bool SetReturnLongDescription( UGCQueryHandle_t handle, bool bReturnLongDescript
     PRINT_DEBUG("TODO Steam_UGC::SetReturnLongDescription\n");
     if (handle == k_UGCQueryHandleInvalid) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
+    auto request = get_query(handle);
+    if (!request) return false;
     
     return true;
 }
@@ -628,8 +732,8 @@ bool SetReturnMetadata( UGCQueryHandle_t handle, bool bReturnMetadata )
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
+    auto request = get_query(handle);
+    if (!request) return false;
     
     return true;
 }
@@ -641,8 +745,8 @@ bool SetReturnChildren( UGCQueryHandle_t handle, bool bReturnChildren )
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
+    auto request = get_query(handle);
+    if (!request) return false;
     
     return true;
 }
@@ -654,8 +758,8 @@ bool SetReturnAdditionalPreviews( UGCQueryHandle_t handle, bool bReturnAdditiona
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
+    auto request = get_query(handle);
+    if (!request) return false;
     
     return true;
 }
@@ -667,8 +771,8 @@ bool SetReturnTotalOnly( UGCQueryHandle_t handle, bool bReturnTotalOnly )
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
+    auto request = get_query(handle);
+    if (!request) return false;
     
     return true;
 }
@@ -680,8 +784,8 @@ bool SetReturnPlaytimeStats( UGCQueryHandle_t handle, uint32 unDays )
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
+    auto request = get_query(handle);
+    if (!request) return false;
     
     return true;
 }
@@ -693,8 +797,8 @@ bool SetLanguage( UGCQueryHandle_t handle, const char *pchLanguage )
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
+    auto request = get_query(handle);
+    if (!request) return false;
     
     return true;
 }
@@ -706,8 +810,8 @@ bool SetAllowCachedResponse( UGCQueryHandle_t handle, uint32 unMaxAgeSeconds )
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
+    auto request = get_query(handle);
+    if (!request) return false;
     
     return true;
 }
@@ -720,8 +824,8 @@ bool SetCloudFileNameFilter( UGCQueryHandle_t handle, const char *pMatchCloudFil
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
+    auto request = get_query(handle);
+    if (!request) return false;
     
     return true;
 }
@@ -730,26 +834,29 @@ bool SetCloudFileNameFilter( UGCQueryHandle_t handle, const char *pMatchCloudFil
 // Options only for querying all UGC
 bool SetMatchAnyTag( UGCQueryHandle_t handle, bool bMatchAnyTag )
 {
-    PRINT_DEBUG("TODO Steam_UGC::SetMatchAnyTag\n");
+    PRINT_DEBUG("Steam_UGC::SetMatchAnyTag\n");
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
+    auto request = get_query(handle);
+    if (!request) return false;
     
+    request->filter.match_any_tag = bMatchAnyTag;
     return true;
 }
 
 
 bool SetSearchText( UGCQueryHandle_t handle, const char *pSearchText )
 {
-    PRINT_DEBUG("TODO Steam_UGC::SetSearchText\n");
+    PRINT_DEBUG("Steam_UGC::SetSearchText\n");
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return false;
+    if (!pSearchText) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
+    auto request = get_query(handle);
+    if (!request) return false;
     
+    request->filter.search_text = pSearchText;
     return true;
 }
 
@@ -760,8 +867,8 @@ bool SetRankedByTrendDays( UGCQueryHandle_t handle, uint32 unDays )
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
+    auto request = get_query(handle);
+    if (!request) return false;
     
     return true;
 }
@@ -769,37 +876,43 @@ bool SetRankedByTrendDays( UGCQueryHandle_t handle, uint32 unDays )
 
 bool AddRequiredKeyValueTag( UGCQueryHandle_t handle, const char *pKey, const char *pValue )
 {
-    PRINT_DEBUG("TODO Steam_UGC::AddRequiredKeyValueTag\n");
+    PRINT_DEBUG("Steam_UGC::AddRequiredKeyValueTag\n");
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return false;
+    if (!pKey || !pValue) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
+    auto request = get_query(handle);
+    if (!request) return false;
     
+    request->filter.required_key_value_tags.emplace_back(pKey, pValue);
     return true;
 }
 
 bool SetTimeCreatedDateRange( UGCQueryHandle_t handle, RTime32 rtStart, RTime32 rtEnd )
 {
-    PRINT_DEBUG("TODO Steam_UGC::SetTimeCreatedDateRange\n");
+    PRINT_DEBUG("Steam_UGC::SetTimeCreatedDateRange\n");
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
+    auto request = get_query(handle);
+    if (!request) return false;
     
+    request->filter.created_start = rtStart;
+    request->filter.created_end = rtEnd;
     return true;
 }
 
 bool SetTimeUpdatedDateRange( UGCQueryHandle_t handle, RTime32 rtStart, RTime32 rtEnd )
 {
-    PRINT_DEBUG("TODO Steam_UGC::SetTimeUpdatedDateRange\n");
+    PRINT_DEBUG("Steam_UGC::SetTimeUpdatedDateRange\n");
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (handle == k_UGCQueryHandleInvalid) return false;
 
-    auto request = std::find_if(ugc_queries.begin(), ugc_queries.end(), [&handle](struct UGC_query const& item) { return item.handle == handle; });
-    if (ugc_queries.end() == request) return false;
+    auto request = get_query(handle);
+    if (!request) return false;
     
+    request->filter.updated_start = rtStart;
+    request->filter.updated_end = rtEnd;
     return true;
 }
 
@@ -1082,7 +1195,7 @@ SteamAPICall_t GetUserItemVote( PublishedFileId_t nPublishedFileID )
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (nPublishedFileID == k_PublishedFileIdInvalid || !settings->isModInstalled(nPublishedFileID)) return k_uAPICallInvalid; // TODO is this correct
 
-    auto mod  = settings->getMod(nPublishedFileID);
+    auto &mod = settings->getMod(nPublishedFileID);
     GetUserItemVoteResult_t data{};
     data.m_eResult = EResult::k_EResultOK;
     data.m_nPublishedFileId = nPublishedFileID;
@@ -1232,7 +1345,7 @@ bool GetItemInstallInfo( PublishedFileId_t nPublishedFileID, uint64 *punSizeOnDi
     if (!cchFolderSize) return false;
     if (!settings->isModInstalled(nPublishedFileID)) return false;
 
-    auto mod = settings->getMod(nPublishedFileID);
+    auto &mod = settings->getMod(nPublishedFileID);
     
     // I don't know if this is accurate behavior, but to avoid returning true with invalid data
     if ((cchFolderSize - 1) < mod.path.size()) { // -1 because the last char is reserved for null terminator
@@ -1260,7 +1373,7 @@ bool GetItemDownloadInfo( PublishedFileId_t nPublishedFileID, uint64 *punBytesDo
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (!settings->isModInstalled(nPublishedFileID)) return false;
 
-    auto mod = settings->getMod(nPublishedFileID);
+    auto &mod = settings->getMod(nPublishedFileID);
     if (punBytesDownloaded) *punBytesDownloaded = mod.primaryFileSize;
     if (punBytesTotal) *punBytesTotal = mod.primaryFileSize;
     return true;
@@ -18,6 +18,7 @@
 #include "base.h"
 #include "auth.h"
 #include "appticket.h"
+#include "voice.h"
 
 class Steam_User :
 public ISteamUser009,
@@ -41,8 +42,7 @@ public ISteamUser
 	class SteamCallResults *callback_results;
     Local_Storage *local_storage;
 
-	bool recording = false;
-	std::chrono::high_resolution_clock::time_point last_get_voice;
+	Voice_Recorder *voice;
 	std::string encrypted_app_ticket;
 	Auth_Manager *auth_manager;
 
@@ -55,13 +55,14 @@ Steam_User(Settings *settings, Local_Storage *local_storage, class Networking *n
     this->network = network;
     this->callbacks = callbacks;
     this->callback_results = callback_results;
-    recording = false;
     auth_manager = new Auth_Manager(settings, network, callbacks);
+    voice = new Voice_Recorder(settings->voice_input_path, settings->voice_input_sample_rate);
 }
 
 ~Steam_User()
 {
     delete auth_manager;
+    delete voice;
 }
 
 // returns the HSteamUser this interface represents
@@ -164,10 +165,8 @@ bool GetUserDataFolder( char *pchBuffer, int cubBuffer )
 void StartVoiceRecording( )
 {
     PRINT_DEBUG("Steam_User::StartVoiceRecording\n");
-    last_get_voice = std::chrono::high_resolution_clock::now();
-    recording = true;
-    //TODO:fix
-    recording = false;
+    std::lock_guard<std::recursive_mutex> lock(global_mutex);
+    voice->start();
 }
 
 // Stops voice recording. Because people often release push-to-talk keys early, the system will keep recording for
@@ -176,7 +175,8 @@ void StartVoiceRecording( )
 void StopVoiceRecording( )
 {
     PRINT_DEBUG("Steam_User::StopVoiceRecording\n");
-    recording = false;
+    std::lock_guard<std::recursive_mutex> lock(global_mutex);
+    voice->stop();
 }
 
 // Determine the size of captured audio data that is available from GetVoice.
@@ -186,14 +186,17 @@ void StopVoiceRecording( )
 EVoiceResult GetAvailableVoice( uint32 *pcbCompressed, uint32 *pcbUncompressed_Deprecated, uint32 nUncompressedVoiceDesiredSampleRate_Deprecated  )
 {
     PRINT_DEBUG("Steam_User::GetAvailableVoice\n");
+    std::lock_guard<std::recursive_mutex> lock(global_mutex);
     if (pcbCompressed) *pcbCompressed = 0;
     if (pcbUncompressed_Deprecated) *pcbUncompressed_Deprecated = 0;
-    if (!recording) return k_EVoiceResultNotRecording;
-    double seconds = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::high_resolution_clock::now() - last_get_voice).count();
-    if (pcbCompressed) *pcbCompressed = seconds * 1024.0 * 64.0 / 8.0;
-    if (pcbUncompressed_Deprecated) *pcbUncompressed_Deprecated = seconds * (double)nUncompressedVoiceDesiredSampleRate_Deprecated * 2.0;
+    if (!voice->is_active()) return k_EVoiceResultNotRecording;
+
+    voice->update();
+    uint32 compressed = voice->available_compressed();
+    if (pcbCompressed) *pcbCompressed = compressed;
+    if (pcbUncompressed_Deprecated) *pcbUncompressed_Deprecated = voice->available_uncompressed(nUncompressedVoiceDesiredSampleRate_Deprecated);
 
-    return k_EVoiceResultOK;
+    return compressed ? k_EVoiceResultOK : k_EVoiceResultNoData;
 }
 
 EVoiceResult GetAvailableVoice(uint32 *pcbCompressed, uint32 *pcbUncompressed)
@@ -226,21 +229,21 @@ EVoiceResult GetAvailableVoice(uint32 *pcbCompressed, uint32 *pcbUncompressed)
 EVoiceResult GetVoice( bool bWantCompressed, void *pDestBuffer, uint32 cbDestBufferSize, uint32 *nBytesWritten, bool bWantUncompressed_Deprecated, void *pUncompressedDestBuffer_Deprecated , uint32 cbUncompressedDestBufferSize_Deprecated , uint32 *nUncompressBytesWritten_Deprecated , uint32 nUncompressedVoiceDesiredSampleRate_Deprecated  )
 {
     PRINT_DEBUG("Steam_User::GetVoice\n");
-    if (!recording) return k_EVoiceResultNotRecording;
-    double seconds = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::high_resolution_clock::now() - last_get_voice).count();
-    if (bWantCompressed) {
-        uint32 towrite = seconds * 1024.0 * 64.0 / 8.0;
-        if (cbDestBufferSize < towrite) towrite = cbDestBufferSize;
-        if (pDestBuffer) memset(pDestBuffer, 0, towrite);
-        if (nBytesWritten) *nBytesWritten = towrite;
-    }
+    std::lock_guard<std::recursive_mutex> lock(global_mutex);
+    if (nBytesWritten) *nBytesWritten = 0;
+    if (nUncompressBytesWritten_Deprecated) *nUncompressBytesWritten_Deprecated = 0;
+    if (!voice->is_active()) return k_EVoiceResultNotRecording;
 
+    voice->update();
     if (bWantUncompressed_Deprecated) {
         PRINT_DEBUG("Steam_User::GetVoice Wanted Uncompressed\n");
     }
 
-    last_get_voice = std::chrono::high_resolution_clock::now();
-    return k_EVoiceResultOK;
+    return voice->get_voice(
+        bWantCompressed, pDestBuffer, cbDestBufferSize, nBytesWritten,
+        bWantUncompressed_Deprecated, pUncompressedDestBuffer_Deprecated, cbUncompressedDestBufferSize_Deprecated, nUncompressBytesWritten_Deprecated,
+        nUncompressedVoiceDesiredSampleRate_Deprecated
+    );
 }
 
 EVoiceResult GetVoice( bool bWantCompressed, void *pDestBuffer, uint32 cbDestBufferSize, uint32 *nBytesWritten, bool bWantUncompressed, void *pUncompressedDestBuffer, uint32 cbUncompressedDestBufferSize, uint32 *nUncompressBytesWritten )
@@ -264,13 +267,7 @@ EVoiceResult GetCompressedVoice( void *pDestBuffer, uint32 cbDestBufferSize, uin
 EVoiceResult DecompressVoice( const void *pCompressed, uint32 cbCompressed, void *pDestBuffer, uint32 cbDestBufferSize, uint32 *nBytesWritten, uint32 nDesiredSampleRate )
 {
     PRINT_DEBUG("Steam_User::DecompressVoice\n");
-    if (!recording) return k_EVoiceResultNotRecording;
-    uint32 uncompressed = (double)cbCompressed * ((double)nDesiredSampleRate / 8192.0);
-    if(nBytesWritten) *nBytesWritten = uncompressed;
-    if (uncompressed > cbDestBufferSize) uncompressed = cbDestBufferSize;
-    if (pDestBuffer) memset(pDestBuffer, 0, uncompressed);
-
-    return k_EVoiceResultOK;
+    return Voice_Recorder::decompress(pCompressed, cbCompressed, pDestBuffer, cbDestBufferSize, nBytesWritten, nDesiredSampleRate);
 }
 
 EVoiceResult DecompressVoice( const void *pCompressed, uint32 cbCompressed, void *pDestBuffer, uint32 cbDestBufferSize, uint32 *nBytesWritten )
@@ -295,7 +292,7 @@ EVoiceResult DecompressVoice( void *pCompressed, uint32 cbCompressed, void *pDes
 uint32 GetVoiceOptimalSampleRate()
 {
     PRINT_DEBUG("Steam_User::GetVoiceOptimalSampleRate\n");
-    return 48000;
+    return VOICE_CODEC_SAMPLE_RATE;
 }
 
 // Retrieve ticket to be sent to the entity who wishes to authenticate you. 
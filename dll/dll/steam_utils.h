@@ -96,7 +96,7 @@ bool GetImageSize( int iImage, uint32 *pnWidth, uint32 *pnHeight )
     if (!iImage || !pnWidth || !pnHeight) return false;
 
     auto image = settings->images.find(iImage);
-    if (image == settings->images.end()) return false;
+    if (image == settings->images.end() || !image->second.refcount) return false;
 
     *pnWidth = image->second.width;
     *pnHeight = image->second.height;
@@ -114,7 +114,7 @@ bool GetImageRGBA( int iImage, uint8 *pubDest, int nDestBufferSize )
     if (!iImage || !pubDest || !nDestBufferSize) return false;
 
     auto image = settings->images.find(iImage);
-    if (image == settings->images.end()) return false;
+    if (image == settings->images.end() || !image->second.refcount) return false;
 
     unsigned size = image->second.data.size();
     if (nDestBufferSize < size) size = nDestBufferSize;
@@ -0,0 +1,73 @@
+#ifndef __INCLUDED_UGC_CATALOG_H__
+#define __INCLUDED_UGC_CATALOG_H__
+
+#include "settings.h"
+
+// searchable index of the installed mods, built once and then only read by the UGC queries
+class Ugc_Catalog
+{
+public:
+    // empty members don't filter anything
+    struct Filter {
+        std::vector<std::string> required_tags;
+        // at least one tag of every group is required
+        std::vector<std::vector<std::string>> required_tag_groups;
+        std::vector<std::string> excluded_tags;
+        // a single required tag is enough instead of all of them
+        bool match_any_tag = false;
+        // every word must be the start of a word in the title or description
+        std::string search_text;
+        std::vector<std::pair<std::string, std::string>> required_key_value_tags;
+        // inclusive ranges, 0 leaves that side open
+        RTime32 created_start = 0, created_end = 0;
+        RTime32 updated_start = 0, updated_end = 0;
+    };
+
+    enum class Sort {
+        NONE,
+        CREATED_DESC,
+        UPDATED_DESC,
+        VOTES_DESC,
+    };
+
+private:
+    struct Item {
+        PublishedFileId_t id;
+        std::vector<std::string> tags;
+        std::vector<std::pair<std::string, std::string>> key_value_tags;
+        RTime32 time_created;
+        RTime32 time_updated;
+        uint32 votes_up;
+    };
+
+    std::vector<Item> items{};
+    std::unordered_map<PublishedFileId_t, uint32> index{};
+    // posting lists hold sorted item indexes
+    // key: lowercase tag
+    std::unordered_map<std::string, std::vector<uint32>> tag_postings{};
+    // key: lowercase key + '\n' + value
+    std::unordered_map<std::string, std::vector<uint32>> key_value_postings{};
+    // lowercase words of the titles and descriptions, sorted so a prefix is a contiguous range
+    std::vector<std::pair<std::string, std::vector<uint32>>> words{};
+
+    const std::vector<uint32> *find_postings(const std::unordered_map<std::string, std::vector<uint32>> &postings, const std::string &key) const;
+    std::vector<uint32> words_with_prefix(const std::string &prefix) const;
+
+public:
+    // "Maps, Game Mode" -> ["Maps", "Game Mode"]
+    static std::vector<std::string> split_tags(const std::string &tags);
+    // lowercase runs of letters and digits
+    static std::vector<std::string> tokenize(const std::string &text);
+
+    void build(const std::vector<struct Mod_entry> &mods);
+    size_t size() const;
+
+    // nullptr if the mod isn't in the catalog
+    const std::vector<std::string> *get_tags(PublishedFileId_t id) const;
+    const std::vector<std::pair<std::string, std::string>> *get_key_value_tags(PublishedFileId_t id) const;
+
+    // ids of the matching mods, in catalog order or in the order of candidates when it's given
+    std::vector<PublishedFileId_t> query(const Filter &filter, Sort sort, const std::vector<PublishedFileId_t> *candidates = nullptr) const;
+};
+
+#endif // __INCLUDED_UGC_CATALOG_H__
@@ -0,0 +1,92 @@
+/* Copyright (C) 2019 Mr Goldberg
+   This file is part of the Goldberg Emulator
+
+   The Goldberg Emulator is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   The Goldberg Emulator is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the Goldberg Emulator; if not, see
+   <http://www.gnu.org/licenses/>.  */
+
+#ifndef VOICE_INCLUDE
+#define VOICE_INCLUDE
+
+#include "base.h"
+
+// captured audio is resampled to this rate before being compressed
+#define VOICE_CODEC_SAMPLE_RATE 11025
+// 20ms frames
+#define VOICE_FRAME_SAMPLES (VOICE_CODEC_SAMPLE_RATE / 50)
+// keep sending this many frames after the last one with speech, also used as the tail after StopVoiceRecording()
+#define VOICE_HANGOVER_FRAMES 15
+// compressed data the game didn't fetch yet is dropped (oldest first) beyond this size
+#define VOICE_MAX_PENDING_BYTES (16 * 1024)
+
+// source of mono 16-bit PCM audio, replaces the microphone
+class Voice_Source {
+public:
+    virtual ~Voice_Source() {}
+    virtual uint32 sample_rate() = 0;
+    // called when recording starts
+    virtual void start() {}
+    // non-blocking, returns the amount of samples written to out
+    virtual size_t read(int16_t *out, size_t max_samples) = 0;
+
+    // .wav files are parsed, anything else is treated as raw signed 16-bit little endian mono samples
+    static Voice_Source *create(const std::string &path, uint32 raw_sample_rate);
+};
+
+class Voice_Recorder {
+    Voice_Source *source = nullptr;
+
+    bool recording = false;
+    std::chrono::high_resolution_clock::time_point stop_time{};
+
+    // captured samples at the source rate, waiting to be resampled
+    std::vector<int16_t> captured{};
+    double resample_pos = 0.0;
+    // resampled samples waiting to fill a frame
+    std::vector<int16_t> frame{};
+
+    // voice activity detection
+    double noise_floor = 0.0;
+    unsigned hangover = 0;
+    int step_index = 0;
+
+    // compressed frames waiting for GetVoice()
+    std::deque<std::string> pending{};
+    size_t pending_bytes = 0;
+
+    void capture();
+    void process_frame();
+
+public:
+    Voice_Recorder(const std::string &input_path, uint32 raw_sample_rate);
+    ~Voice_Recorder();
+
+    void start();
+    void stop();
+    // still recording, inside the tail after stop(), or has data the game didn't fetch yet
+    bool is_active();
+
+    // pulls the captured audio from the source and compresses the frames with speech
+    void update();
+
+    uint32 available_compressed();
+    uint32 available_uncompressed(uint32 sample_rate);
+    EVoiceResult get_voice(bool want_compressed, void *dest, uint32 dest_size, uint32 *written, bool want_uncompressed, void *uncompressed_dest, uint32 uncompressed_dest_size, uint32 *uncompressed_written, uint32 sample_rate);
+
+    // compress mono 16-bit PCM at VOICE_CODEC_SAMPLE_RATE into frames, silence is not suppressed here
+    static std::string compress(const int16_t *samples, size_t count);
+    // decodes frames produced by compress()/GetVoice() to mono 16-bit PCM at the given rate
+    static EVoiceResult decompress(const void *compressed, uint32 compressed_size, void *dest, uint32 dest_size, uint32 *written, uint32 sample_rate);
+};
+
+#endif // VOICE_INCLUDE
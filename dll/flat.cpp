@@ -3545,9 +3545,9 @@ STEAMAPI_API ISteamUGC *SteamAPI_SteamGameServerUGC_v018()
 
 STEAMAPI_API UGCQueryHandle_t SteamAPI_ISteamUGC_CreateQueryUserUGCRequest( ISteamUGC* self, AccountID_t unAccountID, EUserUGCList eListType, EUGCMatchingUGCType eMatchingUGCType, EUserUGCListSortOrder eSortOrder, AppId_t nCreatorAppID, AppId_t nConsumerAppID, uint32 unPage )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3557,9 +3557,9 @@ STEAMAPI_API UGCQueryHandle_t SteamAPI_ISteamUGC_CreateQueryUserUGCRequest( ISte
 
 STEAMAPI_API UGCQueryHandle_t SteamAPI_ISteamUGC_CreateQueryAllUGCRequest(intptr_t instancePtr, EUGCQuery eQueryType, EUGCMatchingUGCType eMatchingeMatchingUGCTypeFileType, AppId_t nCreatorAppID, AppId_t nConsumerAppID, uint32 unPage)
 {
-    long long test1 = ((char *)instancePtr - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)instancePtr - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)instancePtr - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)instancePtr - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3569,9 +3569,9 @@ STEAMAPI_API UGCQueryHandle_t SteamAPI_ISteamUGC_CreateQueryAllUGCRequest(intptr
 
 STEAMAPI_API UGCQueryHandle_t SteamAPI_ISteamUGC_CreateQueryAllUGCRequest0(intptr_t instancePtr, EUGCQuery eQueryType, EUGCMatchingUGCType eMatchingeMatchingUGCTypeFileType, AppId_t nCreatorAppID, AppId_t nConsumerAppID, const char * pchCursor)
 {
-    long long test1 = ((char *)instancePtr - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)instancePtr - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)instancePtr - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)instancePtr - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3581,9 +3581,9 @@ STEAMAPI_API UGCQueryHandle_t SteamAPI_ISteamUGC_CreateQueryAllUGCRequest0(intpt
 
 STEAMAPI_API UGCQueryHandle_t SteamAPI_ISteamUGC_CreateQueryAllUGCRequestPage( ISteamUGC* self, EUGCQuery eQueryType, EUGCMatchingUGCType eMatchingeMatchingUGCTypeFileType, AppId_t nCreatorAppID, AppId_t nConsumerAppID, uint32 unPage )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3593,9 +3593,9 @@ STEAMAPI_API UGCQueryHandle_t SteamAPI_ISteamUGC_CreateQueryAllUGCRequestPage( I
 
 STEAMAPI_API UGCQueryHandle_t SteamAPI_ISteamUGC_CreateQueryAllUGCRequestCursor( ISteamUGC* self, EUGCQuery eQueryType, EUGCMatchingUGCType eMatchingeMatchingUGCTypeFileType, AppId_t nCreatorAppID, AppId_t nConsumerAppID, const char * pchCursor )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3605,9 +3605,9 @@ STEAMAPI_API UGCQueryHandle_t SteamAPI_ISteamUGC_CreateQueryAllUGCRequestCursor(
 
 STEAMAPI_API UGCQueryHandle_t SteamAPI_ISteamUGC_CreateQueryUGCDetailsRequest( ISteamUGC* self, PublishedFileId_t * pvecPublishedFileID, uint32 unNumPublishedFileIDs )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3617,9 +3617,9 @@ STEAMAPI_API UGCQueryHandle_t SteamAPI_ISteamUGC_CreateQueryUGCDetailsRequest( I
 
 STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_SendQueryUGCRequest( ISteamUGC* self, UGCQueryHandle_t handle )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3629,9 +3629,9 @@ STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_SendQueryUGCRequest( ISteamUGC* s
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_GetQueryUGCResult( ISteamUGC* self, UGCQueryHandle_t handle, uint32 index, SteamUGCDetails_t * pDetails )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3641,9 +3641,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_GetQueryUGCResult( ISteamUGC* self, U
 
 STEAMAPI_API uint32 SteamAPI_ISteamUGC_GetQueryUGCNumTags( ISteamUGC* self, UGCQueryHandle_t handle, uint32 index )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3653,9 +3653,9 @@ STEAMAPI_API uint32 SteamAPI_ISteamUGC_GetQueryUGCNumTags( ISteamUGC* self, UGCQ
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_GetQueryUGCTag( ISteamUGC* self, UGCQueryHandle_t handle, uint32 index, uint32 indexTag, char * pchValue, uint32 cchValueSize )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3665,9 +3665,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_GetQueryUGCTag( ISteamUGC* self, UGCQ
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_GetQueryUGCTagDisplayName( ISteamUGC* self, UGCQueryHandle_t handle, uint32 index, uint32 indexTag, char * pchValue, uint32 cchValueSize )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3677,9 +3677,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_GetQueryUGCTagDisplayName( ISteamUGC*
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_GetQueryUGCPreviewURL( ISteamUGC* self, UGCQueryHandle_t handle, uint32 index, char * pchURL, uint32 cchURLSize )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3689,9 +3689,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_GetQueryUGCPreviewURL( ISteamUGC* sel
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_GetQueryUGCMetadata( ISteamUGC* self, UGCQueryHandle_t handle, uint32 index, char * pchMetadata, uint32 cchMetadatasize )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3701,9 +3701,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_GetQueryUGCMetadata( ISteamUGC* self,
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_GetQueryUGCChildren( ISteamUGC* self, UGCQueryHandle_t handle, uint32 index, PublishedFileId_t * pvecPublishedFileID, uint32 cMaxEntries )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3713,9 +3713,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_GetQueryUGCChildren( ISteamUGC* self,
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_GetQueryUGCStatistic( ISteamUGC* self, UGCQueryHandle_t handle, uint32 index, EItemStatistic eStatType, uint64 * pStatValue )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3725,9 +3725,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_GetQueryUGCStatistic( ISteamUGC* self
 
 STEAMAPI_API uint32 SteamAPI_ISteamUGC_GetQueryUGCNumAdditionalPreviews( ISteamUGC* self, UGCQueryHandle_t handle, uint32 index )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3737,9 +3737,9 @@ STEAMAPI_API uint32 SteamAPI_ISteamUGC_GetQueryUGCNumAdditionalPreviews( ISteamU
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_GetQueryUGCAdditionalPreview( ISteamUGC* self, UGCQueryHandle_t handle, uint32 index, uint32 previewIndex, char * pchURLOrVideoID, uint32 cchURLSize, char * pchOriginalFileName, uint32 cchOriginalFileNameSize, EItemPreviewType * pPreviewType )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3749,9 +3749,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_GetQueryUGCAdditionalPreview( ISteamU
 
 STEAMAPI_API uint32 SteamAPI_ISteamUGC_GetQueryUGCNumKeyValueTags( ISteamUGC* self, UGCQueryHandle_t handle, uint32 index )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3761,9 +3761,9 @@ STEAMAPI_API uint32 SteamAPI_ISteamUGC_GetQueryUGCNumKeyValueTags( ISteamUGC* se
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_GetQueryUGCKeyValueTag( ISteamUGC* self, UGCQueryHandle_t handle, uint32 index, uint32 keyValueTagIndex, char * pchKey, uint32 cchKeySize, char * pchValue, uint32 cchValueSize )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3773,9 +3773,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_GetQueryUGCKeyValueTag( ISteamUGC* se
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_GetQueryUGCKeyValueTag0(intptr_t instancePtr, UGCQueryHandle_t handle, uint32 index, const char * pchKey, char * pchValue, uint32 cchValueSize)
 {
-    long long test1 = ((char *)instancePtr - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)instancePtr - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)instancePtr - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)instancePtr - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3785,9 +3785,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_GetQueryUGCKeyValueTag0(intptr_t inst
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_GetQueryFirstUGCKeyValueTag( ISteamUGC* self, UGCQueryHandle_t handle, uint32 index, const char * pchKey, char * pchValue, uint32 cchValueSize )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3797,9 +3797,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_GetQueryFirstUGCKeyValueTag( ISteamUG
 
 STEAMAPI_API uint32 SteamAPI_ISteamUGC_GetQueryUGCContentDescriptors( ISteamUGC* self, UGCQueryHandle_t handle, uint32 index, EUGCContentDescriptorID * pvecDescriptors, uint32 cMaxEntries )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3809,9 +3809,9 @@ STEAMAPI_API uint32 SteamAPI_ISteamUGC_GetQueryUGCContentDescriptors( ISteamUGC*
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_ReleaseQueryUGCRequest( ISteamUGC* self, UGCQueryHandle_t handle )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3821,9 +3821,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_ReleaseQueryUGCRequest( ISteamUGC* se
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_AddRequiredTag( ISteamUGC* self, UGCQueryHandle_t handle, const char * pTagName )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3833,9 +3833,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_AddRequiredTag( ISteamUGC* self, UGCQ
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_AddRequiredTagGroup( ISteamUGC* self, UGCQueryHandle_t handle, const SteamParamStringArray_t * pTagGroups )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3845,9 +3845,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_AddRequiredTagGroup( ISteamUGC* self,
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_AddExcludedTag( ISteamUGC* self, UGCQueryHandle_t handle, const char * pTagName )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3857,9 +3857,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_AddExcludedTag( ISteamUGC* self, UGCQ
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetReturnOnlyIDs( ISteamUGC* self, UGCQueryHandle_t handle, bool bReturnOnlyIDs )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3869,9 +3869,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetReturnOnlyIDs( ISteamUGC* self, UG
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetReturnKeyValueTags( ISteamUGC* self, UGCQueryHandle_t handle, bool bReturnKeyValueTags )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3881,9 +3881,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetReturnKeyValueTags( ISteamUGC* sel
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetReturnLongDescription( ISteamUGC* self, UGCQueryHandle_t handle, bool bReturnLongDescription )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3893,9 +3893,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetReturnLongDescription( ISteamUGC*
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetReturnMetadata( ISteamUGC* self, UGCQueryHandle_t handle, bool bReturnMetadata )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3905,9 +3905,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetReturnMetadata( ISteamUGC* self, U
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetReturnChildren( ISteamUGC* self, UGCQueryHandle_t handle, bool bReturnChildren )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3917,9 +3917,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetReturnChildren( ISteamUGC* self, U
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetReturnAdditionalPreviews( ISteamUGC* self, UGCQueryHandle_t handle, bool bReturnAdditionalPreviews )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3929,9 +3929,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetReturnAdditionalPreviews( ISteamUG
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetReturnTotalOnly( ISteamUGC* self, UGCQueryHandle_t handle, bool bReturnTotalOnly )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3941,9 +3941,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetReturnTotalOnly( ISteamUGC* self,
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetReturnPlaytimeStats( ISteamUGC* self, UGCQueryHandle_t handle, uint32 unDays )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3953,9 +3953,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetReturnPlaytimeStats( ISteamUGC* se
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetLanguage( ISteamUGC* self, UGCQueryHandle_t handle, const char * pchLanguage )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3965,9 +3965,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetLanguage( ISteamUGC* self, UGCQuer
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetAllowCachedResponse( ISteamUGC* self, UGCQueryHandle_t handle, uint32 unMaxAgeSeconds )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3977,9 +3977,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetAllowCachedResponse( ISteamUGC* se
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetCloudFileNameFilter( ISteamUGC* self, UGCQueryHandle_t handle, const char * pMatchCloudFileName )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -3989,9 +3989,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetCloudFileNameFilter( ISteamUGC* se
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetMatchAnyTag( ISteamUGC* self, UGCQueryHandle_t handle, bool bMatchAnyTag )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4001,9 +4001,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetMatchAnyTag( ISteamUGC* self, UGCQ
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetSearchText( ISteamUGC* self, UGCQueryHandle_t handle, const char * pSearchText )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4013,9 +4013,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetSearchText( ISteamUGC* self, UGCQu
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetRankedByTrendDays( ISteamUGC* self, UGCQueryHandle_t handle, uint32 unDays )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4025,9 +4025,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetRankedByTrendDays( ISteamUGC* self
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetTimeCreatedDateRange( ISteamUGC* self, UGCQueryHandle_t handle, RTime32 rtStart, RTime32 rtEnd )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4037,9 +4037,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetTimeCreatedDateRange( ISteamUGC* s
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetTimeUpdatedDateRange( ISteamUGC* self, UGCQueryHandle_t handle, RTime32 rtStart, RTime32 rtEnd )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4049,9 +4049,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetTimeUpdatedDateRange( ISteamUGC* s
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_AddRequiredKeyValueTag( ISteamUGC* self, UGCQueryHandle_t handle, const char * pKey, const char * pValue )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4061,9 +4061,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_AddRequiredKeyValueTag( ISteamUGC* se
 
 STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_RequestUGCDetails( ISteamUGC* self, PublishedFileId_t nPublishedFileID, uint32 unMaxAgeSeconds )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4073,9 +4073,9 @@ STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_RequestUGCDetails( ISteamUGC* sel
 
 STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_CreateItem( ISteamUGC* self, AppId_t nConsumerAppId, EWorkshopFileType eFileType )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4085,9 +4085,9 @@ STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_CreateItem( ISteamUGC* self, AppI
 
 STEAMAPI_API UGCUpdateHandle_t SteamAPI_ISteamUGC_StartItemUpdate( ISteamUGC* self, AppId_t nConsumerAppId, PublishedFileId_t nPublishedFileID )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4097,9 +4097,9 @@ STEAMAPI_API UGCUpdateHandle_t SteamAPI_ISteamUGC_StartItemUpdate( ISteamUGC* se
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetItemTitle( ISteamUGC* self, UGCUpdateHandle_t handle, const char * pchTitle )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4109,9 +4109,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetItemTitle( ISteamUGC* self, UGCUpd
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetItemDescription( ISteamUGC* self, UGCUpdateHandle_t handle, const char * pchDescription )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4121,9 +4121,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetItemDescription( ISteamUGC* self,
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetItemUpdateLanguage( ISteamUGC* self, UGCUpdateHandle_t handle, const char * pchLanguage )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4133,9 +4133,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetItemUpdateLanguage( ISteamUGC* sel
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetItemMetadata( ISteamUGC* self, UGCUpdateHandle_t handle, const char * pchMetaData )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4145,9 +4145,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetItemMetadata( ISteamUGC* self, UGC
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetItemVisibility( ISteamUGC* self, UGCUpdateHandle_t handle, ERemoteStoragePublishedFileVisibility eVisibility )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4158,9 +4158,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetItemVisibility( ISteamUGC* self, U
 //STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetItemTags( ISteamUGC* self, UGCUpdateHandle_t updateHandle, const SteamParamStringArray_t * pTags )
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetItemTags( ISteamUGC* self, UGCUpdateHandle_t updateHandle, const SteamParamStringArray_t * pTags, bool bAllowAdminTags )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4171,9 +4171,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetItemTags( ISteamUGC* self, UGCUpda
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetItemContent( ISteamUGC* self, UGCUpdateHandle_t handle, const char * pszContentFolder )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4183,9 +4183,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetItemContent( ISteamUGC* self, UGCU
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetItemPreview( ISteamUGC* self, UGCUpdateHandle_t handle, const char * pszPreviewFile )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4195,9 +4195,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetItemPreview( ISteamUGC* self, UGCU
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetAllowLegacyUpload( ISteamUGC* self, UGCUpdateHandle_t handle, bool bAllowLegacyUpload )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4207,9 +4207,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_SetAllowLegacyUpload( ISteamUGC* self
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_RemoveAllItemKeyValueTags( ISteamUGC* self, UGCUpdateHandle_t handle )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4219,9 +4219,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_RemoveAllItemKeyValueTags( ISteamUGC*
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_RemoveItemKeyValueTags( ISteamUGC* self, UGCUpdateHandle_t handle, const char * pchKey )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4231,9 +4231,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_RemoveItemKeyValueTags( ISteamUGC* se
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_AddItemKeyValueTag( ISteamUGC* self, UGCUpdateHandle_t handle, const char * pchKey, const char * pchValue )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4243,9 +4243,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_AddItemKeyValueTag( ISteamUGC* self,
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_AddItemPreviewFile( ISteamUGC* self, UGCUpdateHandle_t handle, const char * pszPreviewFile, EItemPreviewType type )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4255,9 +4255,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_AddItemPreviewFile( ISteamUGC* self,
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_AddItemPreviewVideo( ISteamUGC* self, UGCUpdateHandle_t handle, const char * pszVideoID )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4267,9 +4267,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_AddItemPreviewVideo( ISteamUGC* self,
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_UpdateItemPreviewFile( ISteamUGC* self, UGCUpdateHandle_t handle, uint32 index, const char * pszPreviewFile )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4279,9 +4279,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_UpdateItemPreviewFile( ISteamUGC* sel
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_UpdateItemPreviewVideo( ISteamUGC* self, UGCUpdateHandle_t handle, uint32 index, const char * pszVideoID )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4291,9 +4291,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_UpdateItemPreviewVideo( ISteamUGC* se
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_RemoveItemPreview( ISteamUGC* self, UGCUpdateHandle_t handle, uint32 index )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4303,9 +4303,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_RemoveItemPreview( ISteamUGC* self, U
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_AddContentDescriptor( ISteamUGC* self, UGCUpdateHandle_t handle, EUGCContentDescriptorID descid )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4315,9 +4315,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_AddContentDescriptor( ISteamUGC* self
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_RemoveContentDescriptor( ISteamUGC* self, UGCUpdateHandle_t handle, EUGCContentDescriptorID descid )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4327,9 +4327,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_RemoveContentDescriptor( ISteamUGC* s
 
 STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_SubmitItemUpdate( ISteamUGC* self, UGCUpdateHandle_t handle, const char * pchChangeNote )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4339,9 +4339,9 @@ STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_SubmitItemUpdate( ISteamUGC* self
 
 STEAMAPI_API EItemUpdateStatus SteamAPI_ISteamUGC_GetItemUpdateProgress( ISteamUGC* self, UGCUpdateHandle_t handle, uint64 * punBytesProcessed, uint64 * punBytesTotal )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4351,9 +4351,9 @@ STEAMAPI_API EItemUpdateStatus SteamAPI_ISteamUGC_GetItemUpdateProgress( ISteamU
 
 STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_SetUserItemVote( ISteamUGC* self, PublishedFileId_t nPublishedFileID, bool bVoteUp )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4363,9 +4363,9 @@ STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_SetUserItemVote( ISteamUGC* self,
 
 STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_GetUserItemVote( ISteamUGC* self, PublishedFileId_t nPublishedFileID )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4375,9 +4375,9 @@ STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_GetUserItemVote( ISteamUGC* self,
 
 STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_AddItemToFavorites( ISteamUGC* self, AppId_t nAppId, PublishedFileId_t nPublishedFileID )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4387,9 +4387,9 @@ STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_AddItemToFavorites( ISteamUGC* se
 
 STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_RemoveItemFromFavorites( ISteamUGC* self, AppId_t nAppId, PublishedFileId_t nPublishedFileID )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4399,9 +4399,9 @@ STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_RemoveItemFromFavorites( ISteamUG
 
 STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_SubscribeItem( ISteamUGC* self, PublishedFileId_t nPublishedFileID )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4411,9 +4411,9 @@ STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_SubscribeItem( ISteamUGC* self, P
 
 STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_UnsubscribeItem( ISteamUGC* self, PublishedFileId_t nPublishedFileID )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4423,9 +4423,9 @@ STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_UnsubscribeItem( ISteamUGC* self,
 
 STEAMAPI_API uint32 SteamAPI_ISteamUGC_GetNumSubscribedItems( ISteamUGC* self )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4435,9 +4435,9 @@ STEAMAPI_API uint32 SteamAPI_ISteamUGC_GetNumSubscribedItems( ISteamUGC* self )
 
 STEAMAPI_API uint32 SteamAPI_ISteamUGC_GetSubscribedItems( ISteamUGC* self, PublishedFileId_t * pvecPublishedFileID, uint32 cMaxEntries )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4447,9 +4447,9 @@ STEAMAPI_API uint32 SteamAPI_ISteamUGC_GetSubscribedItems( ISteamUGC* self, Publ
 
 STEAMAPI_API uint32 SteamAPI_ISteamUGC_GetItemState( ISteamUGC* self, PublishedFileId_t nPublishedFileID )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4459,9 +4459,9 @@ STEAMAPI_API uint32 SteamAPI_ISteamUGC_GetItemState( ISteamUGC* self, PublishedF
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_GetItemInstallInfo( ISteamUGC* self, PublishedFileId_t nPublishedFileID, uint64 * punSizeOnDisk, char * pchFolder, uint32 cchFolderSize, uint32 * punTimeStamp )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4471,9 +4471,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_GetItemInstallInfo( ISteamUGC* self,
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_GetItemDownloadInfo( ISteamUGC* self, PublishedFileId_t nPublishedFileID, uint64 * punBytesDownloaded, uint64 * punBytesTotal )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4483,9 +4483,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_GetItemDownloadInfo( ISteamUGC* self,
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_DownloadItem( ISteamUGC* self, PublishedFileId_t nPublishedFileID, bool bHighPriority )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4495,9 +4495,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_DownloadItem( ISteamUGC* self, Publis
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_BInitWorkshopForGameServer( ISteamUGC* self, DepotId_t unWorkshopDepotID, const char * pszFolder )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4507,9 +4507,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_BInitWorkshopForGameServer( ISteamUGC
 
 STEAMAPI_API void SteamAPI_ISteamUGC_SuspendDownloads( ISteamUGC* self, bool bSuspend )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4519,9 +4519,9 @@ STEAMAPI_API void SteamAPI_ISteamUGC_SuspendDownloads( ISteamUGC* self, bool bSu
 
 STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_StartPlaytimeTracking( ISteamUGC* self, PublishedFileId_t * pvecPublishedFileID, uint32 unNumPublishedFileIDs )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4531,9 +4531,9 @@ STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_StartPlaytimeTracking( ISteamUGC*
 
 STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_StopPlaytimeTracking( ISteamUGC* self, PublishedFileId_t * pvecPublishedFileID, uint32 unNumPublishedFileIDs )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4543,9 +4543,9 @@ STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_StopPlaytimeTracking( ISteamUGC*
 
 STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_StopPlaytimeTrackingForAllItems( ISteamUGC* self )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4555,9 +4555,9 @@ STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_StopPlaytimeTrackingForAllItems(
 
 STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_AddDependency( ISteamUGC* self, PublishedFileId_t nParentPublishedFileID, PublishedFileId_t nChildPublishedFileID )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4567,9 +4567,9 @@ STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_AddDependency( ISteamUGC* self, P
 
 STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_RemoveDependency( ISteamUGC* self, PublishedFileId_t nParentPublishedFileID, PublishedFileId_t nChildPublishedFileID )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4579,9 +4579,9 @@ STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_RemoveDependency( ISteamUGC* self
 
 STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_AddAppDependency( ISteamUGC* self, PublishedFileId_t nPublishedFileID, AppId_t nAppID )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4591,9 +4591,9 @@ STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_AddAppDependency( ISteamUGC* self
 
 STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_RemoveAppDependency( ISteamUGC* self, PublishedFileId_t nPublishedFileID, AppId_t nAppID )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4603,9 +4603,9 @@ STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_RemoveAppDependency( ISteamUGC* s
 
 STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_GetAppDependencies( ISteamUGC* self, PublishedFileId_t nPublishedFileID )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4615,9 +4615,9 @@ STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_GetAppDependencies( ISteamUGC* se
 
 STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_DeleteItem( ISteamUGC* self, PublishedFileId_t nPublishedFileID )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4627,9 +4627,9 @@ STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_DeleteItem( ISteamUGC* self, Publ
 
 STEAMAPI_API steam_bool SteamAPI_ISteamUGC_ShowWorkshopEULA( ISteamUGC* self )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4639,9 +4639,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamUGC_ShowWorkshopEULA( ISteamUGC* self )
 
 STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_GetWorkshopEULAStatus( ISteamUGC* self )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4651,9 +4651,9 @@ STEAMAPI_API SteamAPICall_t SteamAPI_ISteamUGC_GetWorkshopEULAStatus( ISteamUGC*
 
 STEAMAPI_API uint32 SteamAPI_ISteamUGC_GetUserContentDescriptorPreferences( ISteamUGC* self, EUGCContentDescriptorID * pvecDescriptors, uint32 cMaxEntries )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc);
-    auto ptr = get_steam_client()->steam_gameserver_ugc;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_ugc.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_ugc.created());
+    auto ptr = get_steam_client()->steam_gameserver_ugc.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_ugc;
     }
@@ -4899,9 +4899,9 @@ STEAMAPI_API ISteamInventory *SteamAPI_SteamGameServerInventory_v003()
 
 STEAMAPI_API EResult SteamAPI_ISteamInventory_GetResultStatus( ISteamInventory* self, SteamInventoryResult_t resultHandle )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -4911,9 +4911,9 @@ STEAMAPI_API EResult SteamAPI_ISteamInventory_GetResultStatus( ISteamInventory*
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_GetResultItems( ISteamInventory* self, SteamInventoryResult_t resultHandle, SteamItemDetails_t * pOutItemsArray, uint32 * punOutItemsArraySize )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -4923,9 +4923,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_GetResultItems( ISteamInventory
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_GetResultItemProperty( ISteamInventory* self, SteamInventoryResult_t resultHandle, uint32 unItemIndex, const char * pchPropertyName, char * pchValueBuffer, uint32 * punValueBufferSizeOut )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -4935,9 +4935,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_GetResultItemProperty( ISteamIn
 
 STEAMAPI_API uint32 SteamAPI_ISteamInventory_GetResultTimestamp( ISteamInventory* self, SteamInventoryResult_t resultHandle )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -4947,9 +4947,9 @@ STEAMAPI_API uint32 SteamAPI_ISteamInventory_GetResultTimestamp( ISteamInventory
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_CheckResultSteamID( ISteamInventory* self, SteamInventoryResult_t resultHandle, uint64_steamid steamIDExpected )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -4959,9 +4959,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_CheckResultSteamID( ISteamInven
 
 STEAMAPI_API void SteamAPI_ISteamInventory_DestroyResult( ISteamInventory* self, SteamInventoryResult_t resultHandle )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -4971,9 +4971,9 @@ STEAMAPI_API void SteamAPI_ISteamInventory_DestroyResult( ISteamInventory* self,
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_GetAllItems( ISteamInventory* self, SteamInventoryResult_t * pResultHandle )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -4983,9 +4983,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_GetAllItems( ISteamInventory* s
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_GetItemsByID( ISteamInventory* self, SteamInventoryResult_t * pResultHandle, const SteamItemInstanceID_t * pInstanceIDs, uint32 unCountInstanceIDs )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -4995,9 +4995,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_GetItemsByID( ISteamInventory*
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_SerializeResult( ISteamInventory* self, SteamInventoryResult_t resultHandle, void * pOutBuffer, uint32 * punOutBufferSize )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5007,9 +5007,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_SerializeResult( ISteamInventor
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_DeserializeResult( ISteamInventory* self, SteamInventoryResult_t * pOutResultHandle, const void * pBuffer, uint32 unBufferSize, bool bRESERVED_MUST_BE_FALSE )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5019,9 +5019,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_DeserializeResult( ISteamInvent
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_GenerateItems( ISteamInventory* self, SteamInventoryResult_t * pResultHandle, const SteamItemDef_t * pArrayItemDefs, const uint32 * punArrayQuantity, uint32 unArrayLength )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5031,9 +5031,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_GenerateItems( ISteamInventory*
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_GrantPromoItems( ISteamInventory* self, SteamInventoryResult_t * pResultHandle )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5043,9 +5043,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_GrantPromoItems( ISteamInventor
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_AddPromoItem( ISteamInventory* self, SteamInventoryResult_t * pResultHandle, SteamItemDef_t itemDef )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5055,9 +5055,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_AddPromoItem( ISteamInventory*
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_AddPromoItems( ISteamInventory* self, SteamInventoryResult_t * pResultHandle, const SteamItemDef_t * pArrayItemDefs, uint32 unArrayLength )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5067,9 +5067,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_AddPromoItems( ISteamInventory*
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_ConsumeItem( ISteamInventory* self, SteamInventoryResult_t * pResultHandle, SteamItemInstanceID_t itemConsume, uint32 unQuantity )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5079,9 +5079,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_ConsumeItem( ISteamInventory* s
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_ExchangeItems( ISteamInventory* self, SteamInventoryResult_t * pResultHandle, const SteamItemDef_t * pArrayGenerate, const uint32 * punArrayGenerateQuantity, uint32 unArrayGenerateLength, const SteamItemInstanceID_t * pArrayDestroy, const uint32 * punArrayDestroyQuantity, uint32 unArrayDestroyLength )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5091,9 +5091,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_ExchangeItems( ISteamInventory*
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_TransferItemQuantity( ISteamInventory* self, SteamInventoryResult_t * pResultHandle, SteamItemInstanceID_t itemIdSource, uint32 unQuantity, SteamItemInstanceID_t itemIdDest )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5103,9 +5103,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_TransferItemQuantity( ISteamInv
 
 STEAMAPI_API void SteamAPI_ISteamInventory_SendItemDropHeartbeat( ISteamInventory* self )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5115,9 +5115,9 @@ STEAMAPI_API void SteamAPI_ISteamInventory_SendItemDropHeartbeat( ISteamInventor
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_TriggerItemDrop( ISteamInventory* self, SteamInventoryResult_t * pResultHandle, SteamItemDef_t dropListDefinition )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5127,9 +5127,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_TriggerItemDrop( ISteamInventor
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_TradeItems( ISteamInventory* self, SteamInventoryResult_t * pResultHandle, uint64_steamid steamIDTradePartner, const SteamItemInstanceID_t * pArrayGive, const uint32 * pArrayGiveQuantity, uint32 nArrayGiveLength, const SteamItemInstanceID_t * pArrayGet, const uint32 * pArrayGetQuantity, uint32 nArrayGetLength )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5139,9 +5139,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_TradeItems( ISteamInventory* se
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_LoadItemDefinitions( ISteamInventory* self )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5151,9 +5151,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_LoadItemDefinitions( ISteamInve
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_GetItemDefinitionIDs( ISteamInventory* self, SteamItemDef_t * pItemDefIDs, uint32 * punItemDefIDsArraySize )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5163,9 +5163,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_GetItemDefinitionIDs( ISteamInv
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_GetItemDefinitionProperty( ISteamInventory* self, SteamItemDef_t iDefinition, const char * pchPropertyName, char * pchValueBuffer, uint32 * punValueBufferSizeOut )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5175,9 +5175,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_GetItemDefinitionProperty( ISte
 
 STEAMAPI_API SteamAPICall_t SteamAPI_ISteamInventory_RequestEligiblePromoItemDefinitionsIDs( ISteamInventory* self, uint64_steamid steamID )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5187,9 +5187,9 @@ STEAMAPI_API SteamAPICall_t SteamAPI_ISteamInventory_RequestEligiblePromoItemDef
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_GetEligiblePromoItemDefinitionIDs( ISteamInventory* self, uint64_steamid steamID, SteamItemDef_t * pItemDefIDs, uint32 * punItemDefIDsArraySize )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5199,9 +5199,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_GetEligiblePromoItemDefinitionI
 
 STEAMAPI_API SteamAPICall_t SteamAPI_ISteamInventory_StartPurchase( ISteamInventory* self, const SteamItemDef_t * pArrayItemDefs, const uint32 * punArrayQuantity, uint32 unArrayLength )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5211,9 +5211,9 @@ STEAMAPI_API SteamAPICall_t SteamAPI_ISteamInventory_StartPurchase( ISteamInvent
 
 STEAMAPI_API SteamAPICall_t SteamAPI_ISteamInventory_RequestPrices( ISteamInventory* self )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5223,9 +5223,9 @@ STEAMAPI_API SteamAPICall_t SteamAPI_ISteamInventory_RequestPrices( ISteamInvent
 
 STEAMAPI_API uint32 SteamAPI_ISteamInventory_GetNumItemsWithPrices( ISteamInventory* self )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5235,9 +5235,9 @@ STEAMAPI_API uint32 SteamAPI_ISteamInventory_GetNumItemsWithPrices( ISteamInvent
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_GetItemsWithPrices( ISteamInventory* self, SteamItemDef_t * pArrayItemDefs, uint64 * pCurrentPrices, uint64 * pBasePrices, uint32 unArrayLength )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5247,9 +5247,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_GetItemsWithPrices( ISteamInven
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_GetItemPrice( ISteamInventory* self, SteamItemDef_t iDefinition, uint64 * pCurrentPrice, uint64 * pBasePrice )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5259,9 +5259,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_GetItemPrice( ISteamInventory*
 
 STEAMAPI_API SteamInventoryUpdateHandle_t SteamAPI_ISteamInventory_StartUpdateProperties( ISteamInventory* self )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5271,9 +5271,9 @@ STEAMAPI_API SteamInventoryUpdateHandle_t SteamAPI_ISteamInventory_StartUpdatePr
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_RemoveProperty( ISteamInventory* self, SteamInventoryUpdateHandle_t handle, SteamItemInstanceID_t nItemID, const char * pchPropertyName )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5283,9 +5283,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_RemoveProperty( ISteamInventory
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_SetProperty(intptr_t instancePtr, SteamInventoryUpdateHandle_t handle, SteamItemInstanceID_t nItemID, const char * pchPropertyName, const char * pchPropertyValue)
 {
-    long long test1 = ((char *)instancePtr - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)instancePtr - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)instancePtr - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)instancePtr - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5295,9 +5295,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_SetProperty(intptr_t instancePt
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_SetProperty0(intptr_t instancePtr, SteamInventoryUpdateHandle_t handle, SteamItemInstanceID_t nItemID, const char * pchPropertyName, bool bValue)
 {
-    long long test1 = ((char *)instancePtr - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)instancePtr - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)instancePtr - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)instancePtr - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5307,9 +5307,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_SetProperty0(intptr_t instanceP
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_SetProperty1(intptr_t instancePtr, SteamInventoryUpdateHandle_t handle, SteamItemInstanceID_t nItemID, const char * pchPropertyName, int64 nValue)
 {
-    long long test1 = ((char *)instancePtr - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)instancePtr - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)instancePtr - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)instancePtr - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5319,9 +5319,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_SetProperty1(intptr_t instanceP
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_SetProperty2(intptr_t instancePtr, SteamInventoryUpdateHandle_t handle, SteamItemInstanceID_t nItemID, const char * pchPropertyName, float flValue)
 {
-    long long test1 = ((char *)instancePtr - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)instancePtr - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)instancePtr - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)instancePtr - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5331,9 +5331,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_SetProperty2(intptr_t instanceP
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_SetPropertyString( ISteamInventory* self, SteamInventoryUpdateHandle_t handle, SteamItemInstanceID_t nItemID, const char * pchPropertyName, const char * pchPropertyValue )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5343,9 +5343,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_SetPropertyString( ISteamInvent
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_SetPropertyBool( ISteamInventory* self, SteamInventoryUpdateHandle_t handle, SteamItemInstanceID_t nItemID, const char * pchPropertyName, bool bValue )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5355,9 +5355,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_SetPropertyBool( ISteamInventor
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_SetPropertyInt64( ISteamInventory* self, SteamInventoryUpdateHandle_t handle, SteamItemInstanceID_t nItemID, const char * pchPropertyName, int64 nValue )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5367,9 +5367,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_SetPropertyInt64( ISteamInvento
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_SetPropertyFloat( ISteamInventory* self, SteamInventoryUpdateHandle_t handle, SteamItemInstanceID_t nItemID, const char * pchPropertyName, float flValue )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5379,9 +5379,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_SetPropertyFloat( ISteamInvento
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_SubmitUpdateProperties( ISteamInventory* self, SteamInventoryUpdateHandle_t handle, SteamInventoryResult_t * pResultHandle )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -5391,9 +5391,9 @@ STEAMAPI_API steam_bool SteamAPI_ISteamInventory_SubmitUpdateProperties( ISteamI
 
 STEAMAPI_API steam_bool SteamAPI_ISteamInventory_InspectItem( ISteamInventory* self, SteamInventoryResult_t * pResultHandle, const char * pchItemToken )
 {
-    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory);
-    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory);
-    auto ptr = get_steam_client()->steam_gameserver_inventory;
+    long long test1 = ((char *)self - (char*)get_steam_client()->steam_inventory.created());
+    long long test2 = ((char *)self - (char*)get_steam_client()->steam_gameserver_inventory.created());
+    auto ptr = get_steam_client()->steam_gameserver_inventory.created();
     if (test1 >= 0 && (test2 < 0 || test1 < test2)) {
         ptr = get_steam_client()->steam_inventory;
     }
@@ -0,0 +1,335 @@
+#include "dll/http_cache.h"
+#include "dll/local_storage.h"
+
+
+static long long get_file_mtime(const std::string &path)
+{
+    std::error_code ec;
+    auto time = std::filesystem::last_write_time(std::filesystem::u8path(path), ec);
+    if (ec) return -1;
+    return (long long)time.time_since_epoch().count();
+}
+
+static long long unix_time_now()
+{
+    return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+static size_t curl_write_data(char *ptr, size_t size, size_t nmemb, void *userdata)
+{
+    ((std::string *)userdata)->append(ptr, size * nmemb);
+    return size * nmemb;
+}
+
+static size_t curl_write_header(char *buffer, size_t size, size_t nitems, void *userdata)
+{
+    Http_Cache::Headers *headers = (Http_Cache::Headers *)userdata;
+    std::string line(buffer, size * nitems);
+    while (line.size() && (line.back() == '\r' || line.back() == '\n')) line.pop_back();
+
+    if (line.rfind("HTTP/", 0) == 0) {
+        // status line of a new response, only keep the headers of the last one
+        headers->clear();
+    } else {
+        size_t colon = line.find(':');
+        if (colon != std::string::npos && colon) {
+            size_t value = line.find_first_not_of(" \t", colon + 1);
+            headers->emplace_back(line.substr(0, colon), value == std::string::npos ? "" : line.substr(value));
+        }
+    }
+
+    return size * nitems;
+}
+
+Http_Cache::Http_Cache() : Http_Cache(Local_Storage::get_game_settings_path() + "http" + PATH_SEPARATOR)
+{
+}
+
+Http_Cache::Http_Cache(const std::string &http_folder) : http_folder(http_folder)
+{
+}
+
+Http_Cache *Http_Cache::get_instance()
+{
+    // shared by the client and the server Steam_HTTP, they read the same folder
+    static Http_Cache cache;
+    return &cache;
+}
+
+static bool same_header_name(const std::string &a, const std::string &b)
+{
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) { return std::tolower((unsigned char)x) == std::tolower((unsigned char)y); });
+}
+
+const std::string *Http_Cache::find_header(const Headers &headers, const std::string &name)
+{
+    for (auto &header : headers) {
+        if (same_header_name(header.first, name)) return &header.second;
+    }
+
+    return nullptr;
+}
+
+long long Http_Cache::freshness_lifetime(const Headers &headers, long long now)
+{
+    const std::string *cache_control = find_header(headers, "Cache-Control");
+    if (cache_control) {
+        std::string value = *cache_control;
+        std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) { return std::tolower(c); });
+        if (value.find("no-store") != std::string::npos || value.find("no-cache") != std::string::npos) return 0;
+
+        size_t max_age = value.find("max-age=");
+        if (max_age != std::string::npos) {
+            long long seconds = std::strtoll(value.c_str() + max_age + sizeof("max-age=") - 1, nullptr, 10);
+            return seconds > 0 ? seconds : 0;
+        }
+    }
+
+    long long date = now;
+    const std::string *date_header = find_header(headers, "Date");
+    if (date_header) {
+        long long parsed = curl_getdate(date_header->c_str(), nullptr);
+        if (parsed > 0) date = parsed;
+    }
+
+    const std::string *expires = find_header(headers, "Expires");
+    if (expires) {
+        // invalid dates mean it's already expired
+        long long parsed = curl_getdate(expires->c_str(), nullptr);
+        return parsed > date ? parsed - date : 0;
+    }
+
+    // same heuristic as browsers: a tenth of the time since it was last modified
+    const std::string *last_modified = find_header(headers, "Last-Modified");
+    if (last_modified) {
+        long long parsed = curl_getdate(last_modified->c_str(), nullptr);
+        if (parsed > 0 && date > parsed) return (date - parsed) / 10;
+    }
+
+    return 0;
+}
+
+void Http_Cache::load_index()
+{
+    if (index_loaded) return;
+    index_loaded = true;
+
+    std::string path = http_folder + index_file_name;
+    unsigned int size = file_size_(path);
+    if (!size) return;
+
+    std::string data(size, '\0');
+    int read = Local_Storage::get_file_data(path, &data[0], size, 0);
+    if (read <= 0) return;
+    data.resize(read);
+
+    nlohmann::json loaded = nlohmann::json::parse(data, nullptr, false);
+    if (loaded.is_object()) {
+        index = std::move(loaded);
+        PRINT_DEBUG("Http_Cache: loaded %zu downloaded files\n", index.size());
+    } else {
+        PRINT_DEBUG("Http_Cache: ignoring invalid %s\n", path.c_str());
+    }
+}
+
+void Http_Cache::save_index()
+{
+    std::string data = index.dump(4);
+    Local_Storage::store_file_data(http_folder, index_file_name, (char *)data.data(), data.size());
+}
+
+void Http_Cache::forget_body(const std::string &relative_path)
+{
+    auto body = bodies.find(relative_path);
+    if (body == bodies.end()) return;
+
+    bodies_size -= body->second.size;
+    bodies.erase(body);
+}
+
+std::shared_ptr<const std::string> Http_Cache::remember_body(const std::string &relative_path, std::string &&data)
+{
+    forget_body(relative_path);
+
+    std::shared_ptr<const std::string> shared = std::make_shared<const std::string>(std::move(data));
+    std::string file_path = http_folder + relative_path;
+    unsigned long long size = file_size_(file_path);
+    // only kept if it's what is on disk, otherwise the next request reads the file again
+    if (size != shared->size() || size > MAX_BODIES_SIZE) return shared;
+
+    bodies[relative_path] = Body{get_file_mtime(file_path), size, shared, ++use_counter};
+    bodies_size += size;
+
+    while (bodies_size > MAX_BODIES_SIZE) {
+        auto oldest = bodies.end();
+        for (auto it = bodies.begin(); it != bodies.end(); ++it) {
+            if (it->first == relative_path) continue;
+            if (oldest == bodies.end() || it->second.last_use < oldest->second.last_use) oldest = it;
+        }
+
+        if (oldest == bodies.end()) break;
+        bodies_size -= oldest->second.size;
+        bodies.erase(oldest);
+    }
+
+    return shared;
+}
+
+std::shared_ptr<const std::string> Http_Cache::load_body(const std::string &relative_path)
+{
+    std::string file_path = http_folder + relative_path;
+    unsigned long long size = file_size_(file_path);
+
+    auto body = bodies.find(relative_path);
+    if (body != bodies.end()) {
+        if (body->second.size == size && body->second.mtime == get_file_mtime(file_path)) {
+            body->second.last_use = ++use_counter;
+            return body->second.data;
+        }
+
+        forget_body(relative_path);
+    }
+
+    if (!size) return nullptr;
+
+    std::string data(size, '\0');
+    int read = Local_Storage::get_file_data(file_path, &data[0], size, 0);
+    if (read <= 0) return nullptr;
+    data.resize(read);
+    return remember_body(relative_path, std::move(data));
+}
+
+bool Http_Cache::download(const std::string &url, const nlohmann::json *validators, long *status, std::string *data, Headers *headers)
+{
+    CURL *chttp = curl_easy_init();
+    if (!chttp) return false;
+
+    struct curl_slist *request_headers = nullptr;
+    if (validators) {
+        std::string etag = validators->value("etag", std::string());
+        std::string last_modified = validators->value("last_modified", std::string());
+        if (etag.size()) request_headers = curl_slist_append(request_headers, ("If-None-Match: " + etag).c_str());
+        if (last_modified.size()) request_headers = curl_slist_append(request_headers, ("If-Modified-Since: " + last_modified).c_str());
+    }
+
+    curl_easy_setopt(chttp, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(chttp, CURLOPT_WRITEFUNCTION, curl_write_data);
+    curl_easy_setopt(chttp, CURLOPT_WRITEDATA, (void *)data);
+    curl_easy_setopt(chttp, CURLOPT_HEADERFUNCTION, curl_write_header);
+    curl_easy_setopt(chttp, CURLOPT_HEADERDATA, (void *)headers);
+    if (request_headers) curl_easy_setopt(chttp, CURLOPT_HTTPHEADER, request_headers);
+    curl_easy_setopt(chttp, CURLOPT_TIMEOUT, 60L);
+    curl_easy_setopt(chttp, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(chttp, CURLOPT_USE_SSL, CURLUSESSL_TRY);
+    CURLcode result = curl_easy_perform(chttp);
+    *status = 0;
+    curl_easy_getinfo(chttp, CURLINFO_RESPONSE_CODE, status);
+    curl_easy_cleanup(chttp);
+    curl_slist_free_all(request_headers);
+
+    PRINT_DEBUG("Http_Cache::download %s result: %i status: %li size: %zu\n", url.c_str(), (int)result, *status, data->size());
+    return result == CURLE_OK;
+}
+
+Http_Cache::Response Http_Cache::fetch(const std::string &url, const std::string &relative_path, bool online)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    load_index();
+    download_finished.wait(lock, [&]() { return !downloading.count(relative_path); });
+
+    Response response;
+    std::string file_path = http_folder + relative_path;
+    unsigned long long file_size = file_size_(file_path);
+    long long now = unix_time_now();
+
+    auto entry = index.find(relative_path);
+    if (entry != index.end() && (!file_size || entry->value("size", 0ULL) != file_size || entry->value("mtime", -1LL) != get_file_mtime(file_path))) {
+        // deleted or replaced by hand, it's not a download anymore
+        index.erase(entry);
+        save_index();
+        entry = index.end();
+    }
+
+    bool downloaded = entry != index.end();
+    if (downloaded) {
+        for (auto &header : (*entry)["headers"]) {
+            if (header.is_array() && header.size() == 2) response.headers.emplace_back(header[0].get<std::string>(), header[1].get<std::string>());
+        }
+    }
+
+    // files that weren't downloaded are never replaced
+    if (file_size && (!online || !downloaded || now < entry->value("fresh_until", 0LL))) {
+        response.body = load_body(relative_path);
+        return response;
+    }
+
+    if (!online) return response;
+
+    long status = 0;
+    std::string data;
+    Headers headers;
+    nlohmann::json validators = downloaded ? *entry : nlohmann::json();
+    downloading.insert(relative_path);
+    lock.unlock();
+    bool success = download(url, downloaded ? &validators : nullptr, &status, &data, &headers);
+    lock.lock();
+    downloading.erase(relative_path);
+    download_finished.notify_all();
+
+    // the index can change during the download, but not the entry of this file
+    entry = index.find(relative_path);
+    downloaded = entry != index.end();
+
+    if (success && status == 304 && downloaded) {
+        // the 304 only has the headers that changed
+        for (auto &header : headers) {
+            auto existing = std::find_if(response.headers.begin(), response.headers.end(), [&header](const std::pair<std::string, std::string> &h) { return same_header_name(h.first, header.first); });
+            if (existing != response.headers.end()) {
+                existing->second = header.second;
+            } else {
+                response.headers.push_back(header);
+            }
+        }
+
+        nlohmann::json saved_headers = nlohmann::json::array();
+        for (auto &header : response.headers) saved_headers.push_back({header.first, header.second});
+        (*entry)["headers"] = saved_headers;
+        (*entry)["fresh_until"] = now + freshness_lifetime(response.headers, now);
+        save_index();
+
+        PRINT_DEBUG("Http_Cache: %s not modified\n", url.c_str());
+        response.body = load_body(relative_path);
+        return response;
+    }
+
+    if (!success || status < 200 || status >= 300) {
+        // an old copy is better than nothing
+        if (file_size) response.body = load_body(relative_path);
+        return response;
+    }
+
+    nlohmann::json new_entry = nlohmann::json::object();
+    new_entry["url"] = url;
+    new_entry["size"] = data.size();
+    new_entry["fresh_until"] = now + freshness_lifetime(headers, now);
+    const std::string *etag = find_header(headers, "ETag");
+    if (etag) new_entry["etag"] = *etag;
+    const std::string *last_modified = find_header(headers, "Last-Modified");
+    if (last_modified) new_entry["last_modified"] = *last_modified;
+    nlohmann::json saved_headers = nlohmann::json::array();
+    for (auto &header : headers) saved_headers.push_back({header.first, header.second});
+    new_entry["headers"] = saved_headers;
+
+    if (Local_Storage::store_file_data(http_folder, relative_path, (char *)data.data(), data.size()) == (int)data.size()) {
+        new_entry["mtime"] = get_file_mtime(file_path);
+        index[relative_path] = new_entry;
+    } else {
+        PRINT_DEBUG("Http_Cache: could not save %s\n", file_path.c_str());
+        if (downloaded) index.erase(relative_path);
+    }
+
+    save_index();
+    response.headers = std::move(headers);
+    response.body = remember_body(relative_path, std::move(data));
+    return response;
+}
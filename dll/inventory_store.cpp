@@ -0,0 +1,140 @@
+#include "dll/inventory_store.h"
+
+
+static bool parse_id(const std::string &key, long long &id)
+{
+    if (key.empty()) return false;
+
+    char *end = nullptr;
+    id = std::strtoll(key.c_str(), &end, 10);
+    return end && *end == '\0';
+}
+
+void Inventory_Store::load_definitions(const nlohmann::json &json)
+{
+    definitions.clear();
+    definition_index.clear();
+    if (!json.is_object()) return;
+
+    definitions.reserve(json.size());
+    for (auto &entry : json.items()) {
+        long long id;
+        if (!parse_id(entry.key(), id)) {
+            PRINT_DEBUG("Inventory_Store: ignoring item definition \"%s\"\n", entry.key().c_str());
+            continue;
+        }
+
+        if (definition_index.count((SteamItemDef_t)id)) continue;
+
+        Definition definition{};
+        definition.id = (SteamItemDef_t)id;
+        if (entry.value().is_object()) {
+            definition.properties.reserve(entry.value().size());
+            // json objects are sorted by key, which find_property relies on
+            for (auto &property : entry.value().items()) {
+                bool is_string = property.value().is_string();
+                definition.properties.push_back(Property{property.key(), is_string ? property.value().get<std::string>() : std::string(), is_string});
+
+                if (definition.property_names.size()) definition.property_names.push_back(',');
+                definition.property_names.append(property.key());
+            }
+        }
+
+        definition_index[definition.id] = (uint32)definitions.size();
+        definitions.push_back(std::move(definition));
+    }
+
+    PRINT_DEBUG("Inventory_Store: loaded %zu item definitions\n", definitions.size());
+}
+
+void Inventory_Store::load_items(const nlohmann::json &json)
+{
+    items.clear();
+    item_index.clear();
+    if (!json.is_object()) return;
+
+    items.reserve(json.size());
+    for (auto &entry : json.items()) {
+        long long id;
+        if (!parse_id(entry.key(), id)) {
+            PRINT_DEBUG("Inventory_Store: ignoring item \"%s\"\n", entry.key().c_str());
+            continue;
+        }
+
+        SteamItemDetails_t item{};
+        item.m_iDefinition = (SteamItemDef_t)id;
+        item.m_itemId = (SteamItemInstanceID_t)item.m_iDefinition;
+        item.m_unQuantity = entry.value().is_number() ? (uint16)entry.value().get<int>() : 0;
+        item.m_unFlags = k_ESteamItemNoTrade;
+        if (item_index.count(item.m_itemId)) continue;
+
+        item_index[item.m_itemId] = (uint32)items.size();
+        items.push_back(item);
+    }
+
+    PRINT_DEBUG("Inventory_Store: loaded %zu items\n", items.size());
+}
+
+nlohmann::json Inventory_Store::items_to_json(const std::vector<SteamItemDetails_t> &items)
+{
+    nlohmann::json json = nlohmann::json::object();
+    for (auto &item : items) {
+        json[std::to_string(item.m_iDefinition)] = item.m_unQuantity;
+    }
+
+    return json;
+}
+
+const std::vector<Inventory_Store::Definition> &Inventory_Store::get_definitions() const
+{
+    return definitions;
+}
+
+const Inventory_Store::Definition *Inventory_Store::find_definition(SteamItemDef_t id) const
+{
+    auto index = definition_index.find(id);
+    if (index == definition_index.end()) return nullptr;
+    return &definitions[index->second];
+}
+
+const Inventory_Store::Property *Inventory_Store::find_property(const Definition &definition, const char *name)
+{
+    auto property = std::lower_bound(definition.properties.begin(), definition.properties.end(), name, [](const Property &p, const char *n) { return p.name.compare(n) < 0; });
+    if (property == definition.properties.end() || property->name.compare(name) != 0) return nullptr;
+    return &(*property);
+}
+
+const std::vector<SteamItemDetails_t> &Inventory_Store::get_items() const
+{
+    return items;
+}
+
+const SteamItemDetails_t *Inventory_Store::find_item(SteamItemInstanceID_t id) const
+{
+    auto index = item_index.find(id);
+    if (index == item_index.end()) return nullptr;
+    return &items[index->second];
+}
+
+bool Inventory_Store::consume_item(SteamItemInstanceID_t id, uint32 quantity)
+{
+    auto index = item_index.find(id);
+    if (index == item_index.end()) return false;
+
+    uint32 position = index->second;
+    SteamItemDetails_t &item = items[position];
+    PRINT_DEBUG("Inventory_Store::consume_item previous %u\n", (uint32)item.m_unQuantity);
+    if (item.m_unQuantity > quantity) {
+        item.m_unQuantity -= (uint16)quantity;
+        return true;
+    }
+
+    // keep the order of the remaining items, consuming is rare compared to reading
+    item_index.erase(index);
+    items.erase(items.begin() + position);
+    for (uint32 i = position; i < items.size(); ++i) {
+        item_index[items[i].m_itemId] = i;
+    }
+
+    return true;
+}
@@ -174,11 +174,50 @@ std::string Local_Storage::load_image_resized(std::string const& image_path, std
     return "";
 }
 
-bool Local_Storage::save_screenshot(std::string const& image_path, uint8_t* img_ptr, int32_t width, int32_t height, int32_t channels)
+std::string Local_Storage::load_image_data(std::string const& image_path, std::string const& encoded_data, int *width, int *height)
+{
+    return "";
+}
+
+std::string Local_Storage::resize_image(std::string const& image_data, int width, int height, int resolution)
+{
+    return "";
+}
+
+std::string Local_Storage::encode_image_png(std::string const& image_data, int width, int height)
+{
+    return "";
+}
+
+std::string Local_Storage::scale_image(const uint8_t *image_data, int width, int height, int channels, int new_width, int new_height)
+{
+    return "";
+}
+
+bool Local_Storage::get_image_size(std::string const& image_path, int *width, int *height)
 {
     return false;
 }
 
+void Local_Storage::set_png_compression_level(int level)
+{
+}
+
+bool Local_Storage::save_screenshot(std::string const& image_path, const uint8_t* img_ptr, int32_t width, int32_t height, int32_t channels, int jpg_quality)
+{
+    return false;
+}
+
+bool Local_Storage::copy_screenshot(std::string const& image_path, std::string const& source_path)
+{
+    return false;
+}
+
+std::string Local_Storage::get_screenshot_path(std::string const& image_path)
+{
+    return "";
+}
+
 std::string Local_Storage::sanitize_string(std::string name)
 {
     return "";
@@ -839,36 +878,119 @@ std::vector<image_pixel_t> Local_Storage::load_image(std::string const& image_pa
 std::string Local_Storage::load_image_resized(std::string const& image_path, std::string const& image_data, int resolution)
 {
     std::string resized_image(resolution * resolution * 4, 0);
-    char *resized_img = (char*)malloc(sizeof(char) * resolution * resolution * 4);
-    PRINT_DEBUG("Local_Storage::load_image_resized: %s for resized image (%i)\n", (resized_img == nullptr ? "could not allocate memory" : "memory allocated"), (resolution * resolution * 4));
-
-    if (resized_img != nullptr) {
-        if (image_path.length() > 0) {
-            int width, height;
-            unsigned char *img = stbi_load(image_path.c_str(), &width, &height, nullptr, 4);
-            PRINT_DEBUG("Local_Storage::load_image_resized: \"%s\" %s\n", image_path.c_str(), (img == nullptr ? stbi_failure_reason() : "loaded"));
-            if (img != nullptr) {
-                stbir_resize_uint8(img, width, height, 0, (unsigned char*)resized_img, resolution, resolution, 0, 4);
-                resized_image = std::string(resized_img, resolution * resolution * 4);
-                stbi_image_free(img);
-            }
-        } else if (image_data.length() > 0) {
-            stbir_resize_uint8((unsigned char*)image_data.c_str(), 184, 184, 0, (unsigned char*)resized_img, resolution, resolution, 0, 4);
-            resized_image = std::string(resized_img, resolution * resolution * 4);
+
+    if (image_path.length() > 0) {
+        int width, height;
+        std::string img = load_image_data(image_path, "", &width, &height);
+        if (img.size()) {
+            resized_image = resize_image(img, width, height, resolution);
         }
-        free(resized_img);
+    } else if (image_data.length() > 0) {
+        resized_image = resize_image(image_data, 184, 184, resolution);
     }
 
     reset_LastError();
     return resized_image;
 }
 
-bool Local_Storage::save_screenshot(std::string const& image_path, uint8_t* img_ptr, int32_t width, int32_t height, int32_t channels)
+std::string Local_Storage::load_image_data(std::string const& image_path, std::string const& encoded_data, int *width, int *height)
+{
+    std::string image;
+    unsigned char *img;
+    if (image_path.length() > 0) {
+        img = stbi_load(image_path.c_str(), width, height, nullptr, 4);
+        PRINT_DEBUG("Local_Storage::load_image_data: \"%s\" %s\n", image_path.c_str(), (img == nullptr ? stbi_failure_reason() : "loaded"));
+    } else {
+        img = stbi_load_from_memory((const stbi_uc *)encoded_data.data(), encoded_data.size(), width, height, nullptr, 4);
+        PRINT_DEBUG("Local_Storage::load_image_data: %zu bytes %s\n", encoded_data.size(), (img == nullptr ? stbi_failure_reason() : "loaded"));
+    }
+
+    if (img != nullptr) {
+        image = std::string((char *)img, (size_t)*width * *height * 4);
+        stbi_image_free(img);
+    }
+
+    reset_LastError();
+    return image;
+}
+
+std::string Local_Storage::resize_image(std::string const& image_data, int width, int height, int resolution)
+{
+    if (width == resolution && height == resolution) return image_data;
+
+    std::string resized_image(resolution * resolution * 4, 0);
+    if (image_data.size() >= (size_t)width * height * 4) {
+        stbir_resize_uint8((const unsigned char *)image_data.data(), width, height, 0, (unsigned char *)&resized_image[0], resolution, resolution, 0, 4);
+    }
+
+    return resized_image;
+}
+
+static void write_to_string(void *context, void *data, int size)
+{
+    ((std::string *)context)->append((char *)data, size);
+}
+
+std::string Local_Storage::encode_image_png(std::string const& image_data, int width, int height)
+{
+    std::string png;
+    if (image_data.size() < (size_t)width * height * 4) return png;
+
+    if (!stbi_write_png_to_func(write_to_string, &png, width, height, 4, image_data.data(), 0)) png.clear();
+    return png;
+}
+
+std::string Local_Storage::scale_image(const uint8_t *image_data, int width, int height, int channels, int new_width, int new_height)
+{
+    std::string scaled_image((size_t)new_width * new_height * channels, 0);
+    if (!stbir_resize_uint8(image_data, width, height, 0, (unsigned char *)&scaled_image[0], new_width, new_height, 0, channels)) scaled_image.clear();
+    return scaled_image;
+}
+
+bool Local_Storage::get_image_size(std::string const& image_path, int *width, int *height)
+{
+    int channels;
+    bool ret = stbi_info(image_path.c_str(), width, height, &channels) == 1;
+    reset_LastError();
+    return ret;
+}
+
+void Local_Storage::set_png_compression_level(int level)
+{
+    stbi_write_png_compression_level = level;
+}
+
+bool Local_Storage::save_screenshot(std::string const& image_path, const uint8_t* img_ptr, int32_t width, int32_t height, int32_t channels, int jpg_quality)
+{
+    std::string screenshot_path = save_directory + appid + screenshots_folder + PATH_SEPARATOR + image_path;
+    create_directory(screenshot_path.substr(0, screenshot_path.find_last_of("/\\")));
+
+    bool ret;
+    std::string extension = screenshot_path.substr(screenshot_path.size() - std::min<size_t>(screenshot_path.size(), 4));
+    if (extension == ".jpg") {
+        ret = stbi_write_jpg(screenshot_path.c_str(), width, height, channels, img_ptr, jpg_quality) == 1;
+    } else {
+        ret = stbi_write_png(screenshot_path.c_str(), width, height, channels, img_ptr, 0) == 1;
+    }
+
+    reset_LastError();
+    return ret;
+}
+
+bool Local_Storage::copy_screenshot(std::string const& image_path, std::string const& source_path)
+{
+    std::string screenshot_path = save_directory + appid + screenshots_folder + PATH_SEPARATOR + image_path;
+    create_directory(screenshot_path.substr(0, screenshot_path.find_last_of("/\\")));
+
+    std::error_code ec;
+    bool ret = std::filesystem::copy_file(std::filesystem::u8path(source_path), std::filesystem::u8path(screenshot_path), std::filesystem::copy_options::overwrite_existing, ec);
+    reset_LastError();
+    return ret && !ec;
+}
+
+std::string Local_Storage::get_screenshot_path(std::string const& image_path)
 {
-    std::string screenshot_path = std::move(save_directory + appid + screenshots_folder + PATH_SEPARATOR); 
-    create_directory(screenshot_path);
-    screenshot_path += image_path;
-    return stbi_write_png(screenshot_path.c_str(), width, height, channels, img_ptr, 0) == 1;
+    return save_directory + appid + screenshots_folder + PATH_SEPARATOR + image_path;
 }
 
 std::string Local_Storage::sanitize_string(std::string name)
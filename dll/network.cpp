@@ -24,8 +24,26 @@ static IP_PORT broadcasts[MAX_BROADCASTS];
 static uint32_t lower_range_ips[MAX_BROADCASTS];
 static uint32_t upper_range_ips[MAX_BROADCASTS];
 
-#define BROADCAST_INTERVAL 5.0
+// announces start this often and back off to the steady interval, peers keep connections alive with
+// their pongs and the tcp heartbeats so the steady interval has to stay below USER_TIMEOUT
+#define ANNOUNCE_BURST_INTERVAL 0.1
+#define ANNOUNCE_STEADY_INTERVAL 10.0
 #define HEARTBEAT_TIMEOUT 20.0
+// membership is spread SWIM style: a known peer is pinged every PROBE_INTERVAL and the pongs carry
+// at most MAX_ANNOUNCE_PEERS new peers, each one mentioned GOSSIP_FACTOR * log2(peers) times
+#define PROBE_INTERVAL 1.0
+#define MAX_ANNOUNCE_PEERS 8
+#define GOSSIP_FACTOR 3
+#define MAX_PROBES_PER_RUN 8
+// the link of every connected peer is measured with a probe over udp this often, a probe that
+// isn't answered after LINK_PROBE_TIMEOUT counts as lost
+#define LINK_PROBE_INTERVAL 1.0
+#define LINK_PROBE_TIMEOUT 2.0
+#define LINK_LOSS_WINDOW 32
+#define LINK_RATE_INTERVAL 1.0
+#define LINK_DUMP_INTERVAL 10.0
+// known peers get at most one pong this often, the broadcasts of every peer would get N replies otherwise
+#define PONG_INTERVAL 1.0
 #define USER_TIMEOUT 20.0
 
 #define MAX_UDP_SIZE 16384
@@ -316,7 +334,8 @@ static int receive_packet(sock_t sock, IP_PORT *ip_port, char *data, unsigned lo
     return -1;
 }
 
-static bool send_broadcasts(sock_t sock, uint16 port, char *data, unsigned long length, std::vector<IP_PORT> *custom_broadcasts)
+// multicast_ip in network byte order, when set it replaces the broadcasts to every interface
+static bool send_broadcasts(sock_t sock, uint16 port, char *data, unsigned long length, std::vector<IP_PORT> *custom_broadcasts, uint32 multicast_ip)
 {
     static std::chrono::high_resolution_clock::time_point last_get_broadcast_info;
     if (number_broadcasts < 0 || check_timedout(last_get_broadcast_info, 60.0)) {
@@ -332,17 +351,24 @@ static bool send_broadcasts(sock_t sock, uint16 port, char *data, unsigned long
         last_get_broadcast_info = std::chrono::high_resolution_clock::now();
     }
 
-    IP_PORT main_broadcast;
-    main_broadcast.ip = INADDR_BROADCAST;
-    main_broadcast.port = port;
-    int ret = send_packet_to(sock, main_broadcast, data, length);
+    if (multicast_ip) {
+        IP_PORT group;
+        group.ip = multicast_ip;
+        group.port = port;
+        send_packet_to(sock, group, data, length);
+    } else {
+        IP_PORT main_broadcast;
+        main_broadcast.ip = INADDR_BROADCAST;
+        main_broadcast.port = port;
+        int ret = send_packet_to(sock, main_broadcast, data, length);
 
-    if (!number_broadcasts)
-        return false;
+        if (!number_broadcasts)
+            return false;
 
-    for (int i = 0; i < number_broadcasts; i++) {
-        ret = send_packet_to(sock, broadcasts[i], data, length);
-        IP_PORT ip_port = broadcasts[i];
+        for (int i = 0; i < number_broadcasts; i++) {
+            ret = send_packet_to(sock, broadcasts[i], data, length);
+            IP_PORT ip_port = broadcasts[i];
+        }
     }
 
     /** 
@@ -531,6 +557,16 @@ std::set<IP_PORT> Networking::resolve_ip(std::string dns)
     return ips;
 }
 
+//game data between interfaces of the same process, their callbacks only queue it so it can be delivered
+//from inside sendTo, the other messages can trigger replies and wait for the next Run
+static bool is_local_fast_path(Common_Message *msg)
+{
+    if (msg->has_network()) return true;
+    if (msg->has_networking_sockets()) return msg->networking_sockets().type() == Networking_Sockets::DATA;
+    if (msg->has_networking_messages()) return msg->networking_messages().type() == Networking_Messages::DATA;
+    return false;
+}
+
 void Networking::do_callbacks_message(Common_Message *msg)
 {
     if (msg->has_network() || msg->has_network_old()) {
@@ -548,6 +584,11 @@ void Networking::do_callbacks_message(Common_Message *msg)
         run_callbacks(CALLBACK_ID_LOBBY, msg);
     }
 
+    if (msg->has_lobby_delta()) {
+        PRINT_DEBUG("has_lobby_delta\n");
+        run_callbacks(CALLBACK_ID_LOBBY, msg);
+    }
+
     if (msg->has_gameserver()) {
         PRINT_DEBUG("has_gameserver\n");
         run_callbacks(CALLBACK_ID_GAMESERVER, msg);
@@ -667,6 +708,37 @@ struct Connection *Networking::new_connection(CSteamID search_id, uint32 appid)
     return &(connections[connections.size() - 1]);
 }
 
+void Networking::connect_tcp(struct Connection &conn)
+{
+    sock_t sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (is_socket_valid(sock) && set_socket_nonblocking(sock)) {
+        PRINT_DEBUG("NEW SOCKET %u %u\n", sock, conn.tcp_socket_outgoing.sock);
+        disable_nagle(sock);
+        connect_socket(sock, conn.tcp_ip_port);
+        conn.tcp_socket_outgoing.sock = sock;
+        conn.tcp_socket_outgoing.last_heartbeat_received = std::chrono::high_resolution_clock::now();
+        Common_Message msg;
+        msg.set_source_id(ids[0].ConvertToUint64());
+        send_buffer_tcp(conn.tcp_socket_outgoing, &msg);
+    }
+}
+
+static uint32 gossip_repeat(size_t peers)
+{
+    uint32 log2 = 1;
+    while (peers >>= 1) ++log2;
+    return GOSSIP_FACTOR * log2;
+}
+
+void Networking::send_udp_to(Common_Message *msg, IP_PORT ip_port)
+{
+    size_t size = msg->ByteSizeLong();
+    char buffer[MAX_UDP_SIZE];
+    if (size > sizeof(buffer)) return;
+    msg->SerializeToArray(buffer, size);
+    send_packet_to(udp_socket, ip_port, buffer, size);
+}
+
 bool Networking::handle_announce(Common_Message *msg, IP_PORT ip_port)
 {
     Connection *conn = find_connection((uint64)msg->source_id(), msg->announce().appid());
@@ -685,56 +757,106 @@ bool Networking::handle_announce(Common_Message *msg, IP_PORT ip_port)
         add_id_connection(conn, (uint64) msg->announce().ids(i));
     }
 
+    //older versions send every peer they know, newer ones only the recent ones
     for (int i = 0; i < msg->announce().peers_size(); ++i) {
-        CSteamID search_id((uint64)msg->announce().peers(i).id());
+        const Announce_Other_Peers &peer = msg->announce().peers(i);
+        CSteamID search_id((uint64)peer.id());
         auto id_temp = std::find(ids.begin(), ids.end(), search_id);
         if (id_temp != ids.end()) {
-            own_ip = ntohl(msg->announce().peers(i).ip());
+            own_ip = ntohl(peer.ip());
+            continue;
         }
 
-        Connection *conn = find_connection((uint64)msg->announce().peers(i).id(), msg->announce().peers(i).appid());
-        PRINT_DEBUG("%p %u %u " "%" PRIu64 "\n", conn, conn ? conn->appid : (uint32)0, msg->announce().peers(i).appid(), msg->announce().peers(i).id());
-        if (!conn || conn->appid != msg->announce().peers(i).appid()) {
-            Common_Message msg_ = create_announce(true);
-
-            size_t size = msg_.ByteSizeLong();
-            char *buffer = new char[size];
-            msg_.SerializeToArray(buffer, size);
+        Connection *peer_conn = find_connection((uint64)peer.id(), peer.appid());
+        PRINT_DEBUG("%p %u %u " "%" PRIu64 "\n", peer_conn, peer_conn ? peer_conn->appid : (uint32)0, peer.appid(), peer.id());
+        if (!peer_conn || peer_conn->appid != peer.appid()) {
             IP_PORT ipp;
-            ipp.ip = msg->announce().peers(i).ip();
-            ipp.port = htons(msg->announce().peers(i).udp_port());
-            send_packet_to(udp_socket, ipp, buffer, size);
-            delete[] buffer;
+            ipp.ip = peer.ip();
+            ipp.port = htons(peer.udp_port());
+            pending_probes.insert(ipp);
         }
     }
 
     conn->last_received = std::chrono::high_resolution_clock::now();
 
     if (msg->announce().type() == Announce::PING) {
-        Common_Message msg = create_announce(false);
-        size_t size = msg.ByteSizeLong(); 
-        char *buffer = new char[size];
-        msg.SerializeToArray(buffer, size);
-        send_packet_to(udp_socket, ip_port, buffer, size);
-        delete[] buffer;
+        Message_Arena::Scope scope(message_arena);
+        if (!conn->udp_pinged || check_timedout(conn->last_pong_sent, PONG_INTERVAL)) {
+            send_udp_to(create_announce(scope, false, conn, ip_port), ip_port);
+            conn->last_pong_sent = std::chrono::high_resolution_clock::now();
+        }
 
         //send ping packet if not pinged
         if (!conn->udp_pinged) {
-            Common_Message msg = create_announce(true);
-            size_t size = msg.ByteSizeLong(); 
-            char *buffer = new char[size];
-            msg.SerializeToArray(buffer, size);
-            send_packet_to(udp_socket, ip_port, buffer, size);
-            delete[] buffer;
+            send_udp_to(create_announce(scope, true), ip_port);
         }
     } else if (msg->announce().type() == Announce::PONG) {
+        if (!conn->udp_pinged) {
+            //a new member, the next pongs spread it to the others
+            conn->gossip_left = gossip_repeat(connections.size());
+        }
+
         conn->udp_ip_port = ip_port;
         conn->udp_pinged = true;
+
+        //the peer is known to be listening, start the tcp connection now instead of at the end of Run
+        if (!is_tcp_socket_valid(conn->tcp_socket_outgoing)) {
+            connect_tcp(*conn);
+        }
     }
 
     return true;
 }
 
+void Networking::send_probes()
+{
+    if (!pending_probes.empty()) {
+        //the same ping for every one of them
+        Message_Arena::Scope scope(message_arena);
+        Common_Message *msg = create_announce(scope, true);
+        size_t size = msg->ByteSizeLong();
+        char buffer[MAX_UDP_SIZE];
+        if (size <= sizeof(buffer)) {
+            msg->SerializeToArray(buffer, size);
+            unsigned sent = 0;
+            auto probe = pending_probes.begin();
+            while (probe != pending_probes.end() && sent < MAX_PROBES_PER_RUN) {
+                IP_PORT ipp = *probe;
+                bool known = std::any_of(connections.begin(), connections.end(), [&ipp](struct Connection const& conn) { return conn.udp_pinged && conn.udp_ip_port.ip == ipp.ip && conn.udp_ip_port.port == ipp.port; });
+                if (!known) {
+                    send_packet_to(udp_socket, ipp, buffer, size);
+                    ++sent;
+                }
+
+                probe = pending_probes.erase(probe);
+            }
+        }
+    }
+
+    if (connections.empty() || !check_timedout(last_probe, PROBE_INTERVAL)) return;
+    last_probe = std::chrono::high_resolution_clock::now();
+
+    for (size_t i = 0; i < connections.size(); ++i) {
+        struct Connection &conn = connections[(next_probe + i) % connections.size()];
+        if (!conn.udp_pinged) continue;
+
+        next_probe = (next_probe + i + 1) % connections.size();
+        Message_Arena::Scope scope(message_arena);
+        send_udp_to(create_announce(scope, true), conn.udp_ip_port);
+        break;
+    }
+}
+
+static uint64 link_clock_us()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static double seconds_since(std::chrono::steady_clock::time_point time, std::chrono::steady_clock::time_point now)
+{
+    return std::chrono::duration_cast<std::chrono::duration<double>>(now - time).count();
+}
+
 bool Networking::handle_low_level_udp(Common_Message *msg, IP_PORT ip_port)
 {
     //TODO: connection appid
@@ -749,16 +871,111 @@ bool Networking::handle_low_level_udp(Common_Message *msg, IP_PORT ip_port)
         case Low_Level::HEARTBEAT:
             
             break;
+        case Low_Level::PROBE: {
+            Message_Arena::Scope scope(message_arena);
+            Common_Message *reply = scope.create<Common_Message>();
+            Low_Level *low_level = scope.create<Low_Level>();
+            low_level->set_type(Low_Level::PROBE_REPLY);
+            low_level->set_probe_sequence(msg->low_level().probe_sequence());
+            low_level->set_probe_time(msg->low_level().probe_time());
+            reply->set_allocated_low_level(low_level);
+            reply->set_source_id(ids[0].ConvertToUint64());
+            send_udp_to(reply, ip_port);
+            connection->last_received = std::chrono::high_resolution_clock::now();
+            return true;
+        }
+        case Low_Level::PROBE_REPLY: {
+            struct Link_Metrics &link = connection->link;
+            uint32 sequence = msg->low_level().probe_sequence();
+            auto probe = std::find_if(link.probes.begin(), link.probes.end(), [sequence](struct Link_Probe const& p) { return p.sequence == sequence; });
+            uint64 now = link_clock_us();
+            //duplicates and replies to forgotten probes would skew the numbers
+            if (probe == link.probes.end() || probe->replied || msg->low_level().probe_time() > now) return false;
+            probe->replied = true;
+
+            double rtt = (now - msg->low_level().probe_time()) / 1000.0;
+            if (link.srtt < 0) {
+                link.srtt = rtt;
+            } else {
+                //same smoothing as tcp for the rtt and as rtp (RFC 3550) for the jitter
+                link.srtt += (rtt - link.srtt) / 8.0;
+                link.jitter += (std::abs(rtt - link.last_rtt) - link.jitter) / 16.0;
+            }
+
+            link.last_rtt = rtt;
+            connection->last_received = std::chrono::high_resolution_clock::now();
+            return true;
+        }
     }
 
     return false;
 }
 
+void Networking::send_link_probes()
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    for (auto &conn: connections) {
+        if (!conn.udp_pinged || !conn.connected) continue;
+
+        struct Link_Metrics &link = conn.link;
+        if (seconds_since(link.last_probe, now) < LINK_PROBE_INTERVAL) continue;
+
+        Message_Arena::Scope scope(message_arena);
+        Common_Message *msg = scope.create<Common_Message>();
+        Low_Level *low_level = scope.create<Low_Level>();
+        low_level->set_type(Low_Level::PROBE);
+        low_level->set_probe_sequence(link.next_sequence);
+        low_level->set_probe_time(link_clock_us());
+        msg->set_allocated_low_level(low_level);
+        msg->set_source_id(ids[0].ConvertToUint64());
+        send_udp_to(msg, conn.udp_ip_port);
+
+        link.probes.push_back(Link_Probe{link.next_sequence, now, false});
+        while (link.probes.size() > LINK_LOSS_WINDOW) link.probes.pop_front();
+        ++link.next_sequence;
+        link.last_probe = now;
+    }
+}
+
+void Networking::update_link_rates()
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    for (auto &conn: connections) {
+        struct Link_Metrics &link = conn.link;
+        double elapsed = seconds_since(link.last_rate_update, now);
+        if (elapsed < LINK_RATE_INTERVAL) continue;
+
+        //the first update only starts counting
+        if (elapsed < LINK_RATE_INTERVAL * 4) {
+            link.out_packets_per_sec = link.out_packets / elapsed;
+            link.out_bytes_per_sec = link.out_bytes / elapsed;
+            link.in_packets_per_sec = link.in_packets / elapsed;
+            link.in_bytes_per_sec = link.in_bytes / elapsed;
+        }
+
+        link.out_packets = link.out_bytes = link.in_packets = link.in_bytes = 0;
+        link.last_rate_update = now;
+    }
+
+#ifndef EMU_RELEASE_BUILD
+    if (check_timedout(last_link_dump, LINK_DUMP_INTERVAL)) {
+        last_link_dump = std::chrono::high_resolution_clock::now();
+        for (auto &conn: connections) {
+            struct Link_Stats stats;
+            if (!conn.connected || !getLinkStats(conn.ids[0], &stats)) continue;
+            PRINT_DEBUG("Networking link " "%" PRIu64 " %u: %s\n", conn.ids[0].ConvertToUint64(), conn.appid, linkStatsString(stats).c_str());
+        }
+    }
+#endif
+}
+
 #define NUM_TCP_WAITING 128
 
-Networking::Networking(CSteamID id, uint32 appid, uint16 port, std::set<IP_PORT> *custom_broadcasts, bool disable_sockets)
+Networking::Networking(CSteamID id, uint32 appid, uint16 port, std::set<IP_PORT> *custom_broadcasts, uint32 multicast_group, bool disable_sockets)
 {
     tcp_port = udp_port = port;
+    announce_interval = ANNOUNCE_BURST_INTERVAL;
+    this->multicast_group = 0;
     own_ip = 0x7F000001;
     last_run = std::chrono::high_resolution_clock::now();
     this->appid = appid;
@@ -803,6 +1020,20 @@ Networking::Networking(CSteamID id, uint32 appid, uint16 port, std::set<IP_PORT>
 
         if (!is_socket_valid(udp_socket)) {
             PRINT_DEBUG("UDP: could not bind socket\n");
+        } else if (multicast_group) {
+            struct ip_mreq mreq = {};
+            mreq.imr_multiaddr.s_addr = htonl(multicast_group);
+            mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+            if (setsockopt(udp_socket, IPPROTO_IP, IP_ADD_MEMBERSHIP, (char *)&mreq, sizeof(mreq)) == 0) {
+                //only the local network, and other instances on this machine must see the announces too
+                int ttl = 1, loop = 1;
+                setsockopt(udp_socket, IPPROTO_IP, IP_MULTICAST_TTL, (char *)&ttl, sizeof(ttl));
+                setsockopt(udp_socket, IPPROTO_IP, IP_MULTICAST_LOOP, (char *)&loop, sizeof(loop));
+                this->multicast_group = htonl(multicast_group);
+                PRINT_DEBUG("UDP: announcing to multicast group %X\n", multicast_group);
+            } else {
+                PRINT_DEBUG("UDP: could not join multicast group %X %i, using broadcasts\n", multicast_group, get_last_error());
+            }
         }
     } else {
         PRINT_DEBUG("UDP: could not initialize %i\n", get_last_error());
@@ -874,48 +1105,65 @@ Networking::~Networking()
     curl_global_cleanup();
 }
 
-Common_Message Networking::create_announce(bool request)
+Common_Message *Networking::create_announce(Message_Arena::Scope &scope, bool request, const struct Connection *to, IP_PORT to_ip_port)
 {
-    Announce *announce = new Announce();
+    Announce *announce = scope.create<Announce>();
     PRINT_DEBUG("Networking:: ids length %zu\n", ids.size());
     if (request) {
         announce->set_type(Announce::PING);
     } else {
         announce->set_type(Announce::PONG);
+        if (to) {
+            Announce_Other_Peers *peer = announce->add_peers();
+            peer->set_id(to->ids[0].ConvertToUint64());
+            peer->set_ip(to_ip_port.ip);
+            peer->set_udp_port(ntohs(to_ip_port.port));
+            peer->set_appid(to->appid);
+        }
+
+        //the most recently learned peers first, they have the most repeats left
+        std::vector<struct Connection *> recent;
         for (auto &conn: connections) {
-            PRINT_DEBUG("Connection %u %llu %u\n", conn.udp_pinged, conn.ids[0].ConvertToUint64(), conn.appid);
-            if (conn.udp_pinged) {
-                Announce_Other_Peers *peer = announce->add_peers();
-                peer->set_id(conn.ids[0].ConvertToUint64());
-                peer->set_ip(conn.udp_ip_port.ip);
-                peer->set_udp_port(ntohs(conn.udp_ip_port.port));
-                peer->set_appid(conn.appid);
-            }
+            if (conn.udp_pinged && conn.gossip_left && &conn != to) recent.push_back(&conn);
+        }
+
+        size_t count = std::min(recent.size(), (size_t)MAX_ANNOUNCE_PEERS);
+        std::partial_sort(recent.begin(), recent.begin() + count, recent.end(), [](struct Connection *a, struct Connection *b) { return a->gossip_left > b->gossip_left; });
+        for (size_t i = 0; i < count; ++i) {
+            struct Connection *conn = recent[i];
+            PRINT_DEBUG("Connection %u %llu %u\n", conn->udp_pinged, conn->ids[0].ConvertToUint64(), conn->appid);
+            Announce_Other_Peers *peer = announce->add_peers();
+            peer->set_id(conn->ids[0].ConvertToUint64());
+            peer->set_ip(conn->udp_ip_port.ip);
+            peer->set_udp_port(ntohs(conn->udp_ip_port.port));
+            peer->set_appid(conn->appid);
+            --conn->gossip_left;
         }
     }
 
     announce->set_tcp_port(tcp_port);
     announce->set_appid(this->appid);
     for (auto &id : ids) announce->add_ids(id.ConvertToUint64());
-    Common_Message msg;
-    msg.set_allocated_announce(announce);
-    msg.set_source_id(ids[0].ConvertToUint64());
+    Common_Message *msg = scope.create<Common_Message>();
+    msg->set_allocated_announce(announce);
+    msg->set_source_id(ids[0].ConvertToUint64());
     return msg;
 }
 
 void Networking::send_announce_broadcasts()
 {
-    Common_Message msg = create_announce(true);
+    Message_Arena::Scope scope(message_arena);
+    Common_Message *msg = create_announce(scope, true);
 
-    size_t size = msg.ByteSizeLong(); 
-    char *buffer = new char[size];
-    msg.SerializeToArray(buffer, size);
-    send_broadcasts(udp_socket, htons(DEFAULT_PORT), buffer, size, &this->custom_broadcasts);
+    size_t size = msg->ByteSizeLong();
+    char buffer[MAX_UDP_SIZE];
+    if (size > sizeof(buffer)) return;
+    msg->SerializeToArray(buffer, size);
+    send_broadcasts(udp_socket, htons(DEFAULT_PORT), buffer, size, &this->custom_broadcasts, multicast_group);
     if (udp_port != DEFAULT_PORT) {
-        send_broadcasts(udp_socket, htons(udp_port), buffer, size, &this->custom_broadcasts);
+        send_broadcasts(udp_socket, htons(udp_port), buffer, size, &this->custom_broadcasts, multicast_group);
     }
 
-    delete[] buffer;
     last_broadcast = std::chrono::high_resolution_clock::now();
     PRINT_DEBUG("Networking:: sent broadcasts\n");
 }
@@ -932,8 +1180,9 @@ void Networking::Run()
 
     //PRINT_DEBUG("Networking::Run() %lf\n", time_extra);
     PRINT_DEBUG("Networking::Run()\n");
-    if (check_timedout(last_broadcast, BROADCAST_INTERVAL)) {
+    if (check_timedout(last_broadcast, announce_interval)) {
         send_announce_broadcasts();
+        announce_interval = std::min(announce_interval * 2.0, ANNOUNCE_STEADY_INTERVAL);
     }
 
     IP_PORT ip_port;
@@ -959,35 +1208,48 @@ void Networking::Run()
     PRINT_DEBUG("RECV UDP\n");
     while((len = receive_packet(udp_socket, &ip_port, data, sizeof(data))) >= 0) {
         PRINT_DEBUG("recv %i %hhu.%hhu.%hhu.%hhu:%hu\n", len, ((unsigned char *)&ip_port.ip)[0], ((unsigned char *)&ip_port.ip)[1], ((unsigned char *)&ip_port.ip)[2], ((unsigned char *)&ip_port.ip)[3], htons(ip_port.port));
-        Common_Message msg;
-        if (msg.ParseFromArray(data, len)) {
-            if (msg.source_id()) {
-                if (msg.has_announce()) {
-                    handle_announce(&msg, ip_port);
+        Message_Arena::Scope scope(message_arena);
+        Common_Message *msg = scope.create<Common_Message>();
+        if (msg->ParseFromArray(data, len)) {
+            if (msg->source_id()) {
+                if (msg->has_announce()) {
+                    handle_announce(msg, ip_port);
                 } else
 
-                if (msg.has_low_level()) {
-                    handle_low_level_udp(&msg, ip_port);
+                if (msg->has_low_level()) {
+                    handle_low_level_udp(msg, ip_port);
                 } else
 
                 {
-                    msg.set_source_ip(ntohl(ip_port.ip));
-                    msg.set_source_port(ntohs(ip_port.port));
-                    do_callbacks_message(&msg);
+                    Connection *conn = find_connection((uint64)msg->source_id(), this->appid);
+                    if (conn) {
+                        ++conn->link.in_packets;
+                        conn->link.in_bytes += len;
+                    }
+
+                    msg->set_source_ip(ntohl(ip_port.ip));
+                    msg->set_source_port(ntohs(ip_port.port));
+                    do_callbacks_message(msg);
                 }
             }
         }
     }
 
+    send_probes();
+
     PRINT_DEBUG("RECV LOCAL\n");
-    std::vector<Common_Message> local_send_copy = local_send;
-    local_send.clear();
+    //moved out, the callbacks can queue new local messages while these are delivered
+    std::vector<Common_Message> local_send_copy;
+    local_send_copy.swap(local_send);
 
+    //anything sent by these callbacks must wait behind the rest of the copy
+    delivering_local = true;
     for (auto & m: local_send_copy) {
         m.set_source_ip(ntohl(own_ip));
         m.set_source_port(ntohs(udp_port));
         do_callbacks_message(&m);
     }
+    delivering_local = false;
 
     struct sockaddr_storage addr;
 #if defined(STEAM_WIN32)
@@ -1062,17 +1324,7 @@ void Networking::Run()
     PRINT_DEBUG("CONNECTIONS %zu\n", connections.size());
     for (auto &conn: connections) {
         if (!is_tcp_socket_valid(conn.tcp_socket_outgoing)) {
-            sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
-            if (is_socket_valid(sock) && set_socket_nonblocking(sock)) {
-                PRINT_DEBUG("NEW SOCKET %u %u\n", sock, conn.tcp_socket_outgoing.sock);
-                disable_nagle(sock);
-                connect_socket(sock, conn.tcp_ip_port);
-                conn.tcp_socket_outgoing.sock = sock;
-                conn.tcp_socket_outgoing.last_heartbeat_received = std::chrono::high_resolution_clock::now();
-                Common_Message msg;
-                msg.set_source_id(ids[0].ConvertToUint64());
-                send_buffer_tcp(conn.tcp_socket_outgoing, &msg);
-            }
+            connect_tcp(conn);
         }
 
         PRINT_DEBUG("RUN SOCKET1 %u %u\n", conn.tcp_socket_outgoing.sock, conn.tcp_socket_incoming.sock);
@@ -1109,15 +1361,23 @@ void Networking::Run()
 
         PRINT_DEBUG("RUN SOCKET3 %u %u\n", conn.tcp_socket_outgoing.sock, conn.tcp_socket_incoming.sock);
         Common_Message msg;
+        size_t buffered_outgoing = conn.tcp_socket_outgoing.recv_buffer.size();
         while (unbuffer_tcp(conn.tcp_socket_outgoing, &msg)) {
             PRINT_DEBUG("UNBUFFER SOCKET\n");
+            ++conn.link.in_packets;
+            conn.link.in_bytes += buffered_outgoing - conn.tcp_socket_outgoing.recv_buffer.size();
+            buffered_outgoing = conn.tcp_socket_outgoing.recv_buffer.size();
             msg.set_source_ip(ntohl(conn.tcp_ip_port.ip)); //TODO: get from tcp socket
             handle_tcp(&msg, conn.tcp_socket_outgoing);
             conn.last_received = std::chrono::high_resolution_clock::now();
         }
 
+        size_t buffered_incoming = conn.tcp_socket_incoming.recv_buffer.size();
         while (unbuffer_tcp(conn.tcp_socket_incoming, &msg)) {
             PRINT_DEBUG("UNBUFFER SOCKET\n");
+            ++conn.link.in_packets;
+            conn.link.in_bytes += buffered_incoming - conn.tcp_socket_incoming.recv_buffer.size();
+            buffered_incoming = conn.tcp_socket_incoming.recv_buffer.size();
             msg.set_source_ip(ntohl(conn.tcp_ip_port.ip)); //TODO: get from tcp socket
             handle_tcp(&msg, conn.tcp_socket_incoming);
             conn.last_received = std::chrono::high_resolution_clock::now();
@@ -1129,6 +1389,9 @@ void Networking::Run()
 
     }
 
+    send_link_probes();
+    update_link_rates();
+
     {
         auto conn = std::begin(connections);
         while (conn != std::end(connections)) {
@@ -1164,10 +1427,18 @@ void Networking::addListenId(CSteamID id)
 
     PRINT_DEBUG("ADDED ID\n");
     ids.push_back(id);
-    send_announce_broadcasts();
+    restartAnnounces();
     return;
 }
 
+void Networking::restartAnnounces()
+{
+    if (!enabled) return;
+    PRINT_DEBUG("Networking::restartAnnounces\n");
+    send_announce_broadcasts();
+    announce_interval = ANNOUNCE_BURST_INTERVAL;
+}
+
 void Networking::setAppID(uint32 appid)
 {
     this->appid = appid;
@@ -1213,8 +1484,20 @@ bool Networking::sendTo(Common_Message *msg, bool reliable, Connection *conn)
     if (std::find(ids.begin(), ids.end(), dest_id) != ids.end()) {
         PRINT_DEBUG("Sending to self\n");
         if (!conn) {
-            PRINT_DEBUG("local send\n");
-            local_send.push_back(*msg);
+            //only when nothing is queued, it must not overtake the connection messages sent before it
+            if (!delivering_local && local_send.empty() && is_local_fast_path(msg)) {
+                //the host player's client and server talk to each other, no need to wait for the next Run
+                PRINT_DEBUG("local delivery\n");
+                msg->set_source_ip(ntohl(own_ip));
+                msg->set_source_port(ntohs(udp_port));
+                delivering_local = true;
+                do_callbacks_message(msg);
+                delivering_local = false;
+            } else {
+                PRINT_DEBUG("local send\n");
+                local_send.push_back(*msg);
+            }
+
             ret = true;
         }
     }
@@ -1233,12 +1516,17 @@ bool Networking::sendTo(Common_Message *msg, bool reliable, Connection *conn)
                 ret = true;
             }
         } else {
-            char *buffer = new char[size];
+            //only messages smaller than MAX_UDP_SIZE get here, bigger ones are always sent over tcp
+            char buffer[MAX_UDP_SIZE];
             msg->SerializeToArray(buffer, size);
             send_packet_to(udp_socket, conn->udp_ip_port, buffer, size);
-            delete[] buffer;
             ret = true;
         }
+
+        if (ret) {
+            ++conn->link.out_packets;
+            conn->link.out_bytes += size;
+        }
     }
 
     reset_last_error();
@@ -1285,16 +1573,17 @@ void Networking::run_callback_user(CSteamID steam_id, bool online, uint32 appid)
     //only give callbacks for right game accounts
     if (steam_id.BIndividualAccount() && appid != this->appid && appid != LOBBY_CONNECT_APPID) return;
 
-    Common_Message msg;
-    msg.set_source_id(steam_id.ConvertToUint64());
-    msg.set_allocated_low_level(new Low_Level());
+    Message_Arena::Scope scope(message_arena);
+    Common_Message *msg = scope.create<Common_Message>();
+    msg->set_source_id(steam_id.ConvertToUint64());
+    msg->set_allocated_low_level(scope.create<Low_Level>());
     if (online) {
-        msg.mutable_low_level()->set_type(Low_Level::CONNECT);
+        msg->mutable_low_level()->set_type(Low_Level::CONNECT);
     } else {
-        msg.mutable_low_level()->set_type(Low_Level::DISCONNECT);
+        msg->mutable_low_level()->set_type(Low_Level::DISCONNECT);
     }
 
-    run_callbacks(CALLBACK_ID_USER_STATUS, &msg);
+    run_callbacks(CALLBACK_ID_USER_STATUS, msg);
 }
 
 bool Networking::setCallback(Callback_Ids id, CSteamID steam_id, void (*message_callback)(void *object, Common_Message *msg), void *object)
@@ -1315,6 +1604,40 @@ uint32 Networking::getOwnIP()
     return own_ip;
 }
 
+bool Networking::getLinkStats(CSteamID id, struct Link_Stats *stats)
+{
+    struct Connection *conn = find_connection(id, this->appid);
+    if (!conn) return false;
+
+    const struct Link_Metrics &link = conn->link;
+    stats->ping = link.srtt < 0 ? -1 : (int)(link.srtt + 0.5);
+    stats->jitter = (float)link.jitter;
+
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    unsigned count = 0, lost = 0;
+    for (auto &probe : link.probes) {
+        //the recent ones might still be answered
+        if (seconds_since(probe.sent, now) < LINK_PROBE_TIMEOUT) continue;
+        ++count;
+        if (!probe.replied) ++lost;
+    }
+
+    stats->loss = count ? (float)lost / count : 0.0f;
+    stats->out_packets_per_sec = link.out_packets_per_sec;
+    stats->out_bytes_per_sec = link.out_bytes_per_sec;
+    stats->in_packets_per_sec = link.in_packets_per_sec;
+    stats->in_bytes_per_sec = link.in_bytes_per_sec;
+    return true;
+}
+
+std::string Networking::linkStatsString(const struct Link_Stats &stats)
+{
+    char buffer[256];
+    snprintf(buffer, sizeof(buffer), "ping: %i ms jitter: %.1f ms loss: %.1f%% out: %.1f pkt/s %.0f B/s in: %.1f pkt/s %.0f B/s",
+        stats.ping, stats.jitter, stats.loss * 100.0f, stats.out_packets_per_sec, stats.out_bytes_per_sec, stats.in_packets_per_sec, stats.in_bytes_per_sec);
+    return std::string(buffer);
+}
+
 void Networking::startQuery(IP_PORT ip_port)
 {
     if (ip_port.port <= 1024)
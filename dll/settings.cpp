@@ -77,6 +77,8 @@ Settings::Settings(CSteamID steam_id, CGameID game_id, std::string name, std::st
     this->language = lang;
     this->lobby_id = k_steamIDNil;
     this->unlockAllDLCs = true;
+    this->DLCs = std::make_shared<struct DLC_Table>();
+    this->mods = std::make_shared<struct Mod_Table>();
 
     this->offline = offline;
     this->create_unknown_leaderboards = true;
@@ -132,46 +134,81 @@ void Settings::unlockAllDLC(bool value)
     this->unlockAllDLCs = value;
 }
 
-void Settings::addDLC(AppId_t appID, std::string name, bool available)
+void DLC_Table::add(AppId_t appID, std::string name, bool available)
 {
-    auto f = std::find_if(DLCs.begin(), DLCs.end(), [&appID](DLC_entry const& item) { return item.appID == appID; });
-    if (DLCs.end() != f) {
-        f->name = name;
-        f->available = available;
+    auto f = index.find(appID);
+    if (index.end() != f) {
+        entries[f->second].name = name;
+        entries[f->second].available = available;
         return;
     }
 
     DLC_entry new_entry;
     new_entry.appID = appID;
-    new_entry.name = name;
+    new_entry.name = std::move(name);
     new_entry.available = available;
-    DLCs.push_back(new_entry);
+    index.emplace(appID, entries.size());
+    entries.push_back(std::move(new_entry));
 }
 
-void Settings::addMod(PublishedFileId_t id, std::string title, std::string path)
+const struct DLC_entry *DLC_Table::find(AppId_t appID) const
 {
-    auto f = std::find_if(mods.begin(), mods.end(), [&id](Mod_entry const& item) { return item.id == id; });
-    if (mods.end() != f) {
-        f->title = title;
-        f->path = path;
-        return;
+    auto f = index.find(appID);
+    if (index.end() == f) return NULL;
+
+    return &entries[f->second];
+}
+
+void Settings::addDLC(AppId_t appID, std::string name, bool available)
+{
+    DLCs->add(appID, name, available);
+}
+
+struct Mod_entry &Mod_Table::get_or_add(PublishedFileId_t id)
+{
+    auto f = index.find(id);
+    if (index.end() != f) {
+        return entries[f->second];
     }
 
     Mod_entry new_entry{};
     new_entry.id = id;
-    new_entry.title = title;
-    new_entry.path = path;
-    mods.push_back(new_entry);
+    index.emplace(id, entries.size());
+    entries.push_back(std::move(new_entry));
+    return entries.back();
+}
+
+struct Mod_entry *Mod_Table::find(PublishedFileId_t id)
+{
+    auto f = index.find(id);
+    if (index.end() == f) return NULL;
+
+    return &entries[f->second];
+}
+
+const struct Mod_entry *Mod_Table::find(PublishedFileId_t id) const
+{
+    auto f = index.find(id);
+    if (index.end() == f) return NULL;
+
+    return &entries[f->second];
+}
+
+void Settings::addMod(PublishedFileId_t id, std::string title, std::string path)
+{
+    Mod_entry &entry = mods->get_or_add(id);
+    entry.title = std::move(title);
+    entry.path = std::move(path);
 }
 
 void Settings::addModDetails(PublishedFileId_t id, Mod_entry details)
 {
-    auto f = std::find_if(mods.begin(), mods.end(), [&id](Mod_entry const& item) { return item.id == id; });
-    if (f != mods.end()) {
+    Mod_entry *f = mods->find(id);
+    if (f) {
         // don't copy files handles, they're auto generated
         
         f->fileType = details.fileType;
-        f->description = details.description;
+        f->description = std::move(details.description);
         f->steamIDOwner = details.steamIDOwner;
         f->timeCreated = details.timeCreated;
         f->timeUpdated = details.timeUpdated;
@@ -180,45 +217,43 @@ void Settings::addModDetails(PublishedFileId_t id, Mod_entry details)
         f->banned = details.banned;
         f->acceptedForUse = details.acceptedForUse;
         f->tagsTruncated = details.tagsTruncated;
-        f->tags = details.tags;
-        f->primaryFileName = details.primaryFileName;
+        f->tags = std::move(details.tags);
+        f->keyValueTags = std::move(details.keyValueTags);
+        f->primaryFileName = std::move(details.primaryFileName);
         f->primaryFileSize = details.primaryFileSize;
-        f->previewFileName = details.previewFileName;
+        f->previewFileName = std::move(details.previewFileName);
         f->previewFileSize = details.previewFileSize;
-        f->workshopItemURL = details.workshopItemURL;
+        f->workshopItemURL = std::move(details.workshopItemURL);
         f->votesUp = details.votesUp;
         f->votesDown = details.votesDown;
         f->score = details.score;
         f->numChildren = details.numChildren;
-        f->previewURL = details.previewURL;
+        f->previewURL = std::move(details.previewURL);
     }
 }
 
-Mod_entry Settings::getMod(PublishedFileId_t id)
+const Mod_entry &Settings::getMod(PublishedFileId_t id)
 {
-    auto f = std::find_if(mods.begin(), mods.end(), [&id](Mod_entry const& item) { return item.id == id; });
-    if (mods.end() != f) {
+    static const Mod_entry empty_mod{};
+
+    const Mod_entry *f = mods->find(id);
+    if (f) {
         return *f;
     }
 
-    return Mod_entry();
+    return empty_mod;
 }
 
 bool Settings::isModInstalled(PublishedFileId_t id)
 {
-    auto f = std::find_if(mods.begin(), mods.end(), [&id](Mod_entry const& item) { return item.id == id; });
-    if (mods.end() != f) {
-        return true;
-    }
-
-    return false;
+    return mods->find(id) != NULL;
 }
 
 std::set<PublishedFileId_t> Settings::modSet()
 {
     std::set<PublishedFileId_t> ret_set;
 
-    for (auto & m: mods) {
+    for (auto & m: mods->entries) {
         ret_set.insert(m.id);
     }
 
@@ -227,15 +262,15 @@ std::set<PublishedFileId_t> Settings::modSet()
 
 unsigned int Settings::DLCCount()
 {
-    return this->DLCs.size();
+    return this->DLCs->entries.size();
 }
 
 bool Settings::hasDLC(AppId_t appID)
 {
     if (this->unlockAllDLCs) return true;
 
-    auto f = std::find_if(DLCs.begin(), DLCs.end(), [&appID](DLC_entry const& item) { return item.appID == appID; });
-    if (DLCs.end() == f)
+    const struct DLC_entry *f = DLCs->find(appID);
+    if (!f)
         return false;
 
     return f->available;
@@ -243,11 +278,11 @@ bool Settings::hasDLC(AppId_t appID)
 
 bool Settings::getDLC(unsigned int index, AppId_t &appID, bool &available, std::string &name)
 {
-    if (index >= DLCs.size()) return false;
+    if (index >= DLCs->entries.size()) return false;
 
-    appID = DLCs[index].appID;
-    available = DLCs[index].available;
-    name = DLCs[index].name;
+    appID = DLCs->entries[index].appID;
+    available = DLCs->entries[index].available;
+    name = DLCs->entries[index].name;
     return true;
 }
 
@@ -277,13 +312,51 @@ void Settings::setLeaderboard(std::string leaderboard, enum ELeaderboardSortMeth
 
 int Settings::add_image(std::string data, uint32 width, uint32 height)
 {
-    int last = images.size() + 1;
+    size_t hash = std::hash<std::string>{}(data);
+    auto range = image_hashes.equal_range(hash);
+    for (auto i = range.first; i != range.second; ++i) {
+        struct Image_Data &image = images[i->second];
+        if (image.width == width && image.height == height && image.data == data) {
+            ++image.refcount;
+            return i->second;
+        }
+    }
+
+    int slot;
+    if (free_image_slots.size()) {
+        slot = free_image_slots.back();
+        free_image_slots.pop_back();
+    } else {
+        slot = images.size() + 1;
+    }
+
     struct Image_Data dt;
     dt.width = width;
     dt.height = height;
-    dt.data = data;
-    images[last] = dt;
-    return last;
+    dt.data = std::move(data);
+    dt.refcount = 1;
+    images[slot] = std::move(dt);
+    image_hashes.emplace(hash, slot);
+    return slot;
+}
+
+void Settings::remove_image(int image)
+{
+    auto i = images.find(image);
+    if (i == images.end() || !i->second.refcount) return;
+    if (--i->second.refcount) return;
+
+    auto range = image_hashes.equal_range(std::hash<std::string>{}(i->second.data));
+    for (auto h = range.first; h != range.second; ++h) {
+        if (h->second == image) {
+            image_hashes.erase(h);
+            break;
+        }
+    }
+
+    //the slot stays in the map so the next handle given out doesn't collide with it, GetImageSize/GetImageRGBA fail on it until it's reused
+    i->second = Image_Data();
+    free_image_slots.push_back(image);
 }
 
 bool Settings::appIsInstalled(AppId_t appID)
@@ -31,6 +31,24 @@ static void load_custom_broadcasts(std::string broadcasts_filepath, std::set<IP_
     }
 }
 
+static uint32 load_multicast_group(std::string multicast_filepath)
+{
+    PRINT_DEBUG("Multicast group file path: %s\n", multicast_filepath.c_str());
+    std::ifstream multicast_file(utf8_decode(multicast_filepath));
+    consume_bom(multicast_file);
+    std::string line;
+    if (multicast_file.is_open() && std::getline(multicast_file, line)) {
+        std::set<IP_PORT> ips = Networking::resolve_ip(line);
+        for (auto &ip : ips) {
+            // 224.0.0.0 - 239.255.255.255
+            if ((ip.ip >> 28) == 0xE) return ip.ip;
+            PRINT_DEBUG("Ignoring %X, not a multicast address\n", ip.ip);
+        }
+    }
+
+    return 0;
+}
+
 static void load_subscribed_groups_clans(std::string clans_filepath, Settings *settings_client, Settings *settings_server)
 {
     PRINT_DEBUG("Group clans file path: %s\n", clans_filepath.c_str());
@@ -258,6 +276,13 @@ static void load_gamecontroller_settings(Settings *settings)
     }
 
     settings->glyphs_directory = path + (PATH_SEPARATOR "glyphs" PATH_SEPARATOR);
+
+    // not a .txt so it isn't mistaken for an action set
+    std::string replay_path = path + PATH_SEPARATOR "gamepad_replay.log";
+    if (file_exists_(replay_path)) {
+        PRINT_DEBUG("controller replay %s\n", replay_path.c_str());
+        settings->controller_replay_file = replay_path;
+    }
 }
 
 // steam_appid.txt
@@ -470,42 +495,51 @@ std::set<std::string> parse_supported_languages(class Local_Storage *local_stora
 }
 
 // DLC.txt
-static void parse_dlc(class Settings *settings_client, Settings *settings_server)
+bool parse_dlc_file(const std::string &dlc_config_path, Settings *settings_client, Settings *settings_server)
 {
-    std::string dlc_config_path = Local_Storage::get_game_settings_path() + "DLC.txt";
     std::ifstream input( utf8_decode(dlc_config_path) );
-    if (input.is_open()) {
-        consume_bom(input);
-        settings_client->unlockAllDLC(false);
-        settings_server->unlockAllDLC(false);
-        PRINT_DEBUG("Locking all DLC\n");
+    if (!input.is_open()) return false;
 
-        for( std::string line; std::getline( input, line ); ) {
-            if (!line.empty() && line.front() == '#') {
-                continue;
-            }
-            if (!line.empty() && line.back() == '\n') {
-                line.pop_back();
-            }
+    consume_bom(input);
+    settings_client->unlockAllDLC(false);
+    settings_server->unlockAllDLC(false);
+    PRINT_DEBUG("Locking all DLC\n");
 
-            if (!line.empty() && line.back() == '\r') {
-                line.pop_back();
-            }
+    for( std::string line; std::getline( input, line ); ) {
+        if (!line.empty() && line.front() == '#') {
+            continue;
+        }
+        if (!line.empty() && line.back() == '\n') {
+            line.pop_back();
+        }
 
-            std::size_t deliminator = line.find("=");
-            if (deliminator != 0 && deliminator != std::string::npos && deliminator != line.size()) {
-                AppId_t appid = stol(line.substr(0, deliminator));
-                std::string name = line.substr(deliminator + 1);
-                bool available = true;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
 
-                if (appid) {
-                    PRINT_DEBUG("Adding DLC: %u|%s| %u\n", appid, name.c_str(), available);
-                    settings_client->addDLC(appid, name, available);
-                    settings_server->addDLC(appid, name, available);
-                }
+        std::size_t deliminator = line.find("=");
+        if (deliminator != 0 && deliminator != std::string::npos && deliminator != line.size()) {
+            AppId_t appid = stol(line.substr(0, deliminator));
+            std::string name = line.substr(deliminator + 1);
+            bool available = true;
+
+            if (appid) {
+                PRINT_DEBUG("Adding DLC: %u|%s| %u\n", appid, name.c_str(), available);
+                settings_client->addDLC(appid, name, available);
             }
         }
-    } else {
+    }
+
+    //both use the same table, no need to build it twice
+    settings_server->setDLCTable(settings_client->getDLCTable());
+
+    return true;
+}
+
+static void parse_dlc(class Settings *settings_client, Settings *settings_server)
+{
+    std::string dlc_config_path = Local_Storage::get_game_settings_path() + "DLC.txt";
+    if (!parse_dlc_file(dlc_config_path, settings_client, settings_server)) {
         //unlock all DLC
         PRINT_DEBUG("Unlocking all DLC\n");
         settings_client->unlockAllDLC(true);
@@ -808,13 +842,71 @@ static std::string get_mod_preview_url(const std::string &previewFileName, const
     
 }
 
-static void try_parse_mods_file(class Settings *settings_client, Settings *settings_server, nlohmann::json &mod_items, const std::string &mods_folder)
+// runs work(i) for every i in [0, count) on a few threads, work must not throw
+static void parallel_for_each_index(size_t count, const std::function<void(size_t)> &work)
+{
+    size_t threads = std::thread::hardware_concurrency();
+    if (threads == 0) threads = 2;
+    threads = std::min(threads, count / 16);
+    if (threads <= 1) {
+        for (size_t i = 0; i < count; ++i) work(i);
+        return;
+    }
+
+    std::atomic<size_t> next(0);
+    std::vector<std::future<void>> workers;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.push_back(std::async(std::launch::async, [&]() {
+            for (size_t i = next++; i < count; i = next++) work(i);
+        }));
+    }
+
+    for (auto &w : workers) w.get();
+}
+
+// 0 if the path doesn't exist
+static int64_t get_path_mtime(const std::string &path)
+{
+    std::error_code ec;
+    auto time = std::filesystem::last_write_time(std::filesystem::u8path(path), ec);
+    if (ec) return 0;
+    return (int64_t)time.time_since_epoch().count();
+}
+
+static void print_mod(const char *action, const std::string &mod_id, const Mod_entry &mod, const std::string &mod_images_fullpath, Settings *settings)
 {
+    PRINT_DEBUG("  %s mod '%s':\n", action, mod_id.c_str());
+    PRINT_DEBUG("    path (will be used for primary file): '%s'\n", mod.path.c_str());
+    PRINT_DEBUG("    images path (will be used for preview file): '%s'\n", mod_images_fullpath.c_str());
+    PRINT_DEBUG("    primary_filename: '%s'\n", mod.primaryFileName.c_str());
+    PRINT_DEBUG("    primary_filesize: %i bytes\n", mod.primaryFileSize);
+    PRINT_DEBUG("    primary file handle: %llu\n", settings->getMod(mod.id).handleFile);
+    PRINT_DEBUG("    preview_filename: '%s'\n", mod.previewFileName.c_str());
+    PRINT_DEBUG("    preview_filesize: %i bytes\n", mod.previewFileSize);
+    PRINT_DEBUG("    preview file handle: %llu\n", settings->getMod(mod.id).handlePreviewFile);
+    PRINT_DEBUG("    workshop_item_url: '%s'\n", mod.workshopItemURL.c_str());
+    PRINT_DEBUG("    preview_url: '%s'\n", mod.previewURL.c_str());
+}
 
+static void try_parse_mods_file(class Settings *settings_client, nlohmann::json &mod_items, const std::string &mods_folder)
+{
+    struct Parsed_Mod {
+        std::string mod_id;
+        std::string mod_images_fullpath;
+        Mod_entry mod;
+        bool stat_primary;
+        bool stat_preview;
+    };
+
+    // the entries are built here, the file sizes missing from mods.json are read concurrently below
+    std::vector<Parsed_Mod> parsed;
+    parsed.reserve(mod_items.size());
     for (auto mod = mod_items.begin(); mod != mod_items.end(); ++mod) {
         try {
-            std::string mod_images_fullpath = Local_Storage::get_game_settings_path() + "mod_images" + PATH_SEPARATOR + std::string(mod.key());
-            Mod_entry newMod;
+            Parsed_Mod p;
+            p.mod_id = mod.key();
+            p.mod_images_fullpath = Local_Storage::get_game_settings_path() + "mod_images" + PATH_SEPARATOR + p.mod_id;
+            Mod_entry &newMod = p.mod;
             newMod.id = std::stoull(mod.key());
             newMod.title = mod.value().value("title", std::string(mod.key()));
 
@@ -838,20 +930,20 @@ static void try_parse_mods_file(class Settings *settings_client, Settings *setti
             newMod.acceptedForUse = true;
             newMod.tagsTruncated = false;
             newMod.tags = mod.value().value("tags", std::string(""));
+            auto kv_tags = mod.value().find("key_value_tags");
+            if (kv_tags != mod.value().end() && kv_tags->is_object()) {
+                for (auto kv = kv_tags->begin(); kv != kv_tags->end(); ++kv) {
+                    if (kv.value().is_string()) newMod.keyValueTags.emplace_back(kv.key(), kv.value().get<std::string>());
+                }
+            }
 
             newMod.primaryFileName = mod.value().value("primary_filename", std::string(""));
-            int32 primary_filesize = 0;
-            if (!newMod.primaryFileName.empty()) {
-                primary_filesize = (int32)get_file_size_safe(newMod.primaryFileName, newMod.path, primary_filesize);
-            }
-            newMod.primaryFileSize = mod.value().value("primary_filesize", primary_filesize);
-            
+            newMod.primaryFileSize = mod.value().value("primary_filesize", (int32)0);
+            p.stat_primary = !newMod.primaryFileName.empty() && !mod.value().contains("primary_filesize");
+
             newMod.previewFileName = mod.value().value("preview_filename", std::string(""));
-            int32 preview_filesize = 0;
-            if (!newMod.previewFileName.empty()) {
-                preview_filesize = (int32)get_file_size_safe(newMod.previewFileName, mod_images_fullpath, preview_filesize);
-            }
-            newMod.previewFileSize = mod.value().value("preview_filesize", preview_filesize);
+            newMod.previewFileSize = mod.value().value("preview_filesize", (int32)0);
+            p.stat_preview = !newMod.previewFileName.empty() && !mod.value().contains("preview_filesize");
 
             newMod.workshopItemURL = mod.value().value("workshop_item_url", "https://steamcommunity.com/sharedfiles/filedetails/?id=" + std::string(mod.key()));
             newMod.votesUp = mod.value().value("upvotes", (uint32)500);
@@ -866,37 +958,63 @@ static void try_parse_mods_file(class Settings *settings_client, Settings *setti
             
             newMod.numChildren = mod.value().value("num_children", (uint32)0);
             newMod.previewURL = mod.value().value("preview_url", get_mod_preview_url(newMod.previewFileName, std::string(mod.key())));
-            
-            settings_client->addMod(newMod.id, newMod.title, newMod.path);
-            settings_server->addMod(newMod.id, newMod.title, newMod.path);
-            settings_client->addModDetails(newMod.id, newMod);
-            settings_server->addModDetails(newMod.id, newMod);
-            
-            PRINT_DEBUG("  parsed mod '%s':\n", std::string(mod.key()).c_str());
-            PRINT_DEBUG("    path (will be used for primary file): '%s'\n", newMod.path.c_str());
-            PRINT_DEBUG("    images path (will be used for preview file): '%s'\n", mod_images_fullpath.c_str());
-            PRINT_DEBUG("    primary_filename: '%s'\n", newMod.primaryFileName.c_str());
-            PRINT_DEBUG("    primary_filesize: %i bytes\n", newMod.primaryFileSize);
-            PRINT_DEBUG("    primary file handle: %llu\n", settings_client->getMod(newMod.id).handleFile);
-            PRINT_DEBUG("    preview_filename: '%s'\n", newMod.previewFileName.c_str());
-            PRINT_DEBUG("    preview_filesize: %i bytes\n", newMod.previewFileSize);
-            PRINT_DEBUG("    preview file handle: %llu\n", settings_client->getMod(newMod.id).handlePreviewFile);
-            PRINT_DEBUG("    workshop_item_url: '%s'\n", newMod.workshopItemURL.c_str());
-            PRINT_DEBUG("    preview_url: '%s'\n", newMod.previewURL.c_str());
+
+            parsed.push_back(std::move(p));
         } catch (std::exception& e) {
             PRINT_DEBUG("MODLOADER ERROR: %s\n", e.what());
         }
     }
+
+    parallel_for_each_index(parsed.size(), [&parsed](size_t i) {
+        Parsed_Mod &p = parsed[i];
+        if (p.stat_primary) {
+            p.mod.primaryFileSize = (int32)get_file_size_safe(p.mod.primaryFileName, p.mod.path);
+        }
+
+        if (p.stat_preview) {
+            p.mod.previewFileSize = (int32)get_file_size_safe(p.mod.previewFileName, p.mod_images_fullpath);
+        }
+    });
+
+    for (auto &p : parsed) {
+        settings_client->addMod(p.mod.id, p.mod.title, p.mod.path);
+        settings_client->addModDetails(p.mod.id, p.mod);
+        print_mod("parsed", p.mod_id, p.mod, p.mod_images_fullpath, settings_client);
+    }
 }
 
 // called if mods.json doesn't exist or invalid
-static void try_detect_mods_folder(class Settings *settings_client, Settings *settings_server, const std::string &mods_folder)
+// listing the folder of every mod is slow with big workshop folders, so the first file found in each
+// folder is remembered in mods_scan_cache.json and reused as long as the folder's modification time doesn't change
+static void try_detect_mods_folder(class Settings *settings_client, const std::string &mods_folder, class Local_Storage *local_storage)
 {
+    static constexpr auto mods_scan_cache_file = "mods_scan_cache.json";
+
+    struct Detected_Mod {
+        std::string mod_folder;
+        std::string mod_images_fullpath;
+        Mod_entry mod;
+        int64_t path_mtime;
+        int64_t images_mtime;
+        bool cached;
+    };
+
+    nlohmann::json cache = nlohmann::json::object();
+    if (!local_storage->load_json_file("", mods_scan_cache_file, cache) || !cache.is_object() || cache.value("mods_folder", std::string()) != mods_folder) {
+        cache = nlohmann::json::object();
+    }
+    const nlohmann::json cached_mods = cache.value("mods", nlohmann::json::object());
+
     std::vector<std::string> all_mods = Local_Storage::get_folders_path(mods_folder);
+    std::vector<Detected_Mod> detected;
+    detected.reserve(all_mods.size());
     for (auto & mod_folder: all_mods) {
-        std::string mod_images_fullpath = Local_Storage::get_game_settings_path() + "mod_images" + PATH_SEPARATOR + mod_folder;
         try {
-            Mod_entry newMod;
+            Detected_Mod d;
+            d.mod_folder = mod_folder;
+            d.mod_images_fullpath = Local_Storage::get_game_settings_path() + "mod_images" + PATH_SEPARATOR + mod_folder;
+            d.cached = false;
+            Mod_entry &newMod = d.mod;
             newMod.id = std::stoull(mod_folder);
             newMod.title = mod_folder;
 
@@ -915,38 +1033,69 @@ static void try_detect_mods_folder(class Settings *settings_client, Settings *se
             newMod.tagsTruncated = false;
             newMod.tags = "";
 
-            std::vector<std::string> mod_primary_files = Local_Storage::get_filenames_path(newMod.path);
-            newMod.primaryFileName = mod_primary_files.size() ? mod_primary_files[0] : "";
-            newMod.primaryFileSize = (int32)get_file_size_safe(newMod.primaryFileName, newMod.path);
-
-            std::vector<std::string> mod_preview_files = Local_Storage::get_filenames_path(mod_images_fullpath);
-            newMod.previewFileName = mod_preview_files.size() ? mod_preview_files[0] : "";
-            newMod.previewFileSize = (int32)get_file_size_safe(newMod.previewFileName, mod_images_fullpath);
-
             newMod.workshopItemURL =  "https://steamcommunity.com/sharedfiles/filedetails/?id=" + mod_folder;
             newMod.votesUp = (uint32)500;
             newMod.votesDown = (uint32)12;
             newMod.score = 0.97f;
             newMod.numChildren = (uint32)0;
-            newMod.previewURL = get_mod_preview_url(newMod.previewFileName, mod_folder);
-            
-            settings_client->addMod(newMod.id, newMod.title, newMod.path);
-            settings_server->addMod(newMod.id, newMod.title, newMod.path);
-            settings_client->addModDetails(newMod.id, newMod);
-            settings_server->addModDetails(newMod.id, newMod);
-            PRINT_DEBUG("  detected mod '%s':\n", mod_folder.c_str());
-            PRINT_DEBUG("    path (will be used for primary file): '%s'\n", newMod.path.c_str());
-            PRINT_DEBUG("    images path (will be used for preview file): '%s'\n", mod_images_fullpath.c_str());
-            PRINT_DEBUG("    primary_filename: '%s'\n", newMod.primaryFileName.c_str());
-            PRINT_DEBUG("    primary_filesize: %i bytes\n", newMod.primaryFileSize);
-            PRINT_DEBUG("    primary file handle: %llu\n", settings_client->getMod(newMod.id).handleFile);
-            PRINT_DEBUG("    preview_filename: '%s'\n", newMod.previewFileName.c_str());
-            PRINT_DEBUG("    preview_filesize: %i bytes\n", newMod.previewFileSize);
-            PRINT_DEBUG("    preview file handle: %llu\n", settings_client->getMod(newMod.id).handlePreviewFile);
-            PRINT_DEBUG("    workshop_item_url: '%s'\n", newMod.workshopItemURL.c_str());
-            PRINT_DEBUG("    preview_url: '%s'\n", newMod.previewURL.c_str());
+
+            detected.push_back(std::move(d));
         } catch (...) {}
     }
+
+    parallel_for_each_index(detected.size(), [&detected, &cached_mods](size_t i) {
+        Detected_Mod &d = detected[i];
+        Mod_entry &newMod = d.mod;
+        d.path_mtime = get_path_mtime(newMod.path);
+        d.images_mtime = get_path_mtime(d.mod_images_fullpath);
+
+        auto cached = cached_mods.find(d.mod_folder);
+        if (cached != cached_mods.end() && cached->is_object() &&
+            cached->value("path_mtime", (int64_t)-1) == d.path_mtime &&
+            cached->value("images_mtime", (int64_t)-1) == d.images_mtime) {
+            newMod.primaryFileName = cached->value("primary_filename", std::string());
+            newMod.previewFileName = cached->value("preview_filename", std::string());
+            d.cached = true;
+        } else {
+            std::vector<std::string> mod_primary_files = Local_Storage::get_filenames_path(newMod.path);
+            newMod.primaryFileName = mod_primary_files.size() ? mod_primary_files[0] : "";
+
+            std::vector<std::string> mod_preview_files = Local_Storage::get_filenames_path(d.mod_images_fullpath);
+            newMod.previewFileName = mod_preview_files.size() ? mod_preview_files[0] : "";
+        }
+
+        // files can be replaced without touching the folder, the sizes are always read again
+        newMod.primaryFileSize = (int32)get_file_size_safe(newMod.primaryFileName, newMod.path);
+        newMod.previewFileSize = (int32)get_file_size_safe(newMod.previewFileName, d.mod_images_fullpath);
+    });
+
+    size_t cache_hits = 0;
+    nlohmann::json new_cached_mods = nlohmann::json::object();
+    for (auto &d : detected) {
+        Mod_entry &newMod = d.mod;
+        newMod.previewURL = get_mod_preview_url(newMod.previewFileName, d.mod_folder);
+
+        settings_client->addMod(newMod.id, newMod.title, newMod.path);
+        settings_client->addModDetails(newMod.id, newMod);
+        print_mod("detected", d.mod_folder, newMod, d.mod_images_fullpath, settings_client);
+
+        if (d.cached) ++cache_hits;
+        new_cached_mods[d.mod_folder] = nlohmann::json{
+            {"path_mtime", d.path_mtime},
+            {"images_mtime", d.images_mtime},
+            {"primary_filename", newMod.primaryFileName},
+            {"preview_filename", newMod.previewFileName},
+        };
+    }
+
+    PRINT_DEBUG("Detected %zu mods, %zu folder listings reused from %s\n", detected.size(), cache_hits, mods_scan_cache_file);
+    if (cache_hits != detected.size() || cached_mods.size() != detected.size()) {
+        cache = nlohmann::json{
+            {"mods_folder", mods_folder},
+            {"mods", std::move(new_cached_mods)},
+        };
+        local_storage->write_json_file("", mods_scan_cache_file, cache);
+    }
 }
 
 static void parse_mods_folder(class Settings *settings_client, Settings *settings_server, class Local_Storage *local_storage)
@@ -957,12 +1106,13 @@ static void parse_mods_folder(class Settings *settings_client, Settings *setting
     std::string mods_json_path = Local_Storage::get_game_settings_path() + mods_json_file;
     if (local_storage->load_json(mods_json_path, mod_items)) {
         PRINT_DEBUG("Attempting to parse mods.json\n");
-        try_parse_mods_file(settings_client, settings_server, mod_items, mods_folder);
+        try_parse_mods_file(settings_client, mod_items, mods_folder);
     } else { // invalid mods.json or doesn't exist
         PRINT_DEBUG("Failed to load mods.json, attempting to auto detect mods folder\n");
-        try_detect_mods_folder(settings_client, settings_server, mods_folder);
+        try_detect_mods_folder(settings_client, mods_folder, local_storage);
     }
 
+    settings_server->setModTable(settings_client->getModTable());
 }
 
 // force_language.txt
@@ -1066,8 +1216,119 @@ static void parse_crash_printer_location()
     }
 }
 
+// voice_input.txt
+static void parse_voice_input(class Settings *settings_client, Settings *settings_server)
+{
+    std::string voice_input_path = Local_Storage::get_game_settings_path() + "voice_input.txt";
+    std::ifstream input( utf8_decode(voice_input_path) );
+    if (input.is_open()) {
+        consume_bom(input);
+        std::string line;
+        std::getline( input, line );
+        line.erase(line.find_last_not_of(whitespaces) + 1);
+        line.erase(0, line.find_first_not_of(whitespaces));
+        if (line.empty()) return;
+
+        std::string full_path = common_helpers::to_absolute(line, get_full_program_path());
+
+        // optional 2nd line: sample rate of raw input, wav files have their own
+        uint32 sample_rate = 0;
+        std::string rate_line;
+        if (std::getline( input, rate_line )) {
+            try {
+                sample_rate = std::stoul(rate_line);
+            } catch (...) {
+                sample_rate = 0;
+            }
+        }
+
+        PRINT_DEBUG("Voice input '%s', raw sample rate %u\n", full_path.c_str(), sample_rate);
+        settings_client->voice_input_path = full_path;
+        settings_server->voice_input_path = full_path;
+        settings_client->voice_input_sample_rate = sample_rate;
+        settings_server->voice_input_sample_rate = sample_rate;
+    }
+}
+
+// screenshot_format.txt
+static void parse_screenshot_format(class Settings *settings_client, Settings *settings_server)
+{
+    std::string screenshot_format_path = Local_Storage::get_game_settings_path() + "screenshot_format.txt";
+    std::ifstream input( utf8_decode(screenshot_format_path) );
+    if (input.is_open()) {
+        consume_bom(input);
+        std::string line;
+        std::getline( input, line );
+        line.erase(line.find_last_not_of(whitespaces) + 1);
+        line.erase(0, line.find_first_not_of(whitespaces));
+        std::transform(line.begin(), line.end(), line.begin(), [](unsigned char c){ return std::tolower(c); });
+        if (line == "jpeg") line = "jpg";
+        if (line != "png" && line != "jpg") {
+            PRINT_DEBUG("Unknown screenshot format '%s'\n", line.c_str());
+            return;
+        }
+
+        // optional 2nd line: png compression level or jpg quality
+        int quality = -1;
+        std::string quality_line;
+        if (std::getline( input, quality_line )) {
+            try {
+                quality = std::stoi(quality_line);
+            } catch (...) {
+                quality = -1;
+            }
+        }
+
+        PRINT_DEBUG("Screenshot format %s, quality %i\n", line.c_str(), quality);
+        settings_client->screenshot_format = line;
+        settings_server->screenshot_format = line;
+        settings_client->screenshot_quality = quality;
+        settings_server->screenshot_quality = quality;
+    }
+}
+
+static long long elapsed_us(std::chrono::high_resolution_clock::time_point since)
+{
+    return (long long)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - since).count();
+}
+
+struct Startup_Task {
+    const char *name;
+    // time spent parsing in microseconds
+    std::future<long long> duration;
+};
+
+static void add_startup_task(std::vector<Startup_Task> &tasks, const char *name, std::function<void()> parse)
+{
+    Startup_Task task;
+    task.name = name;
+    task.duration = std::async(std::launch::async, [parse]() {
+        auto start = std::chrono::high_resolution_clock::now();
+        parse();
+        return elapsed_us(start);
+    });
+    tasks.push_back(std::move(task));
+}
+
+// waits for every task before rethrowing a failure, the tasks reference the Settings objects
+static void wait_startup_tasks(std::vector<Startup_Task> &tasks)
+{
+    std::exception_ptr error;
+    for (auto &task : tasks) {
+        try {
+            long long us = task.duration.get();
+            PRINT_DEBUG("Startup: %s parsed in %lld us\n", task.name, us);
+        } catch (...) {
+            if (!error) error = std::current_exception();
+        }
+    }
+
+    if (error) std::rethrow_exception(error);
+}
+
 uint32 create_localstorage_settings(Settings **settings_client_out, Settings **settings_server_out, Local_Storage **local_storage_out)
 {
+    auto startup_begin = std::chrono::high_resolution_clock::now();
     std::string program_path = Local_Storage::get_program_path();
     std::string save_path = Local_Storage::get_user_appdata_path();
 
@@ -1091,6 +1352,10 @@ uint32 create_localstorage_settings(Settings **settings_client_out, Settings **s
     load_custom_broadcasts(local_storage->get_global_settings_path() + "custom_broadcasts.txt", custom_broadcasts);
     load_custom_broadcasts(Local_Storage::get_game_settings_path() + "custom_broadcasts.txt", custom_broadcasts);
 
+    // Multicast group, the one of the game takes priority
+    uint32 multicast_group = load_multicast_group(Local_Storage::get_game_settings_path() + "multicast_group.txt");
+    if (!multicast_group) multicast_group = load_multicast_group(local_storage->get_global_settings_path() + "multicast_group.txt");
+
     // Acount name
     std::string name = parse_account_name(local_storage);
     
@@ -1179,6 +1444,8 @@ uint32 create_localstorage_settings(Settings **settings_client_out, Settings **s
     settings_server->set_port(port);
     settings_client->custom_broadcasts = custom_broadcasts;
     settings_server->custom_broadcasts = custom_broadcasts;
+    settings_client->multicast_group = multicast_group;
+    settings_server->multicast_group = multicast_group;
     settings_client->disable_networking = disable_networking;
     settings_server->disable_networking = disable_networking;
     settings_client->disable_overlay = disable_overlay;
@@ -1221,31 +1488,36 @@ uint32 create_localstorage_settings(Settings **settings_client_out, Settings **s
         settings_server->local_save = save_path;
     }
 
-    parse_dlc(settings_client, settings_server);
-
-    parse_app_paths(settings_client, settings_server, program_path);
-
-    parse_leaderboards(settings_client, settings_server);
-
-    parse_stats(settings_client, settings_server);
-
-    parse_depots(settings_client, settings_server);
-
-    parse_subscribed_groups(settings_client, settings_server);
-
-    parse_installed_app_Ids(settings_client, settings_server);
-
-    parse_force_branch_name(settings_client, settings_server);
-
-    load_subscribed_groups_clans(local_storage->get_global_settings_path() + "subscribed_groups_clans.txt", settings_client, settings_server);
-    load_subscribed_groups_clans(Local_Storage::get_game_settings_path() + "subscribed_groups_clans.txt", settings_client, settings_server);
-
-    load_overlay_appearance(local_storage->get_global_settings_path() + "overlay_appearance.txt", settings_client, settings_server);
-    load_overlay_appearance(Local_Storage::get_game_settings_path() + "overlay_appearance.txt", settings_client, settings_server);
-
-    parse_mods_folder(settings_client, settings_server, local_storage);
-
-    load_gamecontroller_settings(settings_client);
+    long long base_us = elapsed_us(startup_begin);
+
+    // every parser below fills its own members in both Settings objects, so independent files are parsed concurrently
+    // the global and game versions of the same file must stay in order, they run inside one task
+    std::vector<Startup_Task> tasks;
+    add_startup_task(tasks, "DLC.txt", [=]{ parse_dlc(settings_client, settings_server); });
+    add_startup_task(tasks, "app_paths.txt", [=, &program_path]{ parse_app_paths(settings_client, settings_server, program_path); });
+    add_startup_task(tasks, "leaderboards.txt", [=]{ parse_leaderboards(settings_client, settings_server); });
+    add_startup_task(tasks, "stats.txt", [=]{ parse_stats(settings_client, settings_server); });
+    add_startup_task(tasks, "small files", [=]{
+        parse_depots(settings_client, settings_server);
+        parse_subscribed_groups(settings_client, settings_server);
+        parse_installed_app_Ids(settings_client, settings_server);
+        parse_force_branch_name(settings_client, settings_server);
+        parse_voice_input(settings_client, settings_server);
+        parse_screenshot_format(settings_client, settings_server);
+    });
+    add_startup_task(tasks, "subscribed_groups_clans.txt", [=]{
+        load_subscribed_groups_clans(local_storage->get_global_settings_path() + "subscribed_groups_clans.txt", settings_client, settings_server);
+        load_subscribed_groups_clans(Local_Storage::get_game_settings_path() + "subscribed_groups_clans.txt", settings_client, settings_server);
+    });
+    add_startup_task(tasks, "overlay_appearance.txt", [=]{
+        load_overlay_appearance(local_storage->get_global_settings_path() + "overlay_appearance.txt", settings_client, settings_server);
+        load_overlay_appearance(Local_Storage::get_game_settings_path() + "overlay_appearance.txt", settings_client, settings_server);
+    });
+    add_startup_task(tasks, "mods", [=]{ parse_mods_folder(settings_client, settings_server, local_storage); });
+    add_startup_task(tasks, "controller", [=]{ load_gamecontroller_settings(settings_client); });
+    wait_startup_tasks(tasks);
+
+    PRINT_DEBUG("Startup: settings loaded in %lld us, %lld us before the parallel parsers\n", elapsed_us(startup_begin), base_us);
 
     *settings_client_out = settings_client;
     *settings_server_out = settings_server;
@@ -48,12 +48,15 @@ static void background_thread(Steam_Client *client)
     }
 }
 
+static std::atomic<unsigned long long> next_interface_cache_generation(1);
+
 Steam_Client::Steam_Client()
 {
+    interface_cache_generation = next_interface_cache_generation++;
     uint32 appid = create_localstorage_settings(&settings_client, &settings_server, &local_storage);
     local_storage->update_save_filenames(Local_Storage::remote_storage_folder);
 
-    network = new Networking(settings_server->get_local_steam_id(), appid, settings_server->get_port(), &(settings_server->custom_broadcasts), settings_server->disable_networking);
+    network = new Networking(settings_server->get_local_steam_id(), appid, settings_server->get_port(), &(settings_server->custom_broadcasts), settings_server->multicast_group, settings_server->disable_networking);
 
     callback_results_client = new SteamCallResults();
     callback_results_server = new SteamCallResults();
@@ -83,45 +86,45 @@ Steam_Client::Steam_Client()
     steam_apps = new Steam_Apps(settings_client, callback_results_client);
     steam_networking = new Steam_Networking(settings_client, network, callbacks_client, run_every_runcb);
     steam_remote_storage = new Steam_Remote_Storage(settings_client, ugc_bridge, local_storage, callback_results_client);
-    steam_screenshots = new Steam_Screenshots(local_storage, callbacks_client);
-    steam_http = new Steam_HTTP(settings_client, network, callback_results_client, callbacks_client);
-    steam_controller = new Steam_Controller(settings_client, callback_results_client, callbacks_client, run_every_runcb);
-    steam_ugc = new Steam_UGC(settings_client, ugc_bridge, local_storage, callback_results_client, callbacks_client);
-    steam_applist = new Steam_Applist();
-    steam_music = new Steam_Music(callbacks_client);
-    steam_musicremote = new Steam_MusicRemote();
-    steam_HTMLsurface = new Steam_HTMLsurface(settings_client, network, callback_results_client, callbacks_client);
-    steam_inventory = new Steam_Inventory(settings_client, callback_results_client, callbacks_client, run_every_runcb, local_storage);
-    steam_video = new Steam_Video();
-    steam_parental = new Steam_Parental();
+    steam_screenshots.set_factory([this]() { return new Steam_Screenshots(settings_client, local_storage, callbacks_client, run_every_runcb); });
+    steam_http.set_factory([this]() { return new Steam_HTTP(settings_client, network, callback_results_client, callbacks_client); });
+    steam_controller.set_factory([this]() { return new Steam_Controller(settings_client, callback_results_client, callbacks_client, run_every_runcb); });
+    steam_ugc.set_factory([this]() { return new Steam_UGC(settings_client, ugc_bridge, local_storage, callback_results_client, callbacks_client); });
+    steam_applist.set_factory([this]() { return new Steam_Applist(); });
+    steam_music.set_factory([this]() { return new Steam_Music(callbacks_client); });
+    steam_musicremote.set_factory([this]() { return new Steam_MusicRemote(); });
+    steam_HTMLsurface.set_factory([this]() { return new Steam_HTMLsurface(settings_client, network, callback_results_client, callbacks_client); });
+    steam_inventory.set_factory([this]() { return new Steam_Inventory(settings_client, callback_results_client, callbacks_client, run_every_runcb, local_storage); });
+    steam_video.set_factory([this]() { return new Steam_Video(); });
+    steam_parental.set_factory([this]() { return new Steam_Parental(); });
     steam_networking_sockets = new Steam_Networking_Sockets(settings_client, network, callback_results_client, callbacks_client, run_every_runcb, NULL);
     steam_networking_sockets_serialized = new Steam_Networking_Sockets_Serialized(settings_client, network, callback_results_client, callbacks_client, run_every_runcb);
     steam_networking_messages = new Steam_Networking_Messages(settings_client, network, callback_results_client, callbacks_client, run_every_runcb);
-    steam_game_coordinator = new Steam_Game_Coordinator(settings_client, network, callback_results_client, callbacks_client, run_every_runcb);
+    steam_game_coordinator.set_factory([this]() { return new Steam_Game_Coordinator(settings_client, network, callback_results_client, callbacks_client, run_every_runcb); });
     steam_networking_utils = new Steam_Networking_Utils(settings_client, network, callback_results_client, callbacks_client, run_every_runcb);
-    steam_unified_messages = new Steam_Unified_Messages(settings_client, network, callback_results_client, callbacks_client, run_every_runcb);
-    steam_game_search = new Steam_Game_Search(settings_client, network, callback_results_client, callbacks_client, run_every_runcb);
-    steam_parties = new Steam_Parties(settings_client, network, callback_results_client, callbacks_client, run_every_runcb);
-    steam_remoteplay = new Steam_RemotePlay(settings_client, network, callback_results_client, callbacks_client, run_every_runcb);
-    steam_tv = new Steam_TV(settings_client, network, callback_results_client, callbacks_client, run_every_runcb);
+    steam_unified_messages.set_factory([this]() { return new Steam_Unified_Messages(settings_client, network, callback_results_client, callbacks_client, run_every_runcb); });
+    steam_game_search.set_factory([this]() { return new Steam_Game_Search(settings_client, network, callback_results_client, callbacks_client, run_every_runcb); });
+    steam_parties.set_factory([this]() { return new Steam_Parties(settings_client, network, callback_results_client, callbacks_client, run_every_runcb); });
+    steam_remoteplay.set_factory([this]() { return new Steam_RemotePlay(settings_client, network, callback_results_client, callbacks_client, run_every_runcb); });
+    steam_tv.set_factory([this]() { return new Steam_TV(settings_client, network, callback_results_client, callbacks_client, run_every_runcb); });
 
     PRINT_DEBUG("client init gameserver\n");
     steam_gameserver = new Steam_GameServer(settings_server, network, callbacks_server);
     steam_gameserver_utils = new Steam_Utils(settings_server, callback_results_server, steam_overlay);
     steam_gameserverstats = new Steam_GameServerStats(settings_server, network, callback_results_server, callbacks_server);
     steam_gameserver_networking = new Steam_Networking(settings_server, network, callbacks_server, run_every_runcb);
-    steam_gameserver_http = new Steam_HTTP(settings_server, network, callback_results_server, callbacks_server);
-    steam_gameserver_inventory = new Steam_Inventory(settings_server, callback_results_server, callbacks_server, run_every_runcb, local_storage);
-    steam_gameserver_ugc = new Steam_UGC(settings_server, ugc_bridge, local_storage, callback_results_server, callbacks_server);
+    steam_gameserver_http.set_factory([this]() { return new Steam_HTTP(settings_server, network, callback_results_server, callbacks_server); });
+    steam_gameserver_inventory.set_factory([this]() { return new Steam_Inventory(settings_server, callback_results_server, callbacks_server, run_every_runcb, local_storage); });
+    steam_gameserver_ugc.set_factory([this]() { return new Steam_UGC(settings_server, ugc_bridge, local_storage, callback_results_server, callbacks_server); });
     steam_gameserver_apps = new Steam_Apps(settings_server, callback_results_server);
     steam_gameserver_networking_sockets = new Steam_Networking_Sockets(settings_server, network, callback_results_server, callbacks_server, run_every_runcb, steam_networking_sockets->get_shared_between_client_server());
     steam_gameserver_networking_sockets_serialized = new Steam_Networking_Sockets_Serialized(settings_server, network, callback_results_server, callbacks_server, run_every_runcb);
     steam_gameserver_networking_messages = new Steam_Networking_Messages(settings_server, network, callback_results_server, callbacks_server, run_every_runcb);
-    steam_gameserver_game_coordinator = new Steam_Game_Coordinator(settings_server, network, callback_results_server, callbacks_server, run_every_runcb);
-    steam_masterserver_updater = new Steam_Masterserver_Updater(settings_server, network, callback_results_server, callbacks_server, run_every_runcb);
+    steam_gameserver_game_coordinator.set_factory([this]() { return new Steam_Game_Coordinator(settings_server, network, callback_results_server, callbacks_server, run_every_runcb); });
+    steam_masterserver_updater.set_factory([this]() { return new Steam_Masterserver_Updater(settings_server, network, callback_results_server, callbacks_server, run_every_runcb); });
 
     PRINT_DEBUG("client init AppTicket\n");
-    steam_app_ticket = new Steam_AppTicket(settings_client);
+    steam_app_ticket.set_factory([this]() { return new Steam_AppTicket(settings_client); });
 
     gameserver_has_ipv6_functions = false;
 
@@ -135,15 +138,15 @@ Steam_Client::~Steam_Client()
     delete steam_gameserver_utils;
     delete steam_gameserverstats;
     delete steam_gameserver_networking;
-    delete steam_gameserver_http;
-    delete steam_gameserver_inventory;
-    delete steam_gameserver_ugc;
+    steam_gameserver_http.reset();
+    steam_gameserver_inventory.reset();
+    steam_gameserver_ugc.reset();
     delete steam_gameserver_apps;
     delete steam_gameserver_networking_sockets;
     delete steam_gameserver_networking_sockets_serialized;
     delete steam_gameserver_networking_messages;
-    delete steam_gameserver_game_coordinator;
-    delete steam_masterserver_updater;
+    steam_gameserver_game_coordinator.reset();
+    steam_masterserver_updater.reset();
 
     delete steam_matchmaking;
     delete steam_matchmaking_servers;
@@ -151,27 +154,29 @@ Steam_Client::~Steam_Client()
     delete steam_apps;
     delete steam_networking;
     delete steam_remote_storage;
-    delete steam_screenshots;
-    delete steam_http;
-    delete steam_controller;
-    delete steam_ugc;
-    delete steam_applist;
-    delete steam_music;
-    delete steam_musicremote;
-    delete steam_HTMLsurface;
-    delete steam_inventory;
-    delete steam_video;
-    delete steam_parental;
+    steam_screenshots.reset();
+    steam_http.reset();
+    steam_controller.reset();
+    steam_ugc.reset();
+    steam_applist.reset();
+    steam_music.reset();
+    steam_musicremote.reset();
+    steam_HTMLsurface.reset();
+    steam_inventory.reset();
+    steam_video.reset();
+    steam_parental.reset();
     delete steam_networking_sockets;
     delete steam_networking_sockets_serialized;
     delete steam_networking_messages;
-    delete steam_game_coordinator;
+    steam_game_coordinator.reset();
     delete steam_networking_utils;
-    delete steam_unified_messages;
-    delete steam_game_search;
-    delete steam_parties;
-    delete steam_remoteplay;
-    delete steam_tv;
+    steam_unified_messages.reset();
+    steam_game_search.reset();
+    steam_parties.reset();
+    steam_remoteplay.reset();
+    steam_tv.reset();
+
+    steam_app_ticket.reset();
 
     delete steam_utils;
     delete steam_friends;
@@ -548,10 +553,66 @@ ISteamMatchmakingServers *Steam_Client::GetISteamMatchmakingServers( HSteamUser
     return (ISteamMatchmakingServers *)(void *)(ISteamMatchmakingServers *)steam_matchmaking_servers;
 }
 
+// the last interface found by each thread, some engines ask for the same one on every access
+// kept trivially destructible, thread_local objects with destructors aren't reliable in every dll toolchain
+struct Interface_Cache_Hit {
+    unsigned long long generation;
+    bool server;
+    bool has_user;
+    char version[64];
+    void *result;
+};
+static thread_local Interface_Cache_Hit last_interface_hit{};
+
 // returns the a generic interface
 void *Steam_Client::GetISteamGenericInterface( HSteamUser hSteamUser, HSteamPipe hSteamPipe, const char *pchVersion )
 {
     PRINT_DEBUG("GetISteamGenericInterface %s\n", pchVersion);
+    if (!pchVersion) return NULL;
+    auto pipe = steam_pipes.find(hSteamPipe);
+    if (steam_pipes.end() == pipe) return NULL;
+
+    // everything the result depends on besides the version string
+    bool server = pipe->second == Steam_Pipe::SERVER;
+    bool has_user = hSteamUser != 0;
+
+    Interface_Cache_Hit &hit = last_interface_hit;
+    if (hit.generation == interface_cache_generation && hit.server == server && hit.has_user == has_user && strcmp(hit.version, pchVersion) == 0) {
+        return hit.result;
+    }
+
+    void *result = NULL;
+    {
+        std::lock_guard<std::mutex> lock(interface_cache_mutex);
+        auto &cache = interface_cache[server][has_user];
+        auto it = cache.find(pchVersion);
+        if (cache.end() != it) result = it->second;
+    }
+
+    if (!result) {
+        result = resolve_generic_interface(hSteamUser, hSteamPipe, pchVersion);
+        // failures aren't cached, the game might ask again once a user or server exists
+        if (!result) return NULL;
+
+        std::lock_guard<std::mutex> lock(interface_cache_mutex);
+        interface_cache[server][has_user][pchVersion] = result;
+    }
+
+    size_t version_len = strlen(pchVersion);
+    if (version_len < sizeof(hit.version)) {
+        hit.generation = interface_cache_generation;
+        hit.server = server;
+        hit.has_user = has_user;
+        memcpy(hit.version, pchVersion, version_len + 1);
+        hit.result = result;
+    }
+
+    return result;
+}
+
+// walks the known versions, unknown versions of a known interface get the newest one
+void *Steam_Client::resolve_generic_interface( HSteamUser hSteamUser, HSteamPipe hSteamPipe, const char *pchVersion )
+{
     if (!steam_pipes.count(hSteamPipe)) return NULL;
 
     bool server = false;
@@ -957,7 +1018,7 @@ bool Steam_Client::BShutdownIfAllPipesClosed()
             kill_background_thread_cv.notify_one();
         }
 
-        steam_controller->Shutdown();
+        if (steam_controller.created()) steam_controller->Shutdown();
 #ifdef EMU_OVERLAY
     if(!settings_client->disable_overlay)
         steam_overlay->UnSetupOverlay();
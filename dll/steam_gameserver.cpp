@@ -142,6 +142,7 @@ void Steam_GameServer::LogOn( const char *pszToken )
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     call_servers_connected = true;
     logged_in = true;
+    network->restartAnnounces();
 }
 
 void Steam_GameServer::LogOn(
@@ -163,6 +164,7 @@ void Steam_GameServer::LogOnAnonymous()
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
     call_servers_connected = true;
     logged_in = true;
+    network->restartAnnounces();
 }
 
 void Steam_GameServer::LogOn()
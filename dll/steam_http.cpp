@@ -50,49 +50,11 @@ HTTPRequestHandle Steam_HTTP::CreateHTTPRequest( EHTTPMethod eHTTPRequestMethod,
 
     struct Steam_Http_Request request;
     if (url_index) {
-        if (url[url.size() - 1] == '/') url += "index.html";
-        std::string file_path = Local_Storage::get_game_settings_path() + "http/" + Local_Storage::sanitize_string(url.substr(url_index));
-        unsigned long long file_size = file_size_(file_path);
-        if (file_size) {
-            request.response.resize(file_size);
-            long long read = Local_Storage::get_file_data(file_path, (char *)request.response.data(), file_size, 0);
-            if (read < 0) read = 0;
-            if (read != file_size) request.response.resize(read);
-        } else if (!settings->disable_networking && settings->http_online) {
-            std::lock_guard<std::recursive_mutex> lock(global_mutex);
-
-            std::size_t url_directory = file_path.rfind("/");
-            std::string directory_path;
-            std::string file_name;
-            if (url_directory != std::string::npos) {
-                directory_path = file_path.substr(0, url_directory);
-                file_name = file_path.substr(url_directory);
-            }
-            Local_Storage::store_file_data(directory_path, file_name, (char *)"", sizeof(""));
-
-#if defined(STEAM_WIN32)
-            FILE *hfile = fopen(file_path.c_str(), "wb");
-#else
-            FILE *hfile = fopen(file_path.c_str(), "w");
-#endif
-            CURL *chttp = curl_easy_init();
-            curl_easy_setopt(chttp, CURLOPT_URL, url.c_str());
-            curl_easy_setopt(chttp, CURLOPT_WRITEDATA, (void *)hfile);
-            curl_easy_setopt(chttp, CURLOPT_TIMEOUT, 60L);
-            curl_easy_setopt(chttp, CURLOPT_NOSIGNAL, 1L);
-            curl_easy_setopt(chttp, CURLOPT_USE_SSL, CURLUSESSL_TRY);
-            curl_easy_perform(chttp);
-            curl_easy_cleanup(chttp);
-            fclose(hfile);
-
-            file_size = file_size_(file_path);
-            if (file_size) {
-                request.response.resize(file_size);
-                long long read = Local_Storage::get_file_data(file_path, (char *)request.response.data(), file_size, 0);
-                if (read < 0) read = 0;
-                if (read != file_size) request.response.resize(read);
-            }
-        }
+        std::string file_name = url.substr(url_index);
+        if (file_name.back() == '/') file_name += "index.html";
+        Http_Cache::Response response = Http_Cache::get_instance()->fetch(url, Local_Storage::sanitize_string(file_name), !settings->disable_networking && settings->http_online);
+        request.response = std::move(response.body);
+        request.headers = std::move(response.headers);
     }
 
     std::lock_guard<std::recursive_mutex> lock(global_mutex);
@@ -182,14 +144,14 @@ bool Steam_HTTP::SendHTTPRequest( HTTPRequestHandle hRequest, SteamAPICall_t *pC
     struct HTTPRequestCompleted_t data = {};
     data.m_hRequest = request->handle;
     data.m_ulContextValue = request->context_value;
-    if (request->response.size() == 0) {
+    if (request->response_size() == 0) {
         data.m_bRequestSuccessful = false;
         data.m_eStatusCode = k_EHTTPStatusCode404NotFound;
-        data.m_unBodySize = request->response.size();
+        data.m_unBodySize = request->response_size();
     } else {
         data.m_bRequestSuccessful = true;
         data.m_eStatusCode = k_EHTTPStatusCode200OK;
-        data.m_unBodySize = request->response.size();
+        data.m_unBodySize = request->response_size();
     }
 
     if (pCallHandle) {
@@ -243,8 +205,20 @@ bool Steam_HTTP::PrioritizeHTTPRequest( HTTPRequestHandle hRequest )
 // GetHTTPResponseHeaderValue.
 bool Steam_HTTP::GetHTTPResponseHeaderSize( HTTPRequestHandle hRequest, const char *pchHeaderName, uint32 *unResponseHeaderSize )
 {
-    PRINT_DEBUG("Steam_HTTP::GetHTTPResponseHeaderSize\n");
-    return false;
+    PRINT_DEBUG("Steam_HTTP::GetHTTPResponseHeaderSize %s\n", pchHeaderName);
+    std::lock_guard<std::recursive_mutex> lock(global_mutex);
+    Steam_Http_Request *request = get_request(hRequest);
+    if (!request || !pchHeaderName) {
+        return false;
+    }
+
+    const std::string *value = Http_Cache::find_header(request->headers, pchHeaderName);
+    if (!value) {
+        return false;
+    }
+
+    if (unResponseHeaderSize) *unResponseHeaderSize = value->size() + 1;
+    return true;
 }
 
 
@@ -253,8 +227,23 @@ bool Steam_HTTP::GetHTTPResponseHeaderSize( HTTPRequestHandle hRequest, const ch
 // BGetHTTPResponseHeaderSize to check for the presence of the header and to find out the size buffer needed.
 bool Steam_HTTP::GetHTTPResponseHeaderValue( HTTPRequestHandle hRequest, const char *pchHeaderName, uint8 *pHeaderValueBuffer, uint32 unBufferSize )
 {
-    PRINT_DEBUG("Steam_HTTP::GetHTTPResponseHeaderValue\n");
-    return false;
+    PRINT_DEBUG("Steam_HTTP::GetHTTPResponseHeaderValue %s\n", pchHeaderName);
+    std::lock_guard<std::recursive_mutex> lock(global_mutex);
+    Steam_Http_Request *request = get_request(hRequest);
+    if (!request || !pchHeaderName) {
+        return false;
+    }
+
+    const std::string *value = Http_Cache::find_header(request->headers, pchHeaderName);
+    if (!value || unBufferSize < value->size() + 1) {
+        return false;
+    }
+
+    if (pHeaderValueBuffer) {
+        memcpy(pHeaderValueBuffer, value->c_str(), value->size() + 1);
+    }
+
+    return true;
 }
 
 
@@ -268,7 +257,7 @@ bool Steam_HTTP::GetHTTPResponseBodySize( HTTPRequestHandle hRequest, uint32 *un
         return false;
     }
 
-    if (unBodySize) *unBodySize = request->response.size();
+    if (unBodySize) *unBodySize = request->response_size();
     return true;
 }
 
@@ -284,11 +273,11 @@ bool Steam_HTTP::GetHTTPResponseBodyData( HTTPRequestHandle hRequest, uint8 *pBo
         return false;
     }
 
-    if (unBufferSize < request->response.size()) {
+    if (unBufferSize < request->response_size()) {
         return false;
     }
 
-    if (pBodyDataBuffer) memcpy(pBodyDataBuffer, request->response.data(), request->response.size());
+    if (pBodyDataBuffer && request->response) memcpy(pBodyDataBuffer, request->response->data(), request->response->size());
     return true;
 }
 
@@ -17,10 +17,32 @@
 
 #include "dll/steam_screenshots.h" 
 
-Steam_Screenshots::Steam_Screenshots(class Local_Storage* local_storage, class SteamCallBacks* callbacks) :
+Steam_Screenshots::Steam_Screenshots(class Settings* settings, class Local_Storage* local_storage, class SteamCallBacks* callbacks, class RunEveryRunCB* run_every_runcb) :
+    settings(settings),
     local_storage(local_storage),
-    callbacks(callbacks)
+    callbacks(callbacks),
+    run_every_runcb(run_every_runcb)
 {
+    if (settings->screenshot_format == "png" && settings->screenshot_quality >= 0) {
+        Local_Storage::set_png_compression_level(std::min(settings->screenshot_quality, 9));
+    }
+
+    this->run_every_runcb->add(&Steam_Screenshots::steam_run_every_runcb, this);
+}
+
+Steam_Screenshots::~Steam_Screenshots()
+{
+    this->run_every_runcb->remove(&Steam_Screenshots::steam_run_every_runcb, this);
+
+    // the queued screenshots are still written
+    {
+        std::lock_guard<std::mutex> lock(jobs_mutex);
+        stop_workers = true;
+    }
+    jobs_cv.notify_all();
+    for (auto &worker : workers) {
+        worker.join();
+    }
 }
 
 ScreenshotHandle Steam_Screenshots::create_screenshot_handle()
@@ -29,26 +51,130 @@ ScreenshotHandle Steam_Screenshots::create_screenshot_handle()
     return handle++;
 }
 
-// Writes a screenshot to the user's screenshot library given the raw image data, which must be in RGB format.
-// The return value is a handle that is valid for the duration of the game process and can be used to apply tags.
-ScreenshotHandle Steam_Screenshots::WriteScreenshot( void *pubRGB, uint32 cubRGB, int nWidth, int nHeight )
+std::string Steam_Screenshots::create_screenshot_name()
 {
-    PRINT_DEBUG("Steam_Screenshots::WriteScreenshot\n");
-    
     char buff[128];
     auto now = std::chrono::system_clock::now();
     time_t now_time;
     now_time = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
     strftime(buff, 128, "%a_%b_%d_%H_%M_%S_%Y", localtime(&now_time));
+
+    // more than one screenshot in the same second
     std::string screenshot_name = buff;
-    screenshot_name += ".png";
+    if (screenshot_name == last_screenshot_name) {
+        return screenshot_name + "_" + std::to_string(++last_screenshot_count);
+    }
+
+    last_screenshot_name = screenshot_name;
+    last_screenshot_count = 0;
+    return screenshot_name;
+}
+
+void Steam_Screenshots::queue_job(Screenshot_Job &&job)
+{
+    std::lock_guard<std::mutex> lock(jobs_mutex);
+    jobs.push(std::move(job));
+
+    // one screenshot at a time is enough most of the time, bursts get more threads
+    unsigned max_workers = std::max(1u, std::min(4u, std::thread::hardware_concurrency() / 2));
+    if (workers.empty() || (workers.size() < max_workers && jobs.size() > 1)) {
+        workers.emplace_back(worker_thread, this);
+    } else {
+        jobs_cv.notify_one();
+    }
+}
+
+EResult Steam_Screenshots::run_job(Screenshot_Job &job)
+{
+    int jpg_quality = settings->screenshot_quality > 0 ? std::min(settings->screenshot_quality, 100) : 90;
+
+    if (job.source_path.empty()) {
+        if (!local_storage->save_screenshot(job.file_name, (const uint8_t *)job.pixels.data(), job.width, job.height, 3, jpg_quality))
+            return k_EResultIOFailure;
+
+        int thumbnail_height = std::max(1, job.height * thumbnail_width / job.width);
+        std::string thumbnail = Local_Storage::scale_image((const uint8_t *)job.pixels.data(), job.width, job.height, 3, thumbnail_width, thumbnail_height);
+        if (thumbnail.size()) local_storage->save_screenshot(job.thumbnail_name, (const uint8_t *)thumbnail.data(), thumbnail_width, thumbnail_height, 3, jpg_quality);
+        return k_EResultOK;
+    }
+
+    // copied by AddScreenshotToLibrary, a missing thumbnail doesn't fail the screenshot
+    int width, height;
+    std::string pixels = Local_Storage::load_image_data(job.source_path, "", &width, &height);
+    if (pixels.size()) {
+        int thumbnail_height = std::max(1, height * thumbnail_width / width);
+        std::string thumbnail = Local_Storage::scale_image((const uint8_t *)pixels.data(), width, height, 4, thumbnail_width, thumbnail_height);
+        if (thumbnail.size()) local_storage->save_screenshot(job.thumbnail_name, (const uint8_t *)thumbnail.data(), thumbnail_width, thumbnail_height, 4, jpg_quality);
+    }
+
+    return k_EResultOK;
+}
+
+void Steam_Screenshots::worker_thread(Steam_Screenshots *steam_screenshots)
+{
+    std::unique_lock<std::mutex> lock(steam_screenshots->jobs_mutex);
+    while (true) {
+        steam_screenshots->jobs_cv.wait(lock, [steam_screenshots]{ return steam_screenshots->stop_workers || !steam_screenshots->jobs.empty(); });
+        if (steam_screenshots->jobs.empty()) return;
 
-    if (!local_storage->save_screenshot( screenshot_name, (uint8_t*)pubRGB, nWidth, nHeight, 3))
+        Screenshot_Job job = std::move(steam_screenshots->jobs.front());
+        steam_screenshots->jobs.pop();
+        lock.unlock();
+
+        EResult result = steam_screenshots->run_job(job);
+        PRINT_DEBUG("Steam_Screenshots::worker_thread %s %i\n", job.file_name.c_str(), (int)result);
+
+        lock.lock();
+        steam_screenshots->finished_jobs.emplace_back(job.handle, result);
+    }
+}
+
+void Steam_Screenshots::steam_run_every_runcb(void *object)
+{
+    Steam_Screenshots *steam_screenshots = (Steam_Screenshots *)object;
+    steam_screenshots->RunCallbacks();
+}
+
+void Steam_Screenshots::RunCallbacks()
+{
+    std::vector<std::pair<ScreenshotHandle, EResult>> finished;
+    {
+        std::lock_guard<std::mutex> lock(jobs_mutex);
+        if (finished_jobs.empty()) return;
+        finished.swap(finished_jobs);
+    }
+
+    for (auto &f : finished) {
+        ScreenshotReady_t data;
+        data.m_hLocal = f.first;
+        data.m_eResult = f.second;
+        callbacks->addCBResult(data.k_iCallback, &data, sizeof(data));
+    }
+}
+
+// Writes a screenshot to the user's screenshot library given the raw image data, which must be in RGB format.
+// The return value is a handle that is valid for the duration of the game process and can be used to apply tags.
+ScreenshotHandle Steam_Screenshots::WriteScreenshot( void *pubRGB, uint32 cubRGB, int nWidth, int nHeight )
+{
+    PRINT_DEBUG("Steam_Screenshots::WriteScreenshot\n");
+
+    if (!pubRGB || nWidth <= 0 || nHeight <= 0 || cubRGB < (uint64)nWidth * nHeight * 3)
         return INVALID_SCREENSHOT_HANDLE;
 
+    std::string screenshot_name = create_screenshot_name();
     auto handle = create_screenshot_handle();
+
+    Screenshot_Job job;
+    job.handle = handle;
+    job.file_name = screenshot_name + "." + settings->screenshot_format;
+    job.thumbnail_name = std::string("thumbnails") + PATH_SEPARATOR + job.file_name;
+    job.pixels.assign((const char *)pubRGB, (size_t)nWidth * nHeight * 3);
+    job.width = nWidth;
+    job.height = nHeight;
+    queue_job(std::move(job));
+
     auto& infos = _screenshots[handle];
-    infos.screenshot_name = buff;
+    infos.screenshot_name = screenshot_name;
 
     return handle;
 }
@@ -65,24 +191,42 @@ ScreenshotHandle Steam_Screenshots::AddScreenshotToLibrary( const char *pchFilen
     if (pchFilename == nullptr)
         return INVALID_SCREENSHOT_HANDLE;
 
-    std::vector<image_pixel_t> pixels(std::move(local_storage->load_image(pchFilename)));
-    if (pixels.size() != size_t(nWidth) * size_t(nHeight))
+    int width, height;
+    if (!Local_Storage::get_image_size(pchFilename, &width, &height) || width != nWidth || height != nHeight)
         return INVALID_SCREENSHOT_HANDLE;
 
-    char buff[128];
-    auto now = std::chrono::system_clock::now();
-    time_t now_time;
-    now_time = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
-    strftime(buff, 128, "%a_%b_%d_%H_%M_%S_%Y", localtime(&now_time));
-    std::string screenshot_name = buff;
-    screenshot_name += ".png";
+    std::string extension = std::filesystem::u8path(pchFilename).extension().u8string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c){ return std::tolower(c); });
+    if (extension == ".jpeg") extension = ".jpg";
 
-    if (!local_storage->save_screenshot(screenshot_name, (uint8_t*)pixels.data(), nWidth, nHeight, 4))
+    // the files are copied before returning, games often pass temporary files they delete right after
+    std::string screenshot_name = create_screenshot_name();
+    std::string file_name = screenshot_name + extension;
+    if (!local_storage->copy_screenshot(file_name, pchFilename))
         return INVALID_SCREENSHOT_HANDLE;
 
     auto handle = create_screenshot_handle();
+    if (pchThumbnailFilename && *pchThumbnailFilename) {
+        std::string thumbnail_extension = std::filesystem::u8path(pchThumbnailFilename).extension().u8string();
+        std::transform(thumbnail_extension.begin(), thumbnail_extension.end(), thumbnail_extension.begin(), [](unsigned char c){ return std::tolower(c); });
+        local_storage->copy_screenshot(std::string("thumbnails") + PATH_SEPARATOR + screenshot_name + thumbnail_extension, pchThumbnailFilename);
+
+        std::lock_guard<std::mutex> lock(jobs_mutex);
+        finished_jobs.emplace_back(handle, k_EResultOK);
+    } else {
+        // only the thumbnail is made by a worker, from the copy in the library
+        Screenshot_Job job;
+        job.handle = handle;
+        job.file_name = file_name;
+        job.thumbnail_name = std::string("thumbnails") + PATH_SEPARATOR + screenshot_name + "." + settings->screenshot_format;
+        job.width = nWidth;
+        job.height = nHeight;
+        job.source_path = local_storage->get_screenshot_path(file_name);
+        queue_job(std::move(job));
+    }
+
     auto& infos = _screenshots[handle];
-    infos.screenshot_name = buff;
+    infos.screenshot_name = screenshot_name;
 
     return handle;
 }
@@ -0,0 +1,252 @@
+#include "dll/ugc_catalog.h"
+
+
+static void intersect_postings(std::vector<uint32> &current, bool &restricted, const std::vector<uint32> &postings)
+{
+    if (!restricted) {
+        current = postings;
+        restricted = true;
+        return;
+    }
+
+    std::vector<uint32> result;
+    std::set_intersection(current.begin(), current.end(), postings.begin(), postings.end(), std::back_inserter(result));
+    current = std::move(result);
+}
+
+static void union_postings(std::vector<uint32> &current, const std::vector<uint32> &postings)
+{
+    std::vector<uint32> result;
+    std::set_union(current.begin(), current.end(), postings.begin(), postings.end(), std::back_inserter(result));
+    current = std::move(result);
+}
+
+static bool in_range(RTime32 time, RTime32 start, RTime32 end)
+{
+    if (start && time < start) return false;
+    if (end && time > end) return false;
+    return true;
+}
+
+std::vector<std::string> Ugc_Catalog::split_tags(const std::string &tags)
+{
+    std::vector<std::string> result;
+    size_t start = 0;
+    while (start <= tags.size()) {
+        size_t end = tags.find(',', start);
+        if (end == std::string::npos) end = tags.size();
+
+        size_t first = tags.find_first_not_of(" \t\r\n", start);
+        if (first != std::string::npos && first < end) {
+            size_t last = tags.find_last_not_of(" \t\r\n", end - 1);
+            result.push_back(tags.substr(first, last - first + 1));
+        }
+
+        start = end + 1;
+    }
+
+    return result;
+}
+
+std::vector<std::string> Ugc_Catalog::tokenize(const std::string &text)
+{
+    std::vector<std::string> result;
+    std::string word;
+    for (unsigned char c : text) {
+        // bytes above 127 are kept so utf-8 words still match
+        if (std::isalnum(c) || c >= 128) {
+            word.push_back((char)std::tolower(c));
+        } else if (word.size()) {
+            result.push_back(std::move(word));
+            word.clear();
+        }
+    }
+
+    if (word.size()) result.push_back(std::move(word));
+    return result;
+}
+
+void Ugc_Catalog::build(const std::vector<struct Mod_entry> &mods)
+{
+    items.clear();
+    index.clear();
+    tag_postings.clear();
+    key_value_postings.clear();
+    words.clear();
+
+    items.reserve(mods.size());
+    std::unordered_map<std::string, std::vector<uint32>> word_postings;
+    for (auto &mod : mods) {
+        if (index.count(mod.id)) continue;
+
+        uint32 item_index = (uint32)items.size();
+        index[mod.id] = item_index;
+
+        Item item{};
+        item.id = mod.id;
+        item.tags = split_tags(mod.tags);
+        item.key_value_tags = mod.keyValueTags;
+        item.time_created = mod.timeCreated;
+        item.time_updated = mod.timeUpdated;
+        item.votes_up = mod.votesUp;
+
+        // items are added in increasing order, checking the last entry keeps the posting lists sorted and unique
+        for (auto &tag : item.tags) {
+            auto &postings = tag_postings[ascii_to_lowercase(tag)];
+            if (postings.empty() || postings.back() != item_index) postings.push_back(item_index);
+        }
+
+        for (auto &kv : item.key_value_tags) {
+            auto &postings = key_value_postings[ascii_to_lowercase(kv.first) + '\n' + kv.second];
+            if (postings.empty() || postings.back() != item_index) postings.push_back(item_index);
+        }
+
+        for (auto &text : {std::cref(mod.title), std::cref(mod.description)}) {
+            for (auto &word : tokenize(text.get())) {
+                auto &postings = word_postings[word];
+                if (postings.empty() || postings.back() != item_index) postings.push_back(item_index);
+            }
+        }
+
+        items.push_back(std::move(item));
+    }
+
+    words.reserve(word_postings.size());
+    for (auto &w : word_postings) {
+        words.emplace_back(w.first, std::move(w.second));
+    }
+    std::sort(words.begin(), words.end(), [](const std::pair<std::string, std::vector<uint32>> &a, const std::pair<std::string, std::vector<uint32>> &b) {
+        return a.first < b.first;
+    });
+
+    PRINT_DEBUG("Ugc_Catalog::build %zu mods, %zu tags, %zu words\n", items.size(), tag_postings.size(), words.size());
+}
+
+size_t Ugc_Catalog::size() const
+{
+    return items.size();
+}
+
+const std::vector<std::string> *Ugc_Catalog::get_tags(PublishedFileId_t id) const
+{
+    auto it = index.find(id);
+    if (index.end() == it) return nullptr;
+    return &items[it->second].tags;
+}
+
+const std::vector<std::pair<std::string, std::string>> *Ugc_Catalog::get_key_value_tags(PublishedFileId_t id) const
+{
+    auto it = index.find(id);
+    if (index.end() == it) return nullptr;
+    return &items[it->second].key_value_tags;
+}
+
+const std::vector<uint32> *Ugc_Catalog::find_postings(const std::unordered_map<std::string, std::vector<uint32>> &postings, const std::string &key) const
+{
+    auto it = postings.find(key);
+    if (postings.end() == it) return nullptr;
+    return &it->second;
+}
+
+std::vector<uint32> Ugc_Catalog::words_with_prefix(const std::string &prefix) const
+{
+    std::vector<uint32> result;
+    auto it = std::lower_bound(words.begin(), words.end(), prefix, [](const std::pair<std::string, std::vector<uint32>> &w, const std::string &p) {
+        return w.first < p;
+    });
+
+    for (; it != words.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+        union_postings(result, it->second);
+    }
+
+    return result;
+}
+
+std::vector<PublishedFileId_t> Ugc_Catalog::query(const Filter &filter, Sort sort, const std::vector<PublishedFileId_t> *candidates) const
+{
+    static const std::vector<uint32> no_postings{};
+
+    // narrow down with the posting lists first, restricted stays false as long as everything matches
+    std::vector<uint32> current;
+    bool restricted = false;
+
+    if (filter.required_tags.size()) {
+        if (filter.match_any_tag) {
+            std::vector<uint32> any;
+            for (auto &tag : filter.required_tags) {
+                auto postings = find_postings(tag_postings, ascii_to_lowercase(tag));
+                if (postings) union_postings(any, *postings);
+            }
+            intersect_postings(current, restricted, any);
+        } else {
+            for (auto &tag : filter.required_tags) {
+                auto postings = find_postings(tag_postings, ascii_to_lowercase(tag));
+                intersect_postings(current, restricted, postings ? *postings : no_postings);
+            }
+        }
+    }
+
+    for (auto &group : filter.required_tag_groups) {
+        std::vector<uint32> any;
+        for (auto &tag : group) {
+            auto postings = find_postings(tag_postings, ascii_to_lowercase(tag));
+            if (postings) union_postings(any, *postings);
+        }
+        intersect_postings(current, restricted, any);
+    }
+
+    for (auto &kv : filter.required_key_value_tags) {
+        auto postings = find_postings(key_value_postings, ascii_to_lowercase(kv.first) + '\n' + kv.second);
+        intersect_postings(current, restricted, postings ? *postings : no_postings);
+    }
+
+    for (auto &word : tokenize(filter.search_text)) {
+        intersect_postings(current, restricted, words_with_prefix(word));
+    }
+
+    std::vector<bool> matched(items.size(), !restricted);
+    for (auto i : current) matched[i] = true;
+
+    for (auto &tag : filter.excluded_tags) {
+        auto postings = find_postings(tag_postings, ascii_to_lowercase(tag));
+        if (!postings) continue;
+        for (auto i : *postings) matched[i] = false;
+    }
+
+    std::vector<uint32> selected;
+    auto select = [&](uint32 i) {
+        if (!matched[i]) return;
+        const Item &item = items[i];
+        if (!in_range(item.time_created, filter.created_start, filter.created_end)) return;
+        if (!in_range(item.time_updated, filter.updated_start, filter.updated_end)) return;
+        selected.push_back(i);
+    };
+
+    if (candidates) {
+        for (auto id : *candidates) {
+            auto it = index.find(id);
+            if (index.end() != it) select(it->second);
+        }
+    } else {
+        for (uint32 i = 0; i < (uint32)items.size(); ++i) select(i);
+    }
+
+    switch (sort) {
+    case Sort::CREATED_DESC:
+        std::stable_sort(selected.begin(), selected.end(), [this](uint32 a, uint32 b) { return items[a].time_created > items[b].time_created; });
+        break;
+    case Sort::UPDATED_DESC:
+        std::stable_sort(selected.begin(), selected.end(), [this](uint32 a, uint32 b) { return items[a].time_updated > items[b].time_updated; });
+        break;
+    case Sort::VOTES_DESC:
+        std::stable_sort(selected.begin(), selected.end(), [this](uint32 a, uint32 b) { return items[a].votes_up > items[b].votes_up; });
+        break;
+    default:
+        break;
+    }
+
+    std::vector<PublishedFileId_t> result;
+    result.reserve(selected.size());
+    for (auto i : selected) result.push_back(items[i].id);
+    return result;
+}
@@ -0,0 +1,545 @@
+/* Copyright (C) 2019 Mr Goldberg
+   This file is part of the Goldberg Emulator
+
+   The Goldberg Emulator is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   The Goldberg Emulator is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the Goldberg Emulator; if not, see
+   <http://www.gnu.org/licenses/>.  */
+
+#include "dll/voice.h"
+#include <cmath>
+
+// frame layout (little endian):
+//   uint16 samples count
+//   int16  first sample
+//   uint8  step index
+//   uint8  reserved
+//   4-bit IMA ADPCM codes for the rest of the samples, low nibble first
+constexpr size_t voice_frame_header_size = 6;
+// sanity limit when decoding data coming from other peers
+constexpr uint16 voice_max_frame_samples = 4096;
+// frames quieter than this are never considered speech (RMS)
+constexpr double voice_vad_min_rms = 300.0;
+// frames must be this much louder than the noise floor to be considered speech
+constexpr double voice_vad_noise_ratio = 3.0;
+
+static const int ima_index_table[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8,
+    -1, -1, -1, -1, 2, 4, 6, 8,
+};
+
+static const int ima_step_table[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17,
+    19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118,
+    130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+    337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+    876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358,
+    5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+};
+
+static inline int clamp_step_index(int index)
+{
+    if (index < 0) return 0;
+    if (index > 88) return 88;
+    return index;
+}
+
+static inline int16_t clamp_sample(int sample)
+{
+    if (sample > 32767) return 32767;
+    if (sample < -32768) return -32768;
+    return (int16_t)sample;
+}
+
+// decodes a single code and updates the predictor state
+static inline int16_t ima_decode(uint8_t code, int &predictor, int &index)
+{
+    int step = ima_step_table[index];
+    int diff = step >> 3;
+    if (code & 4) diff += step;
+    if (code & 2) diff += step >> 1;
+    if (code & 1) diff += step >> 2;
+    if (code & 8) diff = -diff;
+
+    predictor = clamp_sample(predictor + diff);
+    index = clamp_step_index(index + ima_index_table[code]);
+    return (int16_t)predictor;
+}
+
+static inline uint8_t ima_encode(int16_t sample, int &predictor, int &index)
+{
+    int step = ima_step_table[index];
+    int diff = sample - predictor;
+    uint8_t code = 0;
+    if (diff < 0) {
+        code = 8;
+        diff = -diff;
+    }
+
+    if (diff >= step) { code |= 4; diff -= step; }
+    step >>= 1;
+    if (diff >= step) { code |= 2; diff -= step; }
+    step >>= 1;
+    if (diff >= step) { code |= 1; }
+
+    // run the decoder so both sides stay in sync
+    ima_decode(code, predictor, index);
+    return code;
+}
+
+static void encode_frame(std::string &out, const int16_t *samples, uint16 count, int &index)
+{
+    if (!count) return;
+
+    size_t start = out.size();
+    out.resize(start + voice_frame_header_size + (count / 2));
+    uint8_t *p = (uint8_t *)&out[start];
+    p[0] = count & 0xFF;
+    p[1] = (count >> 8) & 0xFF;
+    p[2] = (uint16)samples[0] & 0xFF;
+    p[3] = ((uint16)samples[0] >> 8) & 0xFF;
+    p[4] = (uint8_t)index;
+    p[5] = 0;
+    p += voice_frame_header_size;
+
+    int predictor = samples[0];
+    for (uint16 i = 1; i < count; ++i) {
+        uint8_t code = ima_encode(samples[i], predictor, index);
+        if (i & 1) {
+            *p = code;
+        } else {
+            *p |= code << 4;
+            ++p;
+        }
+    }
+}
+
+// returns the size of the frame at data, or 0 if it's malformed
+static size_t decode_frame(const uint8_t *data, size_t size, std::vector<int16_t> &out)
+{
+    if (size < voice_frame_header_size) return 0;
+    uint16 count = (uint16)(data[0] | (data[1] << 8));
+    int predictor = (int16_t)(uint16)(data[2] | (data[3] << 8));
+    int index = data[4];
+    if (!count || count > voice_max_frame_samples || index > 88) return 0;
+
+    size_t frame_size = voice_frame_header_size + (count / 2);
+    if (size < frame_size) return 0;
+
+    out.push_back((int16_t)predictor);
+    const uint8_t *p = data + voice_frame_header_size;
+    for (uint16 i = 1; i < count; ++i) {
+        uint8_t code = (i & 1) ? (*p & 0x0F) : (*p++ >> 4);
+        out.push_back(ima_decode(code, predictor, index));
+    }
+
+    return frame_size;
+}
+
+
+class Voice_Source_File : public Voice_Source {
+    std::ifstream file;
+    uint32 rate;
+    uint16 channels;
+    uint64 data_left;
+
+    // the file is read as if it was a microphone, in real time
+    std::chrono::high_resolution_clock::time_point start_time{};
+    uint64 delivered = 0;
+
+public:
+    Voice_Source_File(const std::string &path, uint32 raw_sample_rate)
+    {
+        file.open(utf8_decode(path), std::ios::binary);
+        rate = raw_sample_rate;
+        channels = 1;
+        data_left = UINT64_MAX;
+
+        if (file.is_open() && common_helpers::ends_with_i(path, ".wav")) {
+            data_left = 0;
+            parse_wav_header();
+        }
+    }
+
+    void parse_wav_header()
+    {
+        char riff[12]{};
+        if (!file.read(riff, sizeof(riff)) || memcmp(riff, "RIFF", 4) != 0 || memcmp(riff + 8, "WAVE", 4) != 0) {
+            PRINT_DEBUG("Voice_Source_File invalid wav file\n");
+            return;
+        }
+
+        bool format_ok = false;
+        char chunk[8];
+        while (file.read(chunk, sizeof(chunk))) {
+            uint32 chunk_size = (uint8_t)chunk[4] | ((uint8_t)chunk[5] << 8) | ((uint8_t)chunk[6] << 16) | ((uint32)(uint8_t)chunk[7] << 24);
+            if (memcmp(chunk, "fmt ", 4) == 0 && chunk_size >= 16) {
+                uint8_t fmt[16];
+                if (!file.read((char *)fmt, sizeof(fmt))) return;
+                uint16 audio_format = fmt[0] | (fmt[1] << 8);
+                channels = fmt[2] | (fmt[3] << 8);
+                rate = fmt[4] | (fmt[5] << 8) | (fmt[6] << 16) | ((uint32)fmt[7] << 24);
+                uint16 bits = fmt[14] | (fmt[15] << 8);
+                format_ok = audio_format == 1 && bits == 16 && channels >= 1 && channels <= 2 && rate > 0;
+                file.seekg(chunk_size - sizeof(fmt) + (chunk_size & 1), std::ios::cur);
+            } else if (memcmp(chunk, "data", 4) == 0) {
+                if (format_ok) data_left = chunk_size;
+                else PRINT_DEBUG("Voice_Source_File unsupported wav format, only 16-bit PCM mono/stereo is supported\n");
+                return;
+            } else {
+                file.seekg(chunk_size + (chunk_size & 1), std::ios::cur);
+            }
+        }
+    }
+
+    uint32 sample_rate()
+    {
+        return rate;
+    }
+
+    void start()
+    {
+        start_time = std::chrono::high_resolution_clock::now();
+        delivered = 0;
+    }
+
+    size_t read(int16_t *out, size_t max_samples)
+    {
+        if (!file.is_open() || !data_left) return 0;
+
+        double seconds = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::high_resolution_clock::now() - start_time).count();
+        uint64 due = (uint64)(seconds * rate);
+        if (due <= delivered) return 0;
+
+        size_t count = (size_t)std::min<uint64>(due - delivered, max_samples);
+        count = (size_t)std::min<uint64>(count, data_left / (2 * channels));
+        if (!count) {
+            data_left = 0;
+            return 0;
+        }
+
+        std::vector<uint8_t> raw(count * 2 * channels);
+        file.read((char *)raw.data(), raw.size());
+        count = (size_t)file.gcount() / (2 * channels);
+        for (size_t i = 0; i < count; ++i) {
+            const uint8_t *s = &raw[i * 2 * channels];
+            int sample = (int16_t)(uint16)(s[0] | (s[1] << 8));
+            if (channels == 2) {
+                sample = (sample + (int16_t)(uint16)(s[2] | (s[3] << 8))) / 2;
+            }
+
+            out[i] = (int16_t)sample;
+        }
+
+        if (!count) data_left = 0;
+        else if (data_left != UINT64_MAX) data_left -= count * 2 * channels;
+        delivered += count;
+        return count;
+    }
+};
+
+#if defined(__LINUX__)
+// named pipe, whatever is written to it is the microphone input (raw signed 16-bit little endian mono)
+class Voice_Source_Pipe : public Voice_Source {
+    int fd;
+    uint32 rate;
+    bool has_odd_byte = false;
+    uint8_t odd_byte = 0;
+
+public:
+    Voice_Source_Pipe(const std::string &path, uint32 raw_sample_rate)
+    {
+        fd = open(path.c_str(), O_RDONLY | O_NONBLOCK);
+        rate = raw_sample_rate;
+    }
+
+    ~Voice_Source_Pipe()
+    {
+        if (fd >= 0) close(fd);
+    }
+
+    uint32 sample_rate()
+    {
+        return rate;
+    }
+
+    size_t read(int16_t *out, size_t max_samples)
+    {
+        if (fd < 0 || !max_samples) return 0;
+
+        std::vector<uint8_t> raw(max_samples * 2);
+        size_t offset = 0;
+        if (has_odd_byte) {
+            raw[0] = odd_byte;
+            offset = 1;
+        }
+
+        ssize_t got = ::read(fd, raw.data() + offset, raw.size() - offset);
+        if (got <= 0) return 0;
+
+        size_t bytes = offset + (size_t)got;
+        size_t count = bytes / 2;
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = (int16_t)(uint16)(raw[i * 2] | (raw[i * 2 + 1] << 8));
+        }
+
+        has_odd_byte = bytes & 1;
+        if (has_odd_byte) odd_byte = raw[bytes - 1];
+        return count;
+    }
+};
+#endif
+
+Voice_Source *Voice_Source::create(const std::string &path, uint32 raw_sample_rate)
+{
+    if (path.empty()) return nullptr;
+    if (!raw_sample_rate) raw_sample_rate = VOICE_CODEC_SAMPLE_RATE;
+
+#if defined(__LINUX__)
+    struct stat buffer{};
+    if (stat(path.c_str(), &buffer) == 0 && S_ISFIFO(buffer.st_mode)) {
+        PRINT_DEBUG("Voice_Source using named pipe '%s'\n", path.c_str());
+        return new Voice_Source_Pipe(path, raw_sample_rate);
+    }
+#endif
+
+    PRINT_DEBUG("Voice_Source using file '%s'\n", path.c_str());
+    return new Voice_Source_File(path, raw_sample_rate);
+}
+
+
+Voice_Recorder::Voice_Recorder(const std::string &input_path, uint32 raw_sample_rate)
+{
+    source = Voice_Source::create(input_path, raw_sample_rate);
+    frame.reserve(VOICE_FRAME_SAMPLES);
+}
+
+Voice_Recorder::~Voice_Recorder()
+{
+    delete source;
+}
+
+void Voice_Recorder::start()
+{
+    if (!recording && source) source->start();
+    recording = true;
+}
+
+void Voice_Recorder::stop()
+{
+    if (recording) stop_time = std::chrono::high_resolution_clock::now();
+    recording = false;
+}
+
+bool Voice_Recorder::is_active()
+{
+    if (recording || pending.size()) return true;
+
+    auto tail = std::chrono::milliseconds(VOICE_HANGOVER_FRAMES * 20);
+    return std::chrono::high_resolution_clock::now() - stop_time < tail;
+}
+
+void Voice_Recorder::capture()
+{
+    if (!source) return;
+
+    const uint32 source_rate = source->sample_rate();
+    const double ratio = (double)source_rate / (double)VOICE_CODEC_SAMPLE_RATE;
+    int16_t buffer[1024];
+    size_t got;
+    while ((got = source->read(buffer, sizeof(buffer) / sizeof(buffer[0]))) > 0) {
+        captured.insert(captured.end(), buffer, buffer + got);
+
+        // linear resampling to the codec rate
+        size_t pos;
+        while ((pos = (size_t)resample_pos) + 1 < captured.size()) {
+            double frac = resample_pos - (double)pos;
+            frame.push_back((int16_t)(captured[pos] + (captured[pos + 1] - captured[pos]) * frac));
+            resample_pos += ratio;
+
+            if (frame.size() == VOICE_FRAME_SAMPLES) {
+                process_frame();
+                frame.clear();
+            }
+        }
+
+        pos = std::min((size_t)resample_pos, captured.size());
+        captured.erase(captured.begin(), captured.begin() + pos);
+        resample_pos -= (double)pos;
+    }
+}
+
+void Voice_Recorder::process_frame()
+{
+    double energy = 0.0;
+    for (int16_t s : frame) {
+        energy += (double)s * (double)s;
+    }
+
+    double rms = std::sqrt(energy / (double)frame.size());
+    bool speech = rms >= voice_vad_min_rms && rms >= noise_floor * voice_vad_noise_ratio;
+
+    // the floor follows quiet frames right away, and rises very slowly during speech
+    if (rms < noise_floor || noise_floor <= 0.0) noise_floor = rms;
+    else noise_floor += (rms - noise_floor) * (speech ? 0.001 : 0.05);
+
+    if (speech) {
+        hangover = VOICE_HANGOVER_FRAMES;
+    } else if (hangover) {
+        --hangover;
+    } else {
+        // silence, nothing is produced
+        step_index = 0;
+        return;
+    }
+
+    std::string compressed;
+    encode_frame(compressed, frame.data(), (uint16)frame.size(), step_index);
+    pending_bytes += compressed.size();
+    pending.push_back(std::move(compressed));
+
+    while (pending_bytes > VOICE_MAX_PENDING_BYTES) {
+        pending_bytes -= pending.front().size();
+        pending.pop_front();
+    }
+}
+
+void Voice_Recorder::update()
+{
+    if (is_active()) capture();
+}
+
+uint32 Voice_Recorder::available_compressed()
+{
+    return (uint32)pending_bytes;
+}
+
+// bytes of the decompressed pcm of this many frames, same math as decompress()
+static uint32 uncompressed_frames_size(size_t frames, uint32 sample_rate)
+{
+    uint64 samples = (uint64)frames * VOICE_FRAME_SAMPLES;
+    return (uint32)(samples * sample_rate / VOICE_CODEC_SAMPLE_RATE * 2);
+}
+
+uint32 Voice_Recorder::available_uncompressed(uint32 sample_rate)
+{
+    return uncompressed_frames_size(pending.size(), sample_rate);
+}
+
+EVoiceResult Voice_Recorder::get_voice(bool want_compressed, void *dest, uint32 dest_size, uint32 *written, bool want_uncompressed, void *uncompressed_dest, uint32 uncompressed_dest_size, uint32 *uncompressed_written, uint32 sample_rate)
+{
+    if (written) *written = 0;
+    if (uncompressed_written) *uncompressed_written = 0;
+    if (pending.empty()) return k_EVoiceResultNoData;
+    // nothing asked for, the frames stay for the next call
+    if (!want_compressed && !want_uncompressed) return k_EVoiceResultOK;
+
+    if (!dest) dest_size = 0;
+    if (!uncompressed_dest) uncompressed_dest_size = 0;
+    if (sample_rate < 11025 || sample_rate > 48000) sample_rate = VOICE_CODEC_SAMPLE_RATE;
+
+    // only whole frames are handed out, as many as fit in every requested buffer
+    size_t frames = 0;
+    size_t bytes = 0;
+    for (auto &f : pending) {
+        if (want_compressed && bytes + f.size() > dest_size) break;
+        if (want_uncompressed && uncompressed_frames_size(frames + 1, sample_rate) > uncompressed_dest_size) break;
+        bytes += f.size();
+        ++frames;
+    }
+
+    if (!frames) return k_EVoiceResultBufferTooSmall;
+
+    std::string out;
+    out.reserve(bytes);
+    for (size_t i = 0; i < frames; ++i) {
+        out += pending[i];
+    }
+
+    if (want_uncompressed) {
+        uint32 needed = 0;
+        EVoiceResult res = decompress(out.data(), (uint32)out.size(), uncompressed_dest, uncompressed_dest_size, &needed, sample_rate);
+        if (res != k_EVoiceResultOK) return res;
+        if (uncompressed_written) *uncompressed_written = needed;
+    }
+
+    if (want_compressed) {
+        memcpy(dest, out.data(), out.size());
+        if (written) *written = (uint32)out.size();
+    }
+
+    // consumed only once everything was written
+    for (size_t i = 0; i < frames; ++i) {
+        pending_bytes -= pending.front().size();
+        pending.pop_front();
+    }
+
+    return k_EVoiceResultOK;
+}
+
+std::string Voice_Recorder::compress(const int16_t *samples, size_t count)
+{
+    std::string out;
+    int index = 0;
+    for (size_t i = 0; i < count; i += VOICE_FRAME_SAMPLES) {
+        uint16 n = (uint16)std::min<size_t>(VOICE_FRAME_SAMPLES, count - i);
+        encode_frame(out, samples + i, n, index);
+    }
+
+    return out;
+}
+
+EVoiceResult Voice_Recorder::decompress(const void *compressed, uint32 compressed_size, void *dest, uint32 dest_size, uint32 *written, uint32 sample_rate)
+{
+    if (written) *written = 0;
+    if (!compressed || !compressed_size) return k_EVoiceResultNoData;
+    if (sample_rate < 11025 || sample_rate > 48000) sample_rate = VOICE_CODEC_SAMPLE_RATE;
+
+    std::vector<int16_t> decoded;
+    decoded.reserve(compressed_size * 2);
+    const uint8_t *data = (const uint8_t *)compressed;
+    size_t offset = 0;
+    while (offset < compressed_size) {
+        size_t frame_size = decode_frame(data + offset, compressed_size - offset, decoded);
+        if (!frame_size) return k_EVoiceResultDataCorrupted;
+        offset += frame_size;
+    }
+
+    size_t out_count = sample_rate == VOICE_CODEC_SAMPLE_RATE
+        ? decoded.size()
+        : (size_t)((uint64)decoded.size() * sample_rate / VOICE_CODEC_SAMPLE_RATE);
+    uint32 needed = (uint32)(out_count * sizeof(int16_t));
+    if (written) *written = needed;
+    if (!dest || dest_size < needed) return k_EVoiceResultBufferTooSmall;
+
+    int16_t *out = (int16_t *)dest;
+    if (sample_rate == VOICE_CODEC_SAMPLE_RATE) {
+        memcpy(out, decoded.data(), needed);
+    } else {
+        const double ratio = (double)VOICE_CODEC_SAMPLE_RATE / (double)sample_rate;
+        for (size_t i = 0; i < out_count; ++i) {
+            double pos = i * ratio;
+            size_t idx = (size_t)pos;
+            if (idx + 1 >= decoded.size()) {
+                out[i] = decoded.back();
+            } else {
+                double frac = pos - (double)idx;
+                out[i] = (int16_t)(decoded[idx] + (decoded[idx + 1] - decoded[idx]) * frac);
+            }
+        }
+    }
+
+    return k_EVoiceResultOK;
+}
@@ -95,6 +95,186 @@ const char *get_steam_path()
     return steam_realpath;
 }
 
+// Case folded listing of a directory, so only the first lookup in it has to read it from disk
+struct Directory_Index {
+    struct timespec mtime;
+    // read in the same second the directory was last changed, a change in that second
+    // wouldn't show in the mtime on filesystems with coarse timestamps, so it's read again
+    bool racy;
+    // key: name with ascii lowercase letters, same folding as strcasecmp
+    std::unordered_map<std::string, std::vector<std::string>> names;
+};
+
+// key: absolute directory path, relative ones are resolved against the current directory
+static std::unordered_map<std::string, Directory_Index> *path_cache;
+static std::mutex path_cache_mutex;
+// the cache is dropped when a game touches more directories than this
+#define PATH_CACHE_MAX_DIRECTORIES 16384
+
+static std::string fold_case(const char *name, size_t length)
+{
+    std::string folded(name, length);
+    for (auto &c : folded) {
+        if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+    }
+    return folded;
+}
+
+// chdir isn't wrapped, so relative directories are keyed by where they point to now
+// returns an empty string if the current directory is unknown
+static std::string cache_key(const std::string &directory)
+{
+    if (directory.size() && directory[0] == PATH_SEPARATOR_CHAR) {
+        return directory;
+    }
+
+    char cwd[PATH_MAX];
+    if (!getcwd(cwd, sizeof(cwd))) {
+        return std::string();
+    }
+
+    std::string key(cwd);
+    if (key.back() != PATH_SEPARATOR_CHAR) {
+        key += PATH_SEPARATOR_CHAR;
+    }
+    if (directory != ".") {
+        key += directory;
+    } else if (key.size() > 1) {
+        key.pop_back();
+    }
+    return key;
+}
+
+static bool directory_mtime(const std::string &directory, struct timespec *mtime)
+{
+    struct stat64 directory_stat;
+    if (stat64(directory.c_str(), &directory_stat) || !S_ISDIR(directory_stat.st_mode)) {
+        return false;
+    }
+    *mtime = directory_stat.st_mtim;
+    return true;
+}
+
+// false if the directory can't be listed, like a directory without read permission
+static bool load_directory(const std::string &directory, const struct timespec &mtime, Directory_Index &index)
+{
+    index.names.clear();
+    DIR *current_directory = opendir(directory.c_str());
+    if (!current_directory) {
+        return false;
+    }
+
+    dirent64 *entry = (dirent64 *)readdir64(current_directory);
+    while (entry) {
+        index.names[fold_case(entry->d_name, strlen(entry->d_name))].emplace_back(entry->d_name);
+        entry = (dirent64 *)readdir64(current_directory);
+    }
+    closedir(current_directory);
+
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    index.mtime = mtime;
+    index.racy = now.tv_sec <= mtime.tv_sec;
+    return true;
+}
+
+// Entries of directory matching name in any case, the one with the exact case first
+static std::vector<std::string> find_in_directory(const std::string &directory, const char *name, size_t length)
+{
+    struct timespec mtime;
+    if (!directory_mtime(directory, &mtime)) {
+        return {};
+    }
+
+    std::string key = cache_key(directory);
+    std::lock_guard<std::mutex> lock(path_cache_mutex);
+    if (!path_cache) {
+        path_cache = new std::unordered_map<std::string, Directory_Index>();
+    }
+
+    Directory_Index uncached;
+    Directory_Index *index = &uncached;
+    auto cached = key.size() ? path_cache->find(key) : path_cache->end();
+    if (cached != path_cache->end()) {
+        index = &cached->second;
+        // the directory changed outside of the wrappers since it was read
+        if (index->racy || mtime.tv_sec != index->mtime.tv_sec || mtime.tv_nsec != index->mtime.tv_nsec) {
+            if (!load_directory(directory, mtime, *index)) {
+                path_cache->erase(cached);
+                index = nullptr;
+            }
+        }
+    } else if (load_directory(directory, mtime, uncached)) {
+        if (key.size()) {
+            if (path_cache->size() >= PATH_CACHE_MAX_DIRECTORIES) {
+                path_cache->clear();
+            }
+            index = &(*path_cache)[key];
+            *index = std::move(uncached);
+        }
+    } else {
+        index = nullptr;
+    }
+
+    if (!index) {
+        // not listable, only the exact name can be found like with access()
+        std::string path = directory + PATH_SEPARATOR_CHAR + std::string(name, length);
+        if (access(path.c_str(), F_OK)) {
+            return {};
+        }
+        return {std::string(name, length)};
+    }
+
+    auto entries = index->names.find(fold_case(name, length));
+    if (entries == index->names.end()) {
+        return {};
+    }
+
+    std::vector<std::string> result = entries->second;
+    for (size_t i = 1; i < result.size(); ++i) {
+        if (result[i].compare(0, std::string::npos, name, length) == 0) {
+            std::swap(result[0], result[i]);
+            break;
+        }
+    }
+    return result;
+}
+
+// Forgets the listings of the directory containing path and of path itself if it was a directory
+static void invalidate_path(const char *path)
+{
+    if (!path || !*path) {
+        return;
+    }
+
+    std::string changed(path);
+    while (changed.size() > 1 && changed.back() == PATH_SEPARATOR_CHAR) {
+        changed.pop_back();
+    }
+
+    size_t separator = changed.rfind(PATH_SEPARATOR_CHAR);
+    std::string parent = cache_key(separator == std::string::npos ? "." : (separator ? changed.substr(0, separator) : "/"));
+    changed = cache_key(changed);
+
+    std::lock_guard<std::mutex> lock(path_cache_mutex);
+    if (!path_cache) {
+        return;
+    }
+
+    path_cache->erase(parent);
+    if (changed.empty()) {
+        return;
+    }
+
+    for (auto it = path_cache->begin(); it != path_cache->end();) {
+        if (it->first.compare(0, changed.size(), changed) == 0 && (it->first.size() == changed.size() || it->first[changed.size()] == PATH_SEPARATOR_CHAR)) {
+            it = path_cache->erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 // Fixes given path by navigating filesystem and lowering case to match
 // existing entries on disk
 bool match_path(char *path, int start, bool accept_same_case)
@@ -103,6 +283,25 @@ bool match_path(char *path, int start, bool accept_same_case)
         return true;
     }
 
+    //        0123456789012345678901234567890123456789
+    // path = /this/is/a/sample/path/to/file.txt
+    //                  ^^     ^
+    //                  ab     c
+    // a. start = 10
+    // b. component = 11
+    // c. separator = 17
+    // directory = /this/is/a
+    int component = start + 1;
+    std::string directory;
+    if (start) {
+        directory.assign(path, start);
+    } else if (*path == PATH_SEPARATOR_CHAR) {
+        directory = "/";
+    } else {
+        component = start;
+        directory = ".";
+    }
+
     // Snap to the next separator in path
     int separator = start + 1;
     while (path[separator] != PATH_SEPARATOR_CHAR && path[separator]) {
@@ -110,79 +309,25 @@ bool match_path(char *path, int start, bool accept_same_case)
     }
 
     bool is_last_component = path[separator] != PATH_SEPARATOR_CHAR;
+    size_t length = separator - component;
 
-    char stored_char = path[separator];
-    path[separator] = 0;
-    bool path_accessible = access(path, F_OK) == 0;
-    path[separator] = stored_char;
-
-    if (!path_accessible || (!is_last_component && !match_path(path, separator, accept_same_case))) {
-        DIR *current_directory = nullptr;
-        int component = start + 1;
-
-        if (start) {
-            stored_char = path[start];
-            path[start] = 0;
-            current_directory = opendir(path);
-            path[start] = stored_char;
-            component = start + 1;
-        } else {
-            if (*path == PATH_SEPARATOR_CHAR) {
-                component = start + 1;
-                current_directory = opendir("/");
-            } else {
-                component = start;
-                current_directory = opendir(".");
-            }
-        }
-
-        //        0123456789012345678901234567890123456789
-        // path = /this/is/a/sample/path/to/file.txt
-        //                  ^^     ^
-        //                  ab     c
-        // a. start = 10
-        // b. component = 11
-        // c. separator = 17
-        // current_directory = /this/is/a/
-
-        if (current_directory) {
-            dirent64 *entry = (dirent64 *)readdir64(current_directory);
-            while (entry) {
-                const char *entry_name = entry->d_name;
-                stored_char = path[separator];
-                path[separator] = 0;
-
-                // Fix current component if entry with similar name exists
-                if (!strcasecmp(&path[component], entry_name)) {
-                    bool case_differs = strcmp(&path[component], entry_name) != 0;
-                    path[separator] = stored_char;
-                    if (case_differs) {
-                        char *iterator = &path[component];
-                        // Replace with entry name
-                        while (*entry_name != PATH_SEPARATOR_CHAR && *entry_name) {
-                            *(iterator++) = *(entry_name++);
-                        }
-                        // Fix next component
-                        if (is_last_component || match_path(path, separator, accept_same_case)) {
-                            closedir(current_directory);
-                            return true;
-                        }
-                    }
-                } else {
-                    path[separator] = stored_char;
-                }
-                entry = (dirent64 *)readdir64(current_directory);
-            }
-        }
+    // Empty component, like in a//b
+    if (!length) {
+        return is_last_component || match_path(path, separator, accept_same_case);
+    }
 
-        if (current_directory) {
-            closedir(current_directory);
+    std::string original(&path[component], length);
+    for (auto &entry_name : find_in_directory(directory, original.c_str(), length)) {
+        // Replace with entry name, ascii case folding keeps the length
+        memcpy(&path[component], entry_name.data(), length);
+        // Fix next component
+        if (is_last_component || match_path(path, separator, accept_same_case)) {
+            return true;
         }
-
-        return accept_same_case && is_last_component;
     }
 
-    return true;
+    memcpy(&path[component], original.data(), length);
+    return accept_same_case && is_last_component;
 }
 
 // Tries to convert the given path to the preferred lower-cased version
@@ -248,6 +393,9 @@ STEAMAPI_API FILE *__wrap_freopen(const char *path, const char *modes, FILE *str
     bool is_writable = strpbrk(modes, "wa+") != 0;
     const char *path_lowercased = lowercase_path(path, is_writable, true);
     FILE *result = freopen(path_lowercased, modes, stream);
+    if (result && is_writable) {
+        invalidate_path(path_lowercased);
+    }
     if (path_lowercased != path) {
         free((void *)path_lowercased);
     }
@@ -259,6 +407,9 @@ STEAMAPI_API FILE *__wrap_fopen(const char *path, const char *modes)
     bool is_writable = strpbrk(modes, "wa+") != 0;
     const char *path_lowercased = lowercase_path(path, is_writable, true);
     FILE *result = fopen(path_lowercased, modes);
+    if (result && is_writable) {
+        invalidate_path(path_lowercased);
+    }
     if (path_lowercased != path) {
         free((void *)path_lowercased);
     }
@@ -270,6 +421,9 @@ STEAMAPI_API FILE *__wrap_fopen64(const char *path, const char *modes)
     bool is_writable = strpbrk(modes, "wa+") != 0;
     const char *path_lowercased = lowercase_path(path, is_writable, true);
     FILE *result = fopen64(path_lowercased, modes);
+    if (result && is_writable) {
+        invalidate_path(path_lowercased);
+    }
     if (path_lowercased != path) {
         free((void *)path_lowercased);
     }
@@ -281,6 +435,9 @@ STEAMAPI_API int __wrap_open(const char *path, int flags, mode_t mode)
     bool is_writable = flags & (X_OK | W_OK);
     const char *path_lowercased = lowercase_path(path, is_writable, true);
     int result = open(path_lowercased, flags, mode);
+    if (result != -1 && (flags & O_CREAT)) {
+        invalidate_path(path_lowercased);
+    }
     if (path_lowercased != path) {
         free((void *)path_lowercased);
     }
@@ -292,6 +449,9 @@ STEAMAPI_API int __wrap_open64(const char *path, int flags, mode_t mode)
     bool is_writable = flags & (X_OK | W_OK);
     const char *path_lowercased = lowercase_path(path, is_writable, true);
     int result = open64(path_lowercased, flags, mode);
+    if (result != -1 && (flags & O_CREAT)) {
+        invalidate_path(path_lowercased);
+    }
     if (path_lowercased != path) {
         free((void *)path_lowercased);
     }
@@ -479,6 +639,9 @@ STEAMAPI_API int __wrap_symlink(const char *path1, const char *path2)
     const char *path_lowercased1 = lowercase_path(path1, true, true);
     const char *path_lowercased2 = lowercase_path(path2, false, false);
     int result = symlink(path_lowercased1, path_lowercased2);
+    if (!result) {
+        invalidate_path(path_lowercased2);
+    }
     if (path_lowercased1 != path1) {
         free((void *)path_lowercased1);
     }
@@ -493,6 +656,9 @@ STEAMAPI_API int __wrap_link(const char *path1, const char *path2)
     const char *path_lowercased1 = lowercase_path(path1, true, true);
     const char *path_lowercased2 = lowercase_path(path2, false, false);
     int result = link(path_lowercased1, path_lowercased2);
+    if (!result) {
+        invalidate_path(path_lowercased2);
+    }
     if (path_lowercased1 != path1) {
         free((void *)path_lowercased1);
     }
@@ -506,6 +672,9 @@ STEAMAPI_API int __wrap_mknod(const char *path, mode_t mode, dev_t dev)
 {
     const char *path_lowercased = lowercase_path(path, true, true);
     int result = mknod(path_lowercased, mode, dev);
+    if (!result) {
+        invalidate_path(path_lowercased);
+    }
     if (path_lowercased != path) {
         free((void *)path_lowercased);
     }
@@ -530,6 +699,9 @@ STEAMAPI_API int __wrap_unlink(const char *path)
 {
     const char *path_lowercased = lowercase_path(path, false, false);
     int result = unlink(path);
+    if (!result) {
+        invalidate_path(path);
+    }
     if (path_lowercased != path) {
         free((void *)path_lowercased);
     }
@@ -540,6 +712,9 @@ STEAMAPI_API int __wrap_mkfifo(const char *path, mode_t mode)
 {
     const char *path_lowercased = lowercase_path(path, true, true);
     int result = mkfifo(path, mode);
+    if (!result) {
+        invalidate_path(path);
+    }
     if (path_lowercased != path) {
         free((void *)path_lowercased);
     }
@@ -551,6 +726,10 @@ STEAMAPI_API int __wrap_rename(const char *old_name, const char *new_name)
     const char *old_name_lowercased = lowercase_path(old_name, true, true);
     const char *new_name_lowercased = lowercase_path(new_name, false, false);
     int result = rename(old_name_lowercased, new_name_lowercased);
+    if (!result) {
+        invalidate_path(old_name_lowercased);
+        invalidate_path(new_name_lowercased);
+    }
     if (old_name_lowercased != old_name) {
         free((void *)old_name_lowercased);
     }
@@ -584,6 +763,9 @@ STEAMAPI_API int __wrap_mkdir(const char *path, mode_t mode)
 {
     const char *path_lowercased = lowercase_path(path, true, true);
     int result = mkdir(path_lowercased, mode);
+    if (!result) {
+        invalidate_path(path_lowercased);
+    }
     if (path_lowercased != path) {
         free((void *)path_lowercased);
     }
@@ -594,6 +776,9 @@ STEAMAPI_API int __wrap_rmdir(const char *path)
 {
     const char *path_lowercased = lowercase_path(path, false, false);
     int result = rmdir(path_lowercased);
+    if (!result) {
+        invalidate_path(path_lowercased);
+    }
     if (path_lowercased != path) {
         free((void *)path_lowercased);
     }
@@ -0,0 +1,1111 @@
+/* Copyright (C) 2019 Mr Goldberg
+   This file is part of the Goldberg Emulator
+
+   The Goldberg Emulator is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   The Goldberg Emulator is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the Goldberg Emulator; if not, see
+   <http://www.gnu.org/licenses/>.  */
+
+/*
+  microbenchmarks of the emu hot paths, the dll sources are linked in and driven in-process
+  every result is one json object per line on stdout so runs can be compared across releases
+*/
+
+#include "dll/dll.h"
+#include "dll/source_query.h"
+#include "dll/http_cache.h"
+#include "dll/ugc_catalog.h"
+#include "dll/settings_parser.h"
+
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <thread>
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <new>
+#include <random>
+#include <algorithm>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <fcntl.h>
+// the linux file wrappers with the case insensitive path lookup, see wrap.cpp
+extern "C" FILE *__wrap_fopen(const char *path, const char *modes);
+extern "C" int __wrap_open(const char *path, int flags, mode_t mode);
+#endif
+
+#define BENCHMARK_APPID 480
+// account ids of the simulated users, far away from the ones the emu generates
+#define BENCHMARK_ACCOUNT_ID 900000000u
+
+static std::atomic<uint64_t> allocation_count{0};
+
+void *operator new(size_t size)
+{
+    ++allocation_count;
+    void *p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void *operator new[](size_t size)
+{
+    ++allocation_count;
+    void *p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+struct Options {
+    unsigned peers = 8;
+    double seconds = 1.0;
+    uint16 port = DEFAULT_PORT;
+    std::vector<std::string> filters;
+    std::string output_file;
+    bool list = false;
+};
+
+static Options options;
+static std::ofstream output;
+static std::string temp_folder;
+
+static double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static uint64 now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static long long resident_memory_kb()
+{
+#if defined(__linux__)
+    long long pages = 0, resident = 0;
+    std::ifstream statm("/proc/self/statm");
+    if (statm >> pages >> resident) return resident * (sysconf(_SC_PAGESIZE) / 1024);
+#endif
+    return -1;
+}
+
+static void emit(nlohmann::json result)
+{
+    std::string line = result.dump();
+    std::cout << line << std::endl;
+    if (output.is_open()) output << line << std::endl;
+}
+
+struct Measurement {
+    uint64 iterations = 0;
+    double seconds = 0;
+    uint64 allocations = 0;
+
+    nlohmann::json json() const
+    {
+        nlohmann::json j;
+        j["iterations"] = iterations;
+        j["ns_per_op"] = iterations ? seconds * 1e9 / iterations : 0.0;
+        j["ops_per_sec"] = seconds > 0 ? iterations / seconds : 0.0;
+        j["allocs_per_op"] = iterations ? (double)allocations / iterations : 0.0;
+        return j;
+    }
+};
+
+// calls step() in growing batches until the time is up, so the clock isn't read after every call
+template<typename F>
+static Measurement measure(F &&step, double seconds = options.seconds)
+{
+    Measurement m;
+    uint64 allocations = allocation_count;
+    auto start = std::chrono::steady_clock::now();
+    uint64 batch = 1;
+    do {
+        for (uint64 i = 0; i < batch; ++i) step();
+        m.iterations += batch;
+        m.seconds = seconds_since(start);
+        if (batch < (1 << 16) && m.seconds < seconds / 16) batch *= 2;
+    } while (m.seconds < seconds);
+
+    m.allocations = allocation_count - allocations;
+    return m;
+}
+
+static nlohmann::json percentiles(std::vector<double> samples, const char *unit)
+{
+    nlohmann::json j = nlohmann::json::object();
+    if (samples.empty()) return j;
+
+    std::sort(samples.begin(), samples.end());
+    auto at = [&samples](double p) { return samples[std::min(samples.size() - 1, (size_t)(p * samples.size()))]; };
+    j[std::string("p50_") + unit] = at(0.50);
+    j[std::string("p90_") + unit] = at(0.90);
+    j[std::string("p99_") + unit] = at(0.99);
+    j[std::string("max_") + unit] = samples.back();
+    return j;
+}
+
+static nlohmann::json result(const char *name, const Measurement &m, nlohmann::json extra = nlohmann::json::object())
+{
+    nlohmann::json j;
+    j["benchmark"] = name;
+    j.update(m.json());
+    j.update(extra);
+    return j;
+}
+
+static CSteamID user_id(unsigned index)
+{
+    return CSteamID(BENCHMARK_ACCOUNT_ID + index, k_EUniversePublic, k_EAccountTypeIndividual);
+}
+
+static CSteamID server_id(unsigned index)
+{
+    return CSteamID(BENCHMARK_ACCOUNT_ID + index, k_EUniversePublic, k_EAccountTypeGameServer);
+}
+
+static void run_callbacks(SteamCallResults &results, SteamCallBacks &callbacks, RunEveryRunCB &run_every_runcb)
+{
+    std::lock_guard<std::recursive_mutex> lock(global_mutex);
+    run_every_runcb.run();
+    results.runCallResults();
+    callbacks.runCallBacks();
+}
+
+// one simulated user with its own networking, like a separate game on the lan
+struct Peer {
+    unsigned index;
+    Settings settings;
+    SteamCallResults callback_results;
+    SteamCallBacks callbacks;
+    RunEveryRunCB run_every_runcb;
+    std::set<IP_PORT> broadcasts;
+    Networking network;
+    std::set<uint64> connected;
+
+    static void user_status(void *object, Common_Message *msg)
+    {
+        Peer *peer = (Peer *)object;
+        if (msg->low_level().type() == Low_Level::CONNECT) peer->connected.insert(msg->source_id());
+        if (msg->low_level().type() == Low_Level::DISCONNECT) peer->connected.erase(msg->source_id());
+    }
+
+    static std::set<IP_PORT> loopback()
+    {
+        std::set<IP_PORT> broadcasts;
+        broadcasts.insert(IP_PORT{0x7F000001, 0});
+        return broadcasts;
+    }
+
+    Peer(unsigned index):
+        index(index),
+        settings(user_id(index), CGameID(BENCHMARK_APPID), "bench" + std::to_string(index), "english", false),
+        callbacks(&callback_results),
+        broadcasts(loopback()),
+        network(user_id(index), BENCHMARK_APPID, options.port, &broadcasts, 0, false)
+    {
+        network.setCallback(CALLBACK_ID_USER_STATUS, user_id(index), &Peer::user_status, this);
+    }
+
+    void run()
+    {
+        std::lock_guard<std::recursive_mutex> lock(global_mutex);
+        network.Run();
+        run_every_runcb.run();
+        callback_results.runCallResults();
+        callbacks.runCallBacks();
+    }
+};
+
+static std::vector<std::unique_ptr<Peer>> create_peers(unsigned count)
+{
+    std::vector<std::unique_ptr<Peer>> peers;
+    for (unsigned i = 0; i < count; ++i) peers.emplace_back(new Peer(i));
+    return peers;
+}
+
+static void run_peers(std::vector<std::unique_ptr<Peer>> &peers)
+{
+    for (auto &peer : peers) peer->run();
+}
+
+// seconds until every peer saw every other one, negative on timeout
+static double connect_peers(std::vector<std::unique_ptr<Peer>> &peers, double timeout = 30.0)
+{
+    auto start = std::chrono::steady_clock::now();
+    while (seconds_since(start) < timeout) {
+        run_peers(peers);
+        bool all = std::all_of(peers.begin(), peers.end(), [&peers](const std::unique_ptr<Peer> &p) { return p->connected.size() + 1 >= peers.size(); });
+        if (all) return seconds_since(start);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return -1.0;
+}
+
+static void bench_network_discovery()
+{
+    auto peers = create_peers(2);
+    double seconds = connect_peers(peers);
+    emit({{"benchmark", "network_discovery"}, {"peers", 2}, {"connected", seconds >= 0}, {"discovery_ms", seconds * 1000.0}});
+}
+
+static void bench_network_convergence()
+{
+    auto peers = create_peers(options.peers);
+    double seconds = connect_peers(peers, 60.0);
+    size_t least = peers.size();
+    for (auto &peer : peers) least = std::min(least, peer->connected.size());
+    emit({{"benchmark", "network_convergence"}, {"peers", options.peers}, {"connected", seconds >= 0}, {"convergence_ms", seconds * 1000.0}, {"least_known_peers", least}});
+}
+
+static void bench_network_run()
+{
+    auto peers = create_peers(options.peers);
+    connect_peers(peers);
+
+    // one Run of every peer per op, like a frame of each game
+    Measurement m = measure([&peers]() {
+        for (auto &peer : peers) {
+            std::lock_guard<std::recursive_mutex> lock(global_mutex);
+            peer->network.Run();
+        }
+    });
+
+    nlohmann::json extra = {{"peers", options.peers}, {"ns_per_peer_run", m.iterations ? m.seconds * 1e9 / m.iterations / peers.size() : 0.0}};
+    emit(result("network_run", m, extra));
+}
+
+static void bench_p2p_loopback()
+{
+    auto peers = create_peers(2);
+    connect_peers(peers);
+
+    Steam_Networking sender(&peers[0]->settings, &peers[0]->network, &peers[0]->callbacks, &peers[0]->run_every_runcb);
+    Steam_Networking receiver(&peers[1]->settings, &peers[1]->network, &peers[1]->callbacks, &peers[1]->run_every_runcb);
+    CSteamID to = user_id(1), from = user_id(0);
+    receiver.AcceptP2PSessionWithUser(from);
+    sender.AcceptP2PSessionWithUser(to);
+
+    std::vector<char> payload(1200, 'x');
+    std::vector<char> buffer(2048);
+    std::vector<double> latencies;
+    uint64 received = 0, sent = 0, send_allocations = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (seconds_since(start) < options.seconds) {
+        for (int i = 0; i < 32; ++i) {
+            uint64 time = now_ns();
+            memcpy(payload.data(), &time, sizeof(time));
+            uint64 allocations = allocation_count;
+            if (sender.SendP2PPacket(to, payload.data(), (uint32)payload.size(), k_EP2PSendReliable, 0)) ++sent;
+            send_allocations += allocation_count - allocations;
+        }
+
+        peers[0]->run();
+        peers[1]->run();
+
+        uint32 size = 0;
+        CSteamID remote;
+        while (receiver.ReadP2PPacket(buffer.data(), (uint32)buffer.size(), &size, &remote, 0)) {
+            uint64 time;
+            memcpy(&time, buffer.data(), sizeof(time));
+            latencies.push_back((now_ns() - time) / 1000.0);
+            ++received;
+        }
+    }
+
+    double seconds = seconds_since(start);
+    nlohmann::json j = {{"benchmark", "p2p_loopback"}, {"packet_bytes", payload.size()}, {"sent", sent}, {"received", received},
+                        {"packets_per_sec", received / seconds}, {"allocs_per_send", sent ? (double)send_allocations / sent : 0.0}};
+    j.update(percentiles(latencies, "us"));
+    emit(j);
+}
+
+// a listen server: the client and the game server share the networking of one process
+static void bench_p2p_host_player()
+{
+    Settings client_settings(user_id(0), CGameID(BENCHMARK_APPID), "host", "english", false);
+    Settings server_settings(server_id(0), CGameID(BENCHMARK_APPID), "server", "english", false);
+    SteamCallResults callback_results;
+    SteamCallBacks callbacks(&callback_results);
+    RunEveryRunCB run_every_runcb;
+    std::set<IP_PORT> broadcasts;
+    Networking network(server_id(0), BENCHMARK_APPID, options.port, &broadcasts, 0, false);
+    network.addListenId(user_id(0));
+
+    Steam_Networking client(&client_settings, &network, &callbacks, &run_every_runcb);
+    Steam_Networking server(&server_settings, &network, &callbacks, &run_every_runcb);
+    client.AcceptP2PSessionWithUser(server_id(0));
+    server.AcceptP2PSessionWithUser(user_id(0));
+
+    char payload[256] = {};
+    char buffer[256];
+    uint64 immediate = 0, sends = 0;
+    std::vector<double> latencies;
+    Measurement m = measure([&]() {
+        uint64 start = now_ns();
+        client.SendP2PPacket(server_id(0), payload, sizeof(payload), k_EP2PSendReliable, 0);
+        ++sends;
+
+        uint32 size = 0;
+        CSteamID remote;
+        if (server.ReadP2PPacket(buffer, sizeof(buffer), &size, &remote, 0)) {
+            ++immediate;
+        } else {
+            // only delivered by the next frame
+            std::lock_guard<std::recursive_mutex> lock(global_mutex);
+            network.Run();
+            run_every_runcb.run();
+            while (server.ReadP2PPacket(buffer, sizeof(buffer), &size, &remote, 0));
+        }
+
+        latencies.push_back((now_ns() - start) / 1000.0);
+    });
+
+    nlohmann::json extra = {{"delivered_before_run", sends ? (double)immediate / sends : 0.0}};
+    extra.update(percentiles(latencies, "us"));
+    emit(result("p2p_host_player", m, extra));
+}
+
+static void bench_sockets_poll_group()
+{
+    auto peers = create_peers(2);
+    connect_peers(peers);
+
+    Steam_Networking_Sockets client(&peers[0]->settings, &peers[0]->network, &peers[0]->callback_results, &peers[0]->callbacks, &peers[0]->run_every_runcb, NULL);
+    Steam_Networking_Sockets server(&peers[1]->settings, &peers[1]->network, &peers[1]->callback_results, &peers[1]->callbacks, &peers[1]->run_every_runcb, NULL);
+
+    server.CreateListenSocketP2P(0, 0, NULL);
+    SteamNetworkingIdentity identity;
+    identity.SetSteamID(user_id(1));
+    HSteamNetConnection connection = client.ConnectP2P(identity, 0, 0, NULL);
+    HSteamNetPollGroup poll_group = server.CreatePollGroup();
+
+    // accept it like a game would from the status changed callback
+    HSteamNetConnection accepted = k_HSteamNetConnection_Invalid;
+    auto start = std::chrono::steady_clock::now();
+    while (seconds_since(start) < 10.0) {
+        run_peers(peers);
+        if (accepted == k_HSteamNetConnection_Invalid) {
+            for (auto &socket : server.get_shared_between_client_server()->connect_sockets) {
+                if (socket.second.status == CONNECT_SOCKET_NOT_ACCEPTED) {
+                    accepted = socket.first;
+                    server.AcceptConnection(accepted);
+                    server.SetConnectionPollGroup(accepted, poll_group);
+                }
+            }
+        }
+
+        SteamNetConnectionRealTimeStatus_t status;
+        if (accepted != k_HSteamNetConnection_Invalid && client.GetConnectionRealTimeStatus(connection, &status, 0, NULL) == k_EResultOK && status.m_eState == k_ESteamNetworkingConnectionState_Connected) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    if (accepted == k_HSteamNetConnection_Invalid) {
+        emit({{"benchmark", "sockets_poll_group"}, {"connected", false}});
+        return;
+    }
+
+    std::vector<char> payload(512, 'x');
+    SteamNetworkingMessage_t *messages[64];
+    uint64 received = 0, receive_calls = 0;
+    double receive_seconds = 0;
+    start = std::chrono::steady_clock::now();
+    while (seconds_since(start) < options.seconds) {
+        for (int i = 0; i < 64; ++i) client.SendMessageToConnection(connection, payload.data(), (uint32)payload.size(), k_nSteamNetworkingSend_Reliable, NULL);
+        run_peers(peers);
+
+        auto receive_start = std::chrono::steady_clock::now();
+        int count;
+        while ((count = server.ReceiveMessagesOnPollGroup(poll_group, messages, 64)) > 0) {
+            for (int i = 0; i < count; ++i) messages[i]->Release();
+            received += count;
+            ++receive_calls;
+        }
+
+        ++receive_calls;
+        receive_seconds += seconds_since(receive_start);
+    }
+
+    double seconds = seconds_since(start);
+    emit({{"benchmark", "sockets_poll_group"}, {"connected", true}, {"message_bytes", payload.size()}, {"received", received},
+          {"messages_per_sec", received / seconds}, {"ns_per_receive_call", receive_calls ? receive_seconds * 1e9 / receive_calls : 0.0}});
+}
+
+class Counting_Callback : public CCallbackBase {
+public:
+    uint64 count = 0;
+    Counting_Callback(int callback) { m_iCallback = callback; }
+    void Run(void *param) { ++count; }
+    void Run(void *param, bool io_failure, SteamAPICall_t call) { ++count; }
+    int GetCallbackSizeBytes() { return sizeof(PersonaStateChange_t); }
+};
+
+static void bench_call_results()
+{
+    SteamCallResults callback_results;
+    SteamCallBacks callbacks(&callback_results);
+    Counting_Callback listener(PersonaStateChange_t::k_iCallback);
+    callbacks.addCallBack(PersonaStateChange_t::k_iCallback, &listener);
+
+    // a frame with a handful of posted callbacks, the usual load of runCallResults
+    const int per_frame = 16;
+    PersonaStateChange_t data = {};
+    Measurement m = measure([&]() {
+        std::lock_guard<std::recursive_mutex> lock(global_mutex);
+        for (int i = 0; i < per_frame; ++i) {
+            data.m_ulSteamID = i;
+            callbacks.addCBResult(data.k_iCallback, &data, sizeof(data));
+        }
+
+        callback_results.runCallResults();
+        callbacks.runCallBacks();
+    });
+
+    emit(result("call_results", m, {{"callbacks_per_op", per_frame}, {"delivered", listener.count}}));
+}
+
+static void bench_user_stats()
+{
+    Settings settings(user_id(0), CGameID(BENCHMARK_APPID), "bench", "english", false);
+    for (int i = 0; i < 100; ++i) {
+        Stat_config config = {};
+        config.type = i % 2 ? STAT_TYPE_FLOAT : STAT_TYPE_INT;
+        settings.setStatDefiniton("stat_" + std::to_string(i), config);
+    }
+
+    Local_Storage local_storage(temp_folder + "stats" + PATH_SEPARATOR);
+    local_storage.setAppId(BENCHMARK_APPID);
+    SteamCallResults callback_results;
+    SteamCallBacks callbacks(&callback_results);
+    Steam_User_Stats stats(&settings, &local_storage, &callback_results, &callbacks, NULL);
+
+    std::vector<std::string> names;
+    for (int i = 0; i < 100; ++i) names.push_back("STAT_" + std::to_string(i));
+
+    unsigned i = 0;
+    Measurement get = measure([&]() {
+        const std::string &name = names[i++ % names.size()];
+        int32 value_int;
+        float value_float;
+        stats.GetStat(name.c_str(), &value_int) || stats.GetStat(name.c_str(), &value_float);
+    });
+    emit(result("user_stats_get", get, {{"stats", names.size()}}));
+
+    int32 counter = 0;
+    Measurement set = measure([&]() {
+        const std::string &name = names[counter % names.size()];
+        if ((counter % names.size()) % 2) stats.SetStat(name.c_str(), (float)counter); else stats.SetStat(name.c_str(), counter);
+        ++counter;
+    });
+    emit(result("user_stats_set", set, {{"stats", names.size()}}));
+}
+
+static void bench_lobby_search()
+{
+    Settings settings(user_id(0), CGameID(BENCHMARK_APPID), "bench", "english", false);
+    SteamCallResults callback_results;
+    SteamCallBacks callbacks(&callback_results);
+    RunEveryRunCB run_every_runcb;
+    std::set<IP_PORT> broadcasts;
+    Networking network(user_id(0), BENCHMARK_APPID, options.port, &broadcasts, 0, true);
+    Steam_Matchmaking matchmaking(&settings, &network, &callback_results, &callbacks, &run_every_runcb);
+
+    // lobbies of other players, as if they were received from the network
+    const unsigned lobby_count = 10000;
+    for (unsigned i = 0; i < lobby_count; ++i) {
+        Common_Message msg;
+        msg.set_source_id(user_id(1 + i % 64).ConvertToUint64());
+        Lobby *lobby = msg.mutable_lobby();
+        lobby->set_room_id(CSteamID(1000 + i, k_EUniversePublic, k_EAccountTypeChat).ConvertToUint64());
+        lobby->set_owner(msg.source_id());
+        lobby->set_appid(BENCHMARK_APPID);
+        lobby->set_type(k_ELobbyTypePublic);
+        lobby->set_joinable(true);
+        lobby->set_member_limit(8);
+        (*lobby->mutable_values())["mode"] = i % 4 ? "coop" : "versus";
+        (*lobby->mutable_values())["map"] = "map_" + std::to_string(i % 37);
+        (*lobby->mutable_values())["level"] = std::to_string(i % 100);
+        Lobby::Member *member = lobby->add_members();
+        member->set_id(msg.source_id());
+        Steam_Matchmaking::steam_matchmaking_callback(&matchmaking, &msg);
+    }
+
+    Measurement m = measure([&]() {
+        matchmaking.AddRequestLobbyListStringFilter("mode", "versus", k_ELobbyComparisonEqual);
+        matchmaking.AddRequestLobbyListNumericalFilter("level", 50, k_ELobbyComparisonEqualToOrGreaterThan);
+        matchmaking.AddRequestLobbyListNearValueFilter("level", 75);
+        matchmaking.AddRequestLobbyListResultCountFilter(50);
+        matchmaking.RequestLobbyList();
+        std::lock_guard<std::recursive_mutex> lock(global_mutex);
+        matchmaking.RunCallbacks();
+    });
+
+    emit(result("lobby_search", m, {{"lobbies", lobby_count}, {"found", matchmaking.GetLobbyByIndex(0).IsValid()}}));
+}
+
+static uint64 lobby_bytes = 0, lobby_messages = 0;
+
+static void count_lobby_bytes(void *object, Common_Message *msg)
+{
+    lobby_bytes += msg->ByteSizeLong();
+    ++lobby_messages;
+}
+
+static void bench_lobby_data(unsigned member_count)
+{
+    auto peers = create_peers(member_count);
+    connect_peers(peers, 60.0);
+
+    std::vector<std::unique_ptr<Steam_Matchmaking>> matchmakings;
+    for (auto &peer : peers) matchmakings.emplace_back(new Steam_Matchmaking(&peer->settings, &peer->network, &peer->callback_results, &peer->callbacks, &peer->run_every_runcb));
+    Steam_Matchmaking &owner = *matchmakings[0];
+
+    SteamAPICall_t create = owner.CreateLobby(k_ELobbyTypePublic, member_count);
+    LobbyCreated_t created = {};
+    auto start = std::chrono::steady_clock::now();
+    while (seconds_since(start) < 5.0 && !peers[0]->callback_results.callback_result(create, &created, sizeof(created))) {
+        std::lock_guard<std::recursive_mutex> lock(global_mutex);
+        owner.RunCallbacks();
+    }
+
+    // the members have to know the lobby before they can ask the owner to join
+    CSteamID lobby_id((uint64)created.m_ulSteamIDLobby);
+    std::vector<bool> joined(member_count, false);
+    joined[0] = true;
+    start = std::chrono::steady_clock::now();
+    while (seconds_since(start) < 30.0 && owner.GetNumLobbyMembers(lobby_id) < (int)member_count) {
+        for (unsigned i = 1; i < member_count; ++i) {
+            if (joined[i]) continue;
+            if (matchmakings[i]->GetLobbyByIndex(0) == lobby_id) {
+                matchmakings[i]->JoinLobby(lobby_id);
+                joined[i] = true;
+            } else {
+                matchmakings[i]->RequestLobbyList();
+            }
+        }
+
+        run_peers(peers);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    int members = owner.GetNumLobbyMembers(lobby_id);
+    for (unsigned i = 1; i < member_count; ++i) peers[i]->network.setCallback(CALLBACK_ID_LOBBY, user_id(i), &count_lobby_bytes, NULL);
+    lobby_bytes = lobby_messages = 0;
+
+    // a game updating one key per frame, the other keys don't change
+    for (int i = 0; i < 16; ++i) owner.SetLobbyData(lobby_id, ("static_" + std::to_string(i)).c_str(), "some value that stays the same");
+    run_peers(peers);
+    lobby_bytes = lobby_messages = 0;
+
+    uint64 updates = 0;
+    start = std::chrono::steady_clock::now();
+    while (seconds_since(start) < options.seconds) {
+        owner.SetLobbyData(lobby_id, "tick", std::to_string(updates++).c_str());
+        run_peers(peers);
+    }
+
+    // let the last changes arrive
+    for (int i = 0; i < 50; ++i) {
+        run_peers(peers);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // received by all the other members together, what the owner puts on the wire
+    emit({{"benchmark", "lobby_data"}, {"members", members}, {"updates", updates}, {"lobby_messages", lobby_messages},
+          {"bytes_per_update", updates ? (double)lobby_bytes / updates : 0.0},
+          {"bytes_per_member_update", updates && members > 1 ? (double)lobby_bytes / updates / (members - 1) : 0.0}});
+}
+
+static void bench_lobby_data()
+{
+    for (unsigned member_count : {4, 16, 64}) bench_lobby_data(member_count);
+}
+
+static bool client_started = false;
+
+static void bench_client_startup()
+{
+    if (client_started) return;
+
+    long long memory_before = resident_memory_kb();
+    auto start = std::chrono::steady_clock::now();
+    get_steam_client();
+    double startup_ms = seconds_since(start) * 1000.0;
+    long long memory_after = resident_memory_kb();
+    client_started = true;
+
+    emit({{"benchmark", "client_startup"}, {"startup_ms", startup_ms}, {"resident_kb_before", memory_before}, {"resident_kb_after", memory_after},
+          {"resident_kb_added", memory_before >= 0 ? memory_after - memory_before : -1}});
+}
+
+static void bench_source_query()
+{
+    Gameserver server;
+    server.set_server_name("benchmark server");
+    server.set_map_name("map_01");
+    server.set_mod_dir("mod");
+    server.set_product("product");
+    server.set_appid(BENCHMARK_APPID);
+    server.set_max_player_count(32);
+    server.set_port(27015);
+    for (int i = 0; i < 64; ++i) (*server.mutable_values())["rule_" + std::to_string(i)] = "value_" + std::to_string(i);
+
+    // the info and player replies list the players of the game server of the client
+    bench_client_startup();
+
+    const char info[] = "\xFF\xFF\xFF\xFFTSource Engine Query";
+    std::vector<char> rules = {'\xFF', '\xFF', '\xFF', '\xFF', 'V', '\x33', '\x22', '\x11', '\x00'};
+    size_t bytes = 0;
+    Measurement m_info = measure([&]() { bytes = Source_Query::handle_source_query(info, sizeof(info), server).size(); });
+    emit(result("source_query_info", m_info, {{"reply_bytes", bytes}}));
+
+    Measurement m_rules = measure([&]() { bytes = Source_Query::handle_source_query(rules.data(), rules.size(), server).size(); });
+    emit(result("source_query_rules", m_rules, {{"rules", server.values().size()}, {"reply_bytes", bytes}}));
+}
+
+static void bench_local_storage()
+{
+    Local_Storage local_storage(temp_folder + "storage" + PATH_SEPARATOR);
+    local_storage.setAppId(BENCHMARK_APPID);
+    std::vector<char> data(1024, 'x');
+    std::vector<char> buffer(data.size());
+
+    unsigned i = 0;
+    Measurement store = measure([&]() {
+        local_storage.store_data(Local_Storage::remote_storage_folder, "file_" + std::to_string(i++ % 256), data.data(), (unsigned)data.size());
+    });
+    emit(result("local_storage_store", store, {{"file_bytes", data.size()}}));
+
+    Measurement get = measure([&]() {
+        local_storage.get_data(Local_Storage::remote_storage_folder, "file_" + std::to_string(i++ % 256), buffer.data(), (unsigned)buffer.size());
+    });
+    emit(result("local_storage_get", get, {{"file_bytes", data.size()}}));
+
+    Measurement exists = measure([&]() { local_storage.file_exists(Local_Storage::remote_storage_folder, "file_" + std::to_string(i++ % 512)); });
+    emit(result("local_storage_exists", exists));
+}
+
+static void bench_voice()
+{
+    // a second of a tone with some noise, voice isn't silence
+    std::vector<int16_t> samples(VOICE_CODEC_SAMPLE_RATE);
+    for (size_t i = 0; i < samples.size(); ++i) samples[i] = (int16_t)(8000.0 * std::sin(i * 0.05) + (rand() % 512) - 256);
+
+    std::string compressed;
+    Measurement encode = measure([&]() { compressed = Voice_Recorder::compress(samples.data(), samples.size()); });
+    emit(result("voice_encode", encode, {{"audio_seconds_per_op", 1.0}, {"compressed_bytes", compressed.size()}}));
+
+    std::vector<char> decoded(48000 * 2 * 2);
+    uint32 written = 0;
+    Measurement decode = measure([&]() { Voice_Recorder::decompress(compressed.data(), (uint32)compressed.size(), decoded.data(), (uint32)decoded.size(), &written, 48000); });
+    emit(result("voice_decode", decode, {{"audio_seconds_per_op", 1.0}, {"sample_rate", 48000}, {"decoded_bytes", written}}));
+}
+
+static void bench_dlc_lookup()
+{
+    Settings settings(user_id(0), CGameID(BENCHMARK_APPID), "bench", "english", false);
+    const unsigned dlc_count = 5000;
+    for (unsigned i = 0; i < dlc_count; ++i) settings.addDLC(100000 + i * 10, "DLC " + std::to_string(i), i % 3 != 0);
+
+    unsigned i = 0;
+    Measurement has = measure([&]() { settings.hasDLC(100000 + (i++ % (dlc_count * 2)) * 5); });
+    emit(result("dlc_has", has, {{"dlcs", dlc_count}}));
+
+    Measurement by_index = measure([&]() {
+        AppId_t appid;
+        bool available;
+        std::string name;
+        settings.getDLC(i++ % dlc_count, appid, available, name);
+    });
+    emit(result("dlc_by_index", by_index, {{"dlcs", dlc_count}}));
+
+    // the startup cost, DLC.txt parsed into the table shared by the client and the server
+    std::string dlc_path = temp_folder + "DLC.txt";
+    {
+        std::ofstream dlc_file(dlc_path);
+        dlc_file << "# generated by the benchmark\n";
+        for (unsigned d = 0; d < dlc_count; ++d) dlc_file << 100000 + d * 10 << "=DLC number " << d << "\n";
+    }
+
+    std::vector<double> times;
+    bool shared = true;
+    auto start = std::chrono::steady_clock::now();
+    while (times.empty() || seconds_since(start) < options.seconds) {
+        Settings client(user_id(0), CGameID(BENCHMARK_APPID), "bench", "english", false);
+        Settings server(user_id(1), CGameID(BENCHMARK_APPID), "bench", "english", false);
+        auto parse_start = std::chrono::steady_clock::now();
+        parse_dlc_file(dlc_path, &client, &server);
+        times.push_back(seconds_since(parse_start) * 1000.0);
+        shared = shared && client.getDLCTable() == server.getDLCTable() && client.DLCCount() == dlc_count;
+    }
+
+    nlohmann::json j = {{"benchmark", "dlc_parse"}, {"dlcs", dlc_count}, {"parses", times.size()}, {"shared_table", shared}};
+    j.update(percentiles(times, "ms"));
+    emit(j);
+}
+
+static void bench_ugc_query()
+{
+    std::vector<Mod_entry> mods;
+    const unsigned mod_count = 10000;
+    mods.reserve(mod_count);
+    const char *tags[] = {"Maps", "Weapons", "Characters", "Sounds", "Game Mode", "Textures", "Vehicles", "UI"};
+    for (unsigned i = 0; i < mod_count; ++i) {
+        Mod_entry mod = {};
+        mod.id = 1000000 + i;
+        mod.title = "Mod number " + std::to_string(i) + (i % 7 ? " desert" : " forest");
+        mod.description = "A description of mod " + std::to_string(i) + " with a few words to index";
+        mod.tags = std::string(tags[i % 8]) + "," + tags[(i / 8) % 8];
+        mod.timeCreated = 1600000000 + i;
+        mod.timeUpdated = 1700000000 - i;
+        mod.votesUp = (i * 7919) % 1000;
+        mods.push_back(mod);
+    }
+
+    Ugc_Catalog catalog;
+    auto start = std::chrono::steady_clock::now();
+    catalog.build(mods);
+    double build_ms = seconds_since(start) * 1000.0;
+
+    Ugc_Catalog::Filter filter;
+    filter.required_tags = {"Maps"};
+    filter.search_text = "forest";
+    size_t found = 0;
+    Measurement m = measure([&]() { found = catalog.query(filter, Ugc_Catalog::Sort::VOTES_DESC).size(); });
+    emit(result("ugc_query", m, {{"mods", mod_count}, {"found", found}, {"build_ms", build_ms}}));
+}
+
+static void bench_app_ticket()
+{
+    Settings settings(user_id(0), CGameID(BENCHMARK_APPID), "bench", "english", false);
+    for (unsigned i = 0; i < 100; ++i) settings.addDLC(100000 + i, "DLC " + std::to_string(i), true);
+
+    Local_Storage local_storage(temp_folder + "user" + PATH_SEPARATOR);
+    local_storage.setAppId(BENCHMARK_APPID);
+    SteamCallResults callback_results;
+    SteamCallBacks callbacks(&callback_results);
+    std::set<IP_PORT> broadcasts;
+    Networking network(user_id(0), BENCHMARK_APPID, options.port, &broadcasts, 0, true);
+    Steam_User user(&settings, &local_storage, &network, &callback_results, &callbacks);
+
+    char data[32] = {};
+    char ticket[2048];
+    uint32 size = 0;
+    Measurement m = measure([&]() {
+        std::lock_guard<std::recursive_mutex> lock(global_mutex);
+        user.RequestEncryptedAppTicket(data, sizeof(data));
+        user.GetEncryptedAppTicket(ticket, sizeof(ticket), &size);
+        callback_results.runCallResults();
+    });
+
+    emit(result("app_ticket", m, {{"ticket_bytes", size}}));
+}
+
+static void bench_interface_lookup()
+{
+    bench_client_startup();
+    Steam_Client *client = get_steam_client();
+    HSteamPipe pipe = client->CreateSteamPipe();
+    HSteamUser user = client->ConnectToGlobalUser(pipe);
+
+    const char *versions[] = {STEAMUSER_INTERFACE_VERSION, STEAMFRIENDS_INTERFACE_VERSION, STEAMUTILS_INTERFACE_VERSION, STEAMMATCHMAKING_INTERFACE_VERSION,
+                              STEAMUSERSTATS_INTERFACE_VERSION, STEAMAPPS_INTERFACE_VERSION, STEAMNETWORKING_INTERFACE_VERSION, STEAMREMOTESTORAGE_INTERFACE_VERSION,
+                              STEAMUGC_INTERFACE_VERSION, STEAMINVENTORY_INTERFACE_VERSION, STEAMNETWORKINGSOCKETS_INTERFACE_VERSION, STEAMINPUT_INTERFACE_VERSION};
+    const unsigned count = sizeof(versions) / sizeof(*versions);
+
+    unsigned i = 0, found = 0;
+    Measurement m = measure([&]() { found += !!client->GetISteamGenericInterface(user, pipe, versions[i++ % count]); });
+    emit(result("interface_lookup", m, {{"versions", count}, {"found_ratio", m.iterations ? (double)found / m.iterations : 0.0}}));
+}
+
+static void bench_http_cache()
+{
+    // its own folder, the steam_settings next to the benchmark is left alone
+    std::string folder = temp_folder + "http" + PATH_SEPARATOR;
+    Http_Cache cache(folder);
+    const unsigned body_sizes[] = {1024, 8 * 1024 * 1024};
+    for (unsigned body_size : body_sizes) {
+        std::string name = "body_" + std::to_string(body_size) + ".bin";
+        std::string body(body_size, 'x');
+        if (Local_Storage::store_file_data(folder, name, (char *)body.data(), body_size) != (int)body_size) {
+            emit({{"benchmark", "http_cache"}, {"error", "could not write " + name}});
+            continue;
+        }
+
+        size_t size = 0;
+        Measurement m = measure([&]() {
+            Http_Cache::Response response = cache.fetch("http://localhost/" + name, name, false);
+            size = response.body ? response.body->size() : 0;
+        });
+        emit(result("http_cache", m, {{"body_bytes", size}}));
+    }
+}
+
+static void bench_controller()
+{
+    Settings settings(user_id(0), CGameID(BENCHMARK_APPID), "bench", "english", false);
+    const char *buttons[] = {"A", "B", "X", "Y", "LSHOULDER", "RSHOULDER", "START", "BACK", "DUP", "DDOWN", "DLEFT", "DRIGHT"};
+    std::map<std::string, std::pair<std::set<std::string>, std::string>> actions;
+    for (unsigned i = 0; i < sizeof(buttons) / sizeof(*buttons); ++i) actions["action_" + std::to_string(i)] = {{buttons[i]}, ""};
+    actions["move"] = {{"LJOY"}, "joystick_move"};
+    actions["look"] = {{"RJOY"}, "joystick_move"};
+    actions["throttle"] = {{"RTRIGGER"}, "trigger"};
+    settings.controller_settings.action_sets["ingame"] = actions;
+
+    SteamCallResults callback_results;
+    SteamCallBacks callbacks(&callback_results);
+    RunEveryRunCB run_every_runcb;
+    Steam_Controller controller(&settings, &callback_results, &callbacks, &run_every_runcb);
+    controller.Init(true);
+
+    std::vector<ControllerDigitalActionHandle_t> digital;
+    for (unsigned i = 0; i < sizeof(buttons) / sizeof(*buttons); ++i) digital.push_back(controller.GetDigitalActionHandle(("action_" + std::to_string(i)).c_str()));
+    std::vector<ControllerAnalogActionHandle_t> analog = {controller.GetAnalogActionHandle("move"), controller.GetAnalogActionHandle("look"), controller.GetAnalogActionHandle("throttle")};
+
+    // a frame of a game reading every action of the first controller
+    Measurement m = measure([&]() {
+        controller.RunFrame();
+        for (auto handle : digital) controller.GetDigitalActionData(1, handle);
+        for (auto handle : analog) controller.GetAnalogActionData(1, handle);
+    });
+
+    controller.Shutdown();
+    emit(result("controller_frame", m, {{"digital_actions", digital.size()}, {"analog_actions", analog.size()}}));
+}
+
+static void bench_path_case()
+{
+#if defined(__linux__)
+    const unsigned folder_count = 50, files_per_folder = 1000;
+    std::string root = temp_folder + "Game_Data" + PATH_SEPARATOR;
+    for (unsigned f = 0; f < folder_count; ++f) {
+        std::string folder = root + "Sub_Folder_" + std::to_string(f) + PATH_SEPARATOR;
+        std::filesystem::create_directories(std::filesystem::u8path(folder));
+        for (unsigned i = 0; i < files_per_folder; ++i) std::ofstream(folder + "File_" + std::to_string(i) + ".dat") << i;
+    }
+
+    // the game asks for other cases than what is on disk, like on windows, every case is different
+    auto mixed_case = [](std::string name, unsigned seed) {
+        for (auto &c : name) {
+            if (isalpha((unsigned char)c)) c = (seed & 1) ? toupper(c) : tolower(c);
+            seed = seed * 1103515245 + 12345;
+            seed ^= seed >> 16;
+        }
+        return name;
+    };
+
+    std::vector<std::string> paths;
+    paths.reserve(folder_count * files_per_folder);
+    for (unsigned f = 0; f < folder_count; ++f) {
+        for (unsigned i = 0; i < files_per_folder; ++i) {
+            unsigned seed = f * files_per_folder + i;
+            paths.push_back(temp_folder + mixed_case("game_data/sub_folder_" + std::to_string(f) + "/file_" + std::to_string(i) + ".dat", seed));
+        }
+    }
+
+    // shuffled so the folders aren't read in order
+    std::mt19937 rng(1234);
+    std::shuffle(paths.begin(), paths.end(), rng);
+
+    unsigned i = 0, found = 0;
+    Measurement m = measure([&]() {
+        const char *path = paths[i % paths.size()].c_str();
+        if (i++ & 1) {
+            FILE *file = __wrap_fopen(path, "rb");
+            if (file) {
+                ++found;
+                fclose(file);
+            }
+        } else {
+            int fd = __wrap_open(path, O_RDONLY, 0);
+            if (fd != -1) {
+                ++found;
+                close(fd);
+            }
+        }
+    });
+
+    emit(result("path_case", m, {{"files", paths.size()}, {"found_ratio", m.iterations ? (double)found / m.iterations : 0.0}}));
+#endif
+}
+
+static void bench_screenshots()
+{
+    Settings settings(user_id(0), CGameID(BENCHMARK_APPID), "bench", "english", false);
+    Local_Storage local_storage(temp_folder + "screenshots" + PATH_SEPARATOR);
+    local_storage.setAppId(BENCHMARK_APPID);
+    SteamCallResults callback_results;
+    SteamCallBacks callbacks(&callback_results);
+    RunEveryRunCB run_every_runcb;
+
+    std::pair<int, int> sizes[] = {{1920, 1080}, {3840, 2160}};
+    for (auto &size : sizes) {
+        std::vector<uint8_t> rgb((size_t)size.first * size.second * 3);
+        for (size_t i = 0; i < rgb.size(); ++i) rgb[i] = (uint8_t)(i * 31);
+
+        Steam_Screenshots screenshots(&settings, &local_storage, &callbacks, &run_every_runcb);
+        // only the time the game thread is blocked, the encoding happens in the background
+        std::vector<double> times;
+        for (int i = 0; i < 8; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            screenshots.WriteScreenshot(rgb.data(), (uint32)rgb.size(), size.first, size.second);
+            times.push_back(seconds_since(start) * 1000.0);
+            run_callbacks(callback_results, callbacks, run_every_runcb);
+        }
+
+        nlohmann::json j = {{"benchmark", "screenshot_write"}, {"width", size.first}, {"height", size.second}, {"screenshots", times.size()}};
+        j.update(percentiles(times, "ms"));
+        emit(j);
+    }
+}
+
+static void bench_inventory()
+{
+    Settings settings(user_id(0), CGameID(BENCHMARK_APPID), "bench", "english", false);
+    Local_Storage local_storage(temp_folder + "inventory" + PATH_SEPARATOR);
+    local_storage.setAppId(BENCHMARK_APPID);
+
+    const unsigned item_count = 10000;
+    nlohmann::json items = nlohmann::json::object();
+    for (unsigned i = 1; i <= item_count; ++i) items[std::to_string(i)] = 1 + i % 5;
+    local_storage.write_json_file("", "items.json", items);
+
+    SteamCallResults callback_results;
+    SteamCallBacks callbacks(&callback_results);
+    RunEveryRunCB run_every_runcb;
+    Steam_Inventory inventory(&settings, &callback_results, &callbacks, &run_every_runcb, &local_storage);
+
+    SteamInventoryResult_t handle;
+    inventory.GetAllItems(&handle);
+    uint32 count = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (seconds_since(start) < 5.0 && inventory.GetResultStatus(handle) != k_EResultOK) {
+        run_callbacks(callback_results, callbacks, run_every_runcb);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    inventory.GetResultItems(handle, NULL, &count);
+    std::vector<SteamItemDetails_t> out(count);
+    Measurement m = measure([&]() {
+        uint32 size = count;
+        inventory.GetResultItems(handle, out.data(), &size);
+    });
+
+    emit(result("inventory_result_items", m, {{"items", count}}));
+}
+
+struct Benchmark {
+    const char *name;
+    const char *description;
+    void (*run)();
+};
+
+static const Benchmark benchmarks[] = {
+    {"network_discovery", "time until two instances on loopback find each other", bench_network_discovery},
+    {"network_convergence", "time until --peers instances all know each other", bench_network_convergence},
+    {"network_run", "Networking::Run of --peers connected instances", bench_network_run},
+    {"p2p_loopback", "SendP2PPacket/ReadP2PPacket throughput, latency and allocations between two instances", bench_p2p_loopback},
+    {"p2p_host_player", "P2P packets between the client and the game server of one process", bench_p2p_host_player},
+    {"sockets_poll_group", "NetworkingSockets messages received with ReceiveMessagesOnPollGroup", bench_sockets_poll_group},
+    {"call_results", "callbacks posted and delivered by SteamCallResults::runCallResults", bench_call_results},
+    {"user_stats", "GetStat/SetStat with 100 defined stats", bench_user_stats},
+    {"lobby_search", "RequestLobbyList with filters over 10000 lobbies", bench_lobby_search},
+    {"lobby_data", "bytes sent per SetLobbyData with 4, 16 and 64 members", bench_lobby_data},
+    {"local_storage", "Local_Storage store/get/exists of small files", bench_local_storage},
+    {"voice", "voice codec encode and decode of a second of audio", bench_voice},
+    {"dlc_lookup", "DLC.txt parse and lookups with 5000 DLCs", bench_dlc_lookup},
+    {"ugc_query", "UGC catalog query over 10000 mods", bench_ugc_query},
+    {"app_ticket", "RequestEncryptedAppTicket + GetEncryptedAppTicket", bench_app_ticket},
+    {"http_cache", "repeated offline fetches of a 1 KB and an 8 MB cached HTTP body", bench_http_cache},
+    {"controller", "a frame of controller action queries", bench_controller},
+    {"path_case", "open and fopen of 50000 mixed case paths through the linux file wrappers", bench_path_case},
+    {"screenshots", "game thread time of WriteScreenshot at 1080p and 4K", bench_screenshots},
+    {"inventory", "GetResultItems with 10000 items", bench_inventory},
+    // last, the client runs its own networking on the default port once it exists
+    {"client_startup", "Steam_Client creation time and memory", bench_client_startup},
+    {"interface_lookup", "GetISteamGenericInterface with the current interface versions", bench_interface_lookup},
+    {"source_query", "Source_Query::handle_source_query info and rules replies", bench_source_query},
+};
+
+static bool selected(const Benchmark &benchmark)
+{
+    if (options.filters.empty()) return true;
+    return std::any_of(options.filters.begin(), options.filters.end(), [&benchmark](const std::string &f) { return std::string(benchmark.name).find(f) != std::string::npos; });
+}
+
+static void usage()
+{
+    std::cerr << "usage: benchmark [--list] [--filter name[,name...]] [--peers N] [--time seconds] [--port port] [--output file.jsonl]" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--list") {
+            options.list = true;
+        } else if (arg == "--filter" && has_value) {
+            std::stringstream names(argv[++i]);
+            std::string name;
+            while (std::getline(names, name, ',')) if (name.size()) options.filters.push_back(name);
+        } else if (arg == "--peers" && has_value) {
+            options.peers = std::max(2, atoi(argv[++i]));
+        } else if (arg == "--time" && has_value) {
+            options.seconds = std::max(0.01, atof(argv[++i]));
+        } else if (arg == "--port" && has_value) {
+            options.port = (uint16)atoi(argv[++i]);
+        } else if (arg == "--output" && has_value) {
+            options.output_file = argv[++i];
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    if (options.list) {
+        for (auto &benchmark : benchmarks) std::cout << benchmark.name << "\t" << benchmark.description << std::endl;
+        return 0;
+    }
+
+    if (options.output_file.size()) {
+        output.open(std::filesystem::u8path(options.output_file), std::ios::app);
+        if (!output.is_open()) {
+            std::cerr << "could not open " << options.output_file << std::endl;
+            return 1;
+        }
+    }
+
+    temp_folder = (std::filesystem::temp_directory_path() / ("gse_benchmark_" + std::to_string(now_ns()))).u8string() + PATH_SEPARATOR;
+    std::filesystem::create_directories(std::filesystem::u8path(temp_folder));
+
+    for (auto &benchmark : benchmarks) {
+        if (!selected(benchmark)) continue;
+        std::cerr << "running " << benchmark.name << std::endl;
+        benchmark.run();
+    }
+
+    std::error_code ec;
+    std::filesystem::remove_all(std::filesystem::u8path(temp_folder), ec);
+    // the client's threads would keep the process alive
+    if (client_started) std::_Exit(0);
+    return 0;
+}
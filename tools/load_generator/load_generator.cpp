@@ -0,0 +1,582 @@
+/* Copyright (C) 2019 Mr Goldberg
+   This file is part of the Goldberg Emulator
+
+   The Goldberg Emulator is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   The Goldberg Emulator is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the Goldberg Emulator; if not, see
+   <http://www.gnu.org/licenses/>.  */
+
+/*
+  headless load generator, simulates many users of the emu in one process to load test a game host
+  every user has its own steam id and networking, joins a lobby and sends traffic to the other members
+*/
+
+#include "dll/steam_client.h"
+
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <string>
+#include <vector>
+#include <memory>
+#include <random>
+#include <iomanip>
+
+// first bytes of the traffic of this tool, lets the users of the same run measure the latency between them
+struct Load_Header {
+    uint64 run_token;
+    uint64 send_time_ns;
+    uint32 sender;
+    uint32 kind;
+};
+
+enum Traffic_Kind {
+    TRAFFIC_P2P,
+    TRAFFIC_SOCKETS,
+    TRAFFIC_MESSAGES,
+    TRAFFIC_KINDS
+};
+
+static const char *traffic_names[TRAFFIC_KINDS] = {"p2p", "sockets", "messages"};
+
+struct Options {
+    unsigned users = 4;
+    uint32 appid = 480;
+    uint16 port = DEFAULT_PORT;
+    std::set<IP_PORT> broadcasts;
+    uint64 lobby_id = 0;
+    bool create_lobby = true;
+    double search_seconds = 5.0;
+    double seconds = 60.0;
+    double report_seconds = 1.0;
+    double rates[TRAFFIC_KINDS] = {10.0, 10.0, 10.0};
+    unsigned size = 256;
+    bool reliable = false;
+    int virtual_port = 0;
+    double lobby_data_rate = 1.0;
+    bool json = false;
+};
+
+static Options options;
+static uint64 run_token;
+
+static uint64 now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct Traffic_Stats {
+    uint64 sent = 0;
+    uint64 send_failed = 0;
+    uint64 bytes_sent = 0;
+    uint64 received = 0;
+    uint64 bytes_received = 0;
+    // received from outside this run, like the host
+    uint64 foreign = 0;
+    std::vector<double> latencies_ms;
+
+    void add(const Traffic_Stats &other)
+    {
+        sent += other.sent;
+        send_failed += other.send_failed;
+        bytes_sent += other.bytes_sent;
+        received += other.received;
+        bytes_received += other.bytes_received;
+        foreign += other.foreign;
+        latencies_ms.insert(latencies_ms.end(), other.latencies_ms.begin(), other.latencies_ms.end());
+    }
+};
+
+struct Lobby_Stats {
+    uint64 lobby_data_set = 0;
+    uint64 member_data_set = 0;
+};
+
+class Sim_User {
+public:
+    unsigned index;
+    Settings settings;
+    SteamCallResults callback_results;
+    SteamCallBacks callbacks;
+    RunEveryRunCB run_every_runcb;
+    Networking network;
+    Steam_Matchmaking matchmaking;
+    Steam_Networking networking;
+    Steam_Networking_Sockets sockets;
+    Steam_Networking_Messages messages;
+
+    CSteamID lobby;
+    SteamAPICall_t lobby_call = k_uAPICallInvalid;
+    bool lobby_failed = false;
+    std::chrono::steady_clock::time_point search_start;
+
+    HSteamListenSocket listen_socket = k_HSteamListenSocket_Invalid;
+    HSteamNetPollGroup poll_group = k_HSteamNetPollGroup_Invalid;
+    std::map<uint64, HSteamNetConnection> outgoing;
+    std::set<uint64> accepted_p2p;
+    std::vector<CSteamID> targets;
+
+    double budget[TRAFFIC_KINDS] = {};
+    unsigned next_target[TRAFFIC_KINDS] = {};
+    double lobby_data_budget = 0;
+    uint64 lobby_data_counter = 0;
+
+    Sim_User(unsigned index, CSteamID id):
+        index(index),
+        settings(id, CGameID(options.appid), "load_user_" + std::to_string(index), "english", false),
+        callbacks(&callback_results),
+        network(id, options.appid, options.port, &options.broadcasts, 0, false),
+        matchmaking(&settings, &network, &callback_results, &callbacks, &run_every_runcb),
+        networking(&settings, &network, &callbacks, &run_every_runcb),
+        sockets(&settings, &network, &callback_results, &callbacks, &run_every_runcb, NULL),
+        messages(&settings, &network, &callback_results, &callbacks, &run_every_runcb)
+    {
+        listen_socket = sockets.CreateListenSocketP2P(options.virtual_port, 0, NULL);
+        poll_group = sockets.CreatePollGroup();
+        search_start = std::chrono::steady_clock::now();
+    }
+
+    void run()
+    {
+        std::lock_guard<std::recursive_mutex> lock(global_mutex);
+        network.Run();
+        run_every_runcb.run();
+        callback_results.runCallResults();
+        callbacks.runCallBacks();
+    }
+
+    bool in_lobby() const
+    {
+        return lobby.IsValid() && lobby_call == k_uAPICallInvalid;
+    }
+
+    void join(CSteamID id)
+    {
+        lobby = id;
+        lobby_call = matchmaking.JoinLobby(id);
+    }
+
+    void create()
+    {
+        lobby_call = matchmaking.CreateLobby(k_ELobbyTypePublic, std::max(options.users + 1, 2u));
+    }
+
+    // finishes the pending create/join, returns true once this user is in the lobby
+    bool update_lobby()
+    {
+        if (lobby_call == k_uAPICallInvalid) return lobby.IsValid();
+
+        LobbyCreated_t created = {};
+        LobbyEnter_t entered = {};
+        if (!lobby.IsValid()) {
+            if (callback_results.callback_result(lobby_call, &created, sizeof(created))) {
+                lobby_call = k_uAPICallInvalid;
+                lobby = CSteamID((uint64)created.m_ulSteamIDLobby);
+                lobby_failed = created.m_eResult != k_EResultOK;
+            }
+        } else if (callback_results.callback_result(lobby_call, &entered, sizeof(entered))) {
+            lobby_call = k_uAPICallInvalid;
+            if (entered.m_EChatRoomEnterResponse != k_EChatRoomEnterResponseSuccess) {
+                lobby_failed = true;
+                lobby = k_steamIDNil;
+            }
+        }
+
+        return in_lobby();
+    }
+
+    void update_targets()
+    {
+        targets.clear();
+        int count = matchmaking.GetNumLobbyMembers(lobby);
+        for (int i = 0; i < count; ++i) {
+            CSteamID member = matchmaking.GetLobbyMemberByIndex(lobby, i);
+            if (member == settings.get_local_steam_id()) continue;
+            targets.push_back(member);
+
+            if (accepted_p2p.insert(member.ConvertToUint64()).second) networking.AcceptP2PSessionWithUser(member);
+            if (options.rates[TRAFFIC_SOCKETS] > 0 && !outgoing.count(member.ConvertToUint64())) {
+                SteamNetworkingIdentity identity;
+                identity.SetSteamID(member);
+                outgoing[member.ConvertToUint64()] = sockets.ConnectP2P(identity, options.virtual_port, 0, NULL);
+            }
+        }
+
+        // connections of the other members, accepted like a game would from the status changed callback
+        for (auto &socket : sockets.get_shared_between_client_server()->connect_sockets) {
+            if (socket.second.status == CONNECT_SOCKET_NOT_ACCEPTED && socket.second.listen_socket_id == listen_socket) {
+                sockets.AcceptConnection(socket.first);
+                sockets.SetConnectionPollGroup(socket.first, poll_group);
+            }
+        }
+    }
+
+    void send(Traffic_Kind kind, double elapsed, std::vector<char> &payload, Traffic_Stats &stats)
+    {
+        if (targets.empty()) return;
+
+        budget[kind] += elapsed * options.rates[kind];
+        while (budget[kind] >= 1.0) {
+            budget[kind] -= 1.0;
+            CSteamID target = targets[next_target[kind]++ % targets.size()];
+
+            Load_Header header = {run_token, now_ns(), index, (uint32)kind};
+            memcpy(payload.data(), &header, sizeof(header));
+
+            bool sent = false;
+            if (kind == TRAFFIC_P2P) {
+                sent = networking.SendP2PPacket(target, payload.data(), (uint32)payload.size(), options.reliable ? k_EP2PSendReliable : k_EP2PSendUnreliable, 0);
+            } else if (kind == TRAFFIC_SOCKETS) {
+                auto connection = outgoing.find(target.ConvertToUint64());
+                sent = connection != outgoing.end() &&
+                       sockets.SendMessageToConnection(connection->second, payload.data(), (uint32)payload.size(), options.reliable ? k_nSteamNetworkingSend_Reliable : k_nSteamNetworkingSend_Unreliable, NULL) == k_EResultOK;
+            } else if (kind == TRAFFIC_MESSAGES) {
+                SteamNetworkingIdentity identity;
+                identity.SetSteamID(target);
+                sent = messages.SendMessageToUser(identity, payload.data(), (uint32)payload.size(), options.reliable ? k_nSteamNetworkingSend_Reliable : k_nSteamNetworkingSend_Unreliable, 0) == k_EResultOK;
+            }
+
+            if (sent) {
+                ++stats.sent;
+                stats.bytes_sent += payload.size();
+            } else {
+                ++stats.send_failed;
+            }
+        }
+    }
+
+    void update_lobby_data(double elapsed, Lobby_Stats &stats)
+    {
+        lobby_data_budget += elapsed * options.lobby_data_rate;
+        while (lobby_data_budget >= 1.0) {
+            lobby_data_budget -= 1.0;
+            std::string value = std::to_string(++lobby_data_counter);
+            matchmaking.SetLobbyMemberData(lobby, "load_generator_tick", value.c_str());
+            ++stats.member_data_set;
+            // only the owner can change the lobby data
+            if (matchmaking.SetLobbyData(lobby, ("load_generator_user_" + std::to_string(index)).c_str(), value.c_str())) ++stats.lobby_data_set;
+        }
+    }
+
+    void receive(Traffic_Stats stats[TRAFFIC_KINDS])
+    {
+        std::vector<char> buffer(std::max(options.size, 2048u));
+        uint32 size = 0;
+        CSteamID remote;
+        while (networking.ReadP2PPacket(buffer.data(), (uint32)buffer.size(), &size, &remote, 0)) {
+            count(buffer.data(), size, stats[TRAFFIC_P2P]);
+        }
+
+        SteamNetworkingMessage_t *received[64];
+        int count_received;
+        while ((count_received = sockets.ReceiveMessagesOnPollGroup(poll_group, received, 64)) > 0) {
+            release(received, count_received, stats[TRAFFIC_SOCKETS]);
+        }
+
+        // replies of the host on the connections we made
+        for (auto &connection : outgoing) {
+            while ((count_received = sockets.ReceiveMessagesOnConnection(connection.second, received, 64)) > 0) {
+                release(received, count_received, stats[TRAFFIC_SOCKETS]);
+            }
+        }
+
+        while ((count_received = messages.ReceiveMessagesOnChannel(0, received, 64)) > 0) {
+            release(received, count_received, stats[TRAFFIC_MESSAGES]);
+        }
+    }
+
+private:
+    static void count(const void *data, uint32 size, Traffic_Stats &stats)
+    {
+        ++stats.received;
+        stats.bytes_received += size;
+
+        Load_Header header;
+        if (size < sizeof(header)) {
+            ++stats.foreign;
+            return;
+        }
+
+        memcpy(&header, data, sizeof(header));
+        if (header.run_token != run_token) {
+            ++stats.foreign;
+            return;
+        }
+
+        stats.latencies_ms.push_back((now_ns() - header.send_time_ns) / 1e6);
+    }
+
+    static void release(SteamNetworkingMessage_t **received, int count_received, Traffic_Stats &stats)
+    {
+        for (int i = 0; i < count_received; ++i) {
+            count(received[i]->m_pData, received[i]->m_cbSize, stats);
+            received[i]->Release();
+        }
+    }
+};
+
+static double percentile(std::vector<double> &sorted, double p)
+{
+    if (sorted.empty()) return 0;
+    return sorted[std::min(sorted.size() - 1, (size_t)(p * sorted.size()))];
+}
+
+static void report(const char *type, double seconds, unsigned in_lobby, Traffic_Stats stats[TRAFFIC_KINDS], const Lobby_Stats &lobby_stats)
+{
+    nlohmann::json j;
+    j["type"] = type;
+    j["seconds"] = seconds;
+    j["users_in_lobby"] = in_lobby;
+    j["lobby_data_set"] = lobby_stats.lobby_data_set;
+    j["member_data_set"] = lobby_stats.member_data_set;
+
+    if (!options.json) {
+        std::cout << "[" << type << "] " << std::fixed << std::setprecision(1) << seconds << "s, " << in_lobby << "/" << options.users << " users in the lobby, "
+                  << lobby_stats.member_data_set << " member data and " << lobby_stats.lobby_data_set << " lobby data updates" << std::endl;
+    }
+
+    for (int kind = 0; kind < TRAFFIC_KINDS; ++kind) {
+        Traffic_Stats &s = stats[kind];
+        std::sort(s.latencies_ms.begin(), s.latencies_ms.end());
+        double p50 = percentile(s.latencies_ms, 0.50), p90 = percentile(s.latencies_ms, 0.90), p99 = percentile(s.latencies_ms, 0.99);
+        double max = s.latencies_ms.empty() ? 0 : s.latencies_ms.back();
+
+        j[traffic_names[kind]] = {
+            {"sent", s.sent}, {"send_failed", s.send_failed}, {"received", s.received}, {"foreign", s.foreign},
+            {"sent_per_sec", s.sent / seconds}, {"received_per_sec", s.received / seconds},
+            {"bytes_sent_per_sec", s.bytes_sent / seconds}, {"bytes_received_per_sec", s.bytes_received / seconds},
+            {"p50_ms", p50}, {"p90_ms", p90}, {"p99_ms", p99}, {"max_ms", max},
+        };
+
+        if (!options.json) {
+            std::cout << "    " << std::left << std::setw(9) << traffic_names[kind] << std::right
+                      << "sent " << std::setw(9) << s.sent / seconds << "/s (" << s.send_failed << " failed)"
+                      << "  received " << std::setw(9) << s.received / seconds << "/s " << std::setw(9) << s.bytes_received / seconds / 1024.0 << " KiB/s"
+                      << "  latency ms p50 " << std::setprecision(2) << p50 << " p90 " << p90 << " p99 " << p99 << " max " << max << std::setprecision(1) << std::endl;
+        }
+    }
+
+    if (options.json) std::cout << j.dump() << std::endl;
+}
+
+static void usage()
+{
+    std::cerr << "usage: load_generator [options]" << std::endl
+              << "  --users N                 simulated users, default 4" << std::endl
+              << "  --appid A                 appid of the game, default 480" << std::endl
+              << "  --port P                  listen port of the first user, default " << DEFAULT_PORT << std::endl
+              << "  --broadcast IP            also announce the users to this ip, can be repeated" << std::endl
+              << "  --lobby ID                join this lobby instead of the first one found" << std::endl
+              << "  --no-create               don't create a lobby when none is found" << std::endl
+              << "  --search S                seconds to look for a lobby, default 5" << std::endl
+              << "  --time S                  seconds to run once the users joined, 0 runs forever, default 60" << std::endl
+              << "  --report S                seconds between reports, default 1" << std::endl
+              << "  --p2p-rate R              ISteamNetworking packets/sec per user, default 10" << std::endl
+              << "  --sockets-rate R          ISteamNetworkingSockets messages/sec per user, default 10" << std::endl
+              << "  --messages-rate R         ISteamNetworkingMessages messages/sec per user, default 10" << std::endl
+              << "  --lobby-data-rate R       lobby and member data updates/sec per user, default 1" << std::endl
+              << "  --size B                  bytes per packet/message, default 256" << std::endl
+              << "  --reliable                send reliable instead of unreliable" << std::endl
+              << "  --virtual-port V          virtual port of the sockets connections, default 0" << std::endl
+              << "  --json                    print the reports as json lines" << std::endl;
+}
+
+static bool parse_options(int argc, char **argv)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        bool used_value = true;
+
+        if (arg == "--no-create") {
+            options.create_lobby = false;
+            used_value = false;
+        } else if (arg == "--reliable") {
+            options.reliable = true;
+            used_value = false;
+        } else if (arg == "--json") {
+            options.json = true;
+            used_value = false;
+        } else if (!value) {
+            return false;
+        } else if (arg == "--users") {
+            options.users = std::max(1, atoi(value));
+        } else if (arg == "--appid") {
+            options.appid = (uint32)std::stoul(value);
+        } else if (arg == "--port") {
+            options.port = (uint16)atoi(value);
+        } else if (arg == "--broadcast") {
+            unsigned char ip[4];
+            if (sscanf(value, "%hhu.%hhu.%hhu.%hhu", &ip[0], &ip[1], &ip[2], &ip[3]) != 4) return false;
+            options.broadcasts.insert(IP_PORT{(uint32)ip[0] << 24 | (uint32)ip[1] << 16 | (uint32)ip[2] << 8 | ip[3], 0});
+        } else if (arg == "--lobby") {
+            options.lobby_id = std::stoull(value);
+        } else if (arg == "--search") {
+            options.search_seconds = atof(value);
+        } else if (arg == "--time") {
+            options.seconds = atof(value);
+        } else if (arg == "--report") {
+            options.report_seconds = std::max(0.1, atof(value));
+        } else if (arg == "--p2p-rate") {
+            options.rates[TRAFFIC_P2P] = std::max(0.0, atof(value));
+        } else if (arg == "--sockets-rate") {
+            options.rates[TRAFFIC_SOCKETS] = std::max(0.0, atof(value));
+        } else if (arg == "--messages-rate") {
+            options.rates[TRAFFIC_MESSAGES] = std::max(0.0, atof(value));
+        } else if (arg == "--lobby-data-rate") {
+            options.lobby_data_rate = std::max(0.0, atof(value));
+        } else if (arg == "--size") {
+            options.size = std::max((unsigned)sizeof(Load_Header), (unsigned)atoi(value));
+        } else if (arg == "--virtual-port") {
+            options.virtual_port = atoi(value);
+        } else {
+            return false;
+        }
+
+        if (used_value) ++i;
+    }
+
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    if (!parse_options(argc, argv)) {
+        usage();
+        return 1;
+    }
+
+    run_token = std::random_device()() | (uint64)std::random_device()() << 32;
+    // the users of this process find each other through loopback, the host through the usual broadcasts
+    options.broadcasts.insert(IP_PORT{0x7F000001, 0});
+
+    std::vector<std::unique_ptr<Sim_User>> users;
+    for (unsigned i = 0; i < options.users; ++i) {
+        users.emplace_back(new Sim_User(i, generate_steam_id_user()));
+    }
+
+    std::cerr << "started " << users.size() << " users for appid " << options.appid << ", looking for a lobby" << std::endl;
+    auto run_all = [&users]() {
+        for (auto &user : users) user->run();
+    };
+
+    // the first user picks the lobby, the others join it once they know about it
+    CSteamID lobby;
+    if (options.lobby_id) lobby = CSteamID((uint64)options.lobby_id);
+    auto start = std::chrono::steady_clock::now();
+    while (!lobby.IsValid()) {
+        Sim_User &first = *users[0];
+        if (first.lobby_call == k_uAPICallInvalid && seconds_since(start) < options.search_seconds) {
+            first.matchmaking.RequestLobbyList();
+        }
+
+        run_all();
+        if (first.matchmaking.GetLobbyByIndex(0).IsValid()) {
+            lobby = first.matchmaking.GetLobbyByIndex(0);
+        } else if (seconds_since(start) >= options.search_seconds) {
+            if (!options.create_lobby) {
+                std::cerr << "no lobby found" << std::endl;
+                return 1;
+            }
+
+            if (first.lobby_call == k_uAPICallInvalid) {
+                std::cerr << "no lobby found, creating one" << std::endl;
+                first.create();
+            }
+
+            first.update_lobby();
+            if (first.lobby_failed) {
+                std::cerr << "couldn't create a lobby" << std::endl;
+                return 1;
+            }
+
+            lobby = first.lobby;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    std::cerr << "using lobby " << lobby.ConvertToUint64() << std::endl;
+    start = std::chrono::steady_clock::now();
+    double join_seconds = std::max(10.0, options.search_seconds);
+    while (seconds_since(start) < join_seconds) {
+        unsigned joined = 0;
+        for (auto &user : users) {
+            if (!user->in_lobby() && user->lobby_call == k_uAPICallInvalid) {
+                // a lobby has to be known before it can be joined
+                if (user->matchmaking.GetLobbyOwner(lobby).IsValid()) user->join(lobby);
+                else user->matchmaking.RequestLobbyList();
+            }
+
+            joined += user->update_lobby();
+        }
+
+        if (joined == users.size()) break;
+        run_all();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    std::vector<char> payload(options.size, 'x');
+    Traffic_Stats interval[TRAFFIC_KINDS], total[TRAFFIC_KINDS];
+    Lobby_Stats interval_lobby, total_lobby;
+    auto last_tick = std::chrono::steady_clock::now();
+    auto last_report = last_tick;
+    start = last_tick;
+
+    while (options.seconds <= 0 || seconds_since(start) < options.seconds) {
+        auto now = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration<double>(now - last_tick).count();
+        last_tick = now;
+
+        unsigned in_lobby = 0;
+        for (auto &user : users) {
+            if (!user->update_lobby()) continue;
+            ++in_lobby;
+            user->update_targets();
+            for (int kind = 0; kind < TRAFFIC_KINDS; ++kind) user->send((Traffic_Kind)kind, elapsed, payload, interval[kind]);
+            user->update_lobby_data(elapsed, interval_lobby);
+        }
+
+        run_all();
+        for (auto &user : users) user->receive(interval);
+
+        double report_elapsed = seconds_since(last_report);
+        if (report_elapsed >= options.report_seconds) {
+            for (int kind = 0; kind < TRAFFIC_KINDS; ++kind) total[kind].add(interval[kind]);
+            total_lobby.lobby_data_set += interval_lobby.lobby_data_set;
+            total_lobby.member_data_set += interval_lobby.member_data_set;
+
+            report("interval", report_elapsed, in_lobby, interval, interval_lobby);
+            for (int kind = 0; kind < TRAFFIC_KINDS; ++kind) interval[kind] = Traffic_Stats();
+            interval_lobby = Lobby_Stats();
+            last_report = std::chrono::steady_clock::now();
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    unsigned in_lobby = 0;
+    for (auto &user : users) in_lobby += user->in_lobby();
+    for (int kind = 0; kind < TRAFFIC_KINDS; ++kind) total[kind].add(interval[kind]);
+    total_lobby.lobby_data_set += interval_lobby.lobby_data_set;
+    total_lobby.member_data_set += interval_lobby.member_data_set;
+    report("total", seconds_since(start), in_lobby, total, total_lobby);
+
+    for (auto &user : users) user->matchmaking.LeaveLobby(lobby);
+    run_all();
+    return 0;
+}